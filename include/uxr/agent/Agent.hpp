@@ -17,10 +17,13 @@
 
 #include <uxr/agent/visibility.hpp>
 #include <uxr/agent/middleware/Middleware.hpp>
+#include <uxr/agent/metrics/Metrics.hpp>
 
+#include <chrono>
 #include <cstdint>
 #include <string>
 #include <memory>
+#include <mutex>
 
 namespace eprosima {
 namespace uxr {
@@ -109,7 +112,7 @@ public:
     };
 
     UXR_AGENT_EXPORT Agent();
-    UXR_AGENT_EXPORT ~Agent();
+    UXR_AGENT_EXPORT virtual ~Agent();
 
     /**
      * @brief Creates a ProxyClient which can be reused by an external Client.
@@ -553,6 +556,79 @@ public:
      */
     UXR_AGENT_EXPORT void set_verbose_level(uint8_t verbose_level);
 
+    /**
+     * @brief Enables the asynchronous logging of messages. The threads handling messages only store compact
+     *        records of them, which a background thread formats through the logger or writes to a file.
+     *        The logging mode is shared by every agent of the process.
+     * @param file_path The binary file to write the records to, which include the beginning of each message
+     *                  regardless of the verbose level. If empty, the records are formatted through the logger.
+     * @return true in case of success and false in other case, as when it is already enabled or the agent
+     *         is built without the logger profile.
+     */
+    UXR_AGENT_EXPORT bool enable_async_logging(const std::string& file_path = "");
+
+    /**
+     * @brief Disables the asynchronous logging of messages once the pending records are written.
+     */
+    UXR_AGENT_EXPORT void disable_async_logging();
+
+    /**
+     * @brief Sets the stream depths of the sessions created from now on.
+     *        Clients may override them through the `uxr_rd`, `uxr_bd` and `uxr_aw` properties.
+     * @param reliable_depth        The depth of the reliable streams, that is, the initial window of
+     *                              the reliable output streams.
+     * @param best_effort_depth     The depth of the best-effort streams.
+     * @param max_reliable_depth    The maximum window of the reliable output streams. When greater than
+     *                              reliable_depth, the window adapts to the losses reported by the acknacks.
+     *                              A value of 0 keeps the window fixed.
+     * @return true in case of valid depths, that is, between 1 and 16384, and false in other case.
+     */
+    UXR_AGENT_EXPORT bool set_stream_depth(
+            uint16_t reliable_depth,
+            uint16_t best_effort_depth,
+            uint16_t max_reliable_depth = 0);
+
+    /**
+     * @brief Enables the aggregation of DATA submessages in the sessions created from now on.
+     *        Consecutive DATA submessages of a best-effort or reliable output stream are appended to the same
+     *        message, which is sent once it reaches the MTU or once flush_timeout elapses since it was opened.
+     *        Clients may override it through the `uxr_ag` property, in microseconds.
+     * @param flush_timeout The maximum time a message waits for more submessages. A value of 0 disables
+     *                      the aggregation.
+     * @return true in case of a valid timeout, that is, up to one second, and false in other case.
+     */
+    UXR_AGENT_EXPORT bool set_flush_timeout(std::chrono::microseconds flush_timeout);
+
+    /**
+     * @brief Collects the metrics of the agent. The threads handling messages keep their own counters,
+     *        which are only aggregated here, so it may be called as often as needed.
+     * @param metrics   The metrics of the transport, the clients and their reliable output streams.
+     */
+    UXR_AGENT_EXPORT void get_metrics(AgentMetrics& metrics);
+
+    /**
+     * @brief Writes the metrics of the agent to a file in the Prometheus text exposition format.
+     *        The file is replaced at once, so it can be read by the textfile collector of the node exporter.
+     * @param file_path The file to write.
+     * @return true in case of success and false in other case.
+     */
+    UXR_AGENT_EXPORT bool dump_metrics(const std::string& file_path);
+
+    /**
+     * @brief Periodically dumps the metrics of the agent, as dump_metrics does, while it is running.
+     *        The period is checked every heartbeat period.
+     * @param file_path The file to write.
+     * @param period    The period of the dumps.
+     */
+    UXR_AGENT_EXPORT void enable_metrics_dump(
+            const std::string& file_path,
+            std::chrono::milliseconds period = std::chrono::milliseconds(1000));
+
+    /**
+     * @brief Stops the periodic dumps of the metrics.
+     */
+    UXR_AGENT_EXPORT void disable_metrics_dump();
+
     /**
      * @brief Sets a callback function for an specific create/delete middleware entity operation.
      *        Note that not some middlewares might not implement every defined operation, or even
@@ -585,9 +661,22 @@ private:
             uint16_t raw_id,
             Agent::OpResult& op_result);
 
+    /**
+     * @brief Fills the transport metrics and the processing latency, if the agent has a transport.
+     */
+    virtual void get_transport_metrics(AgentMetrics& /* metrics */) {}
+
 protected:
+    void dump_metrics_if_due();
+
     std::unique_ptr<Root> root_;
     middleware::CallbackFactory& callback_factory_;
+
+private:
+    std::mutex metrics_dump_mtx_;
+    std::string metrics_dump_file_;
+    std::chrono::milliseconds metrics_dump_period_;
+    std::chrono::steady_clock::time_point metrics_dump_deadline_;
 };
 
 } // uxr
@@ -16,11 +16,12 @@
 #define UXR_AGENT_ROOT_HPP_
 
 #include <uxr/agent/client/ProxyClient.hpp>
+#include <uxr/agent/utils/SnapshotMap.hpp>
 
 #include <thread>
 #include <memory>
-#include <map>
 #include <mutex>
+#include <vector>
 
 namespace eprosima{
 namespace uxr{
@@ -45,20 +46,31 @@ public:
 
     dds::xrce::ResultStatus delete_client(const dds::xrce::ClientKey& client_key);
 
+    /**
+     * @brief Looks up a client lock-free, so it may be called for every incoming packet.
+     */
     std::shared_ptr<ProxyClient> get_client(const dds::xrce::ClientKey& client_key);
 
-    bool get_next_client(std::shared_ptr<ProxyClient>& next_client);
+    /**
+     * @brief Takes a snapshot of the clients without blocking lookups, creations or deletions.
+     *        Clients created or deleted while it is taken may or may not be in it.
+     */
+    void get_clients(std::vector<std::shared_ptr<ProxyClient>>& clients);
 
     bool load_config_file(const std::string& file_path);
 
     void set_verbose_level(uint8_t verbose_level);
 
+    void set_stream_config(const StreamConfig& stream_config);
+
+    StreamConfig get_stream_config();
+
     void reset();
 
 private:
     std::mutex mtx_;
-    std::map<dds::xrce::ClientKey, std::shared_ptr<ProxyClient>> clients_;
-    std::map<dds::xrce::ClientKey, std::shared_ptr<ProxyClient>>::iterator current_client_;
+    StreamConfig stream_config_;
+    utils::SnapshotMap<uint32_t, std::shared_ptr<ProxyClient>> clients_;
 };
 
 } // uxr
@@ -37,7 +37,8 @@ public:
     explicit ProxyClient(
             const dds::xrce::CLIENT_Representation& representation,
             Middleware::Kind middleware_kind = Middleware::Kind(0),
-            std::unordered_map<std::string, std::string>&& properties = {});
+            std::unordered_map<std::string, std::string>&& properties = {},
+            const StreamConfig& stream_config = StreamConfig());
 
     ~ProxyClient() = default;
 
@@ -22,6 +22,7 @@
 
 #include <unordered_map>
 #include <memory>
+#include <tuple>
 
 namespace eprosima {
 namespace uxr {
@@ -44,9 +45,13 @@ inline bool is_reliable_stream(dds::xrce::StreamId stream_id)
 class Session
 {
 public:
-    Session(const SessionInfo& info)
+    Session(
+            const SessionInfo& info,
+            const StreamConfig& stream_config = StreamConfig())
         : session_info_(info)
-        , none_ostream_{}
+        , stream_config_(stream_config)
+        , none_istream_(stream_config.best_effort_depth)
+        , none_ostream_(stream_config.best_effort_depth)
     {}
 
     ~Session() = default;
@@ -88,12 +93,15 @@ public:
     /* Output streams functions. */
     std::vector<uint8_t> get_output_streams();
 
+    size_t get_mtu() const { return session_info_.mtu; }
+
     template<class T>
     bool push_output_submessage(
             dds::xrce::StreamId stream_id,
             dds::xrce::SubmessageId submessage_id,
             const T& submessage,
-            std::chrono::milliseconds timeout);
+            std::chrono::milliseconds timeout,
+            uint8_t flags = dds::xrce::FLAG_LITTLE_ENDIANNESS);
 
     bool get_next_output_message(
             dds::xrce::StreamId stream_id,
@@ -106,19 +114,42 @@ public:
 
     void update_from_acknack(
             dds::xrce::StreamId stream_id,
-            SeqNum first_unacked);
+            SeqNum first_unacked,
+            bool nacked = false);
 
     bool fill_heartbeat(
             dds::xrce::StreamId stream_id,
             dds::xrce::HEARTBEAT_Payload& heartbeat);
 
+    bool flush_output_stream(
+            dds::xrce::StreamId stream_id,
+            std::chrono::steady_clock::time_point now);
+
+    bool take_output_flush_request(
+            dds::xrce::StreamId stream_id,
+            std::chrono::steady_clock::time_point& deadline);
+
+    const StreamConfig& get_stream_config() const { return stream_config_; }
+
+    /**
+     * @brief Appends the metrics of the reliable output streams, leaving the client key untouched.
+     */
+    void get_output_stream_metrics(std::vector<StreamMetrics>& metrics);
+
 private:
+    template<class Stream, typename ... Args>
+    static Stream& get_stream(
+            std::unordered_map<dds::xrce::StreamId, Stream>& streams,
+            dds::xrce::StreamId stream_id,
+            Args ... args);
+
     ReliableOutputStream& get_reliable_output_stream(
             dds::xrce::StreamId stream_id,
             utils::SharedLock& shared_lock);
 
 private:
     const SessionInfo session_info_;
+    const StreamConfig stream_config_;
 
     NoneInputStream none_istream_;
     std::unordered_map<dds::xrce::StreamId, BestEffortInputStream> best_effort_istreams_;
@@ -183,12 +214,12 @@ inline bool Session::push_input_message(
     else if (is_besteffort_stream(stream_id))
     {
         std::lock_guard<std::mutex> lock(best_effort_imtx_);
-        rv = best_effort_istreams_[stream_id].push_message(sequence_nr, std::move(message));
+        rv = get_stream(best_effort_istreams_, stream_id, stream_config_.best_effort_depth).push_message(sequence_nr, std::move(message));
     }
     else
     {
         std::lock_guard<std::mutex> lock(reliable_imtx_);
-        rv = reliable_istreams_[stream_id].push_message(sequence_nr, std::move(message));
+        rv = get_stream(reliable_istreams_, stream_id, stream_config_.reliable_depth).push_message(sequence_nr, std::move(message));
     }
     return rv;
 }
@@ -205,12 +236,12 @@ inline bool Session::pop_input_message(
     else if (is_besteffort_stream(stream_id))
     {
         std::lock_guard<std::mutex> lock(best_effort_imtx_);
-        rv = best_effort_istreams_[stream_id].pop_message(message);
+        rv = get_stream(best_effort_istreams_, stream_id, stream_config_.best_effort_depth).pop_message(message);
     }
     else
     {
         std::lock_guard<std::mutex> lock(reliable_imtx_);
-        rv = reliable_istreams_[stream_id].pop_message(message);
+        rv = get_stream(reliable_istreams_, stream_id, stream_config_.reliable_depth).pop_message(message);
     }
     return rv;
 }
@@ -223,7 +254,7 @@ inline void Session::update_from_heartbeat(
     if (is_reliable_stream(stream_id))
     {
         std::lock_guard<std::mutex> lock(reliable_imtx_);
-        reliable_istreams_[stream_id].update_from_heartbeat(first_unacked, last_unacked);
+        get_stream(reliable_istreams_, stream_id, stream_config_.reliable_depth).update_from_heartbeat(first_unacked, last_unacked);
     }
 }
 
@@ -234,7 +265,7 @@ inline void Session::fill_acknack(
     if (is_reliable_stream(stream_id))
     {
         std::lock_guard<std::mutex> lock(reliable_imtx_);
-        reliable_istreams_[stream_id].fill_acknack(acknack);
+        get_stream(reliable_istreams_, stream_id, stream_config_.reliable_depth).fill_acknack(acknack);
     }
 }
 
@@ -243,14 +274,14 @@ inline void Session::push_input_fragment(dds::xrce::StreamId stream_id, InputMes
     if (is_reliable_stream(stream_id))
     {
         std::lock_guard<std::mutex> lock(reliable_imtx_);
-        reliable_istreams_[stream_id].push_fragment(message);
+        get_stream(reliable_istreams_, stream_id, stream_config_.reliable_depth).push_fragment(message);
     }
 }
 
 inline bool Session::pop_input_fragment_message(dds::xrce::StreamId stream_id, InputMessagePtr& message)
 {
     std::lock_guard<std::mutex> lock(reliable_imtx_);
-    return reliable_istreams_[stream_id].pop_fragment_message(message);
+    return get_stream(reliable_istreams_, stream_id, stream_config_.reliable_depth).pop_fragment_message(message);
 }
 
 /**************************************************************************************************
@@ -273,23 +304,24 @@ inline bool Session::push_output_submessage(
         dds::xrce::StreamId stream_id,
         dds::xrce::SubmessageId submessage_id,
         const T& submessage,
-        std::chrono::milliseconds timeout)
+        std::chrono::milliseconds timeout,
+        uint8_t flags)
 {
     bool rv = false;
     if (is_none_stream(stream_id))
     {
-        rv = none_ostream_.push_submessage(session_info_, submessage_id, submessage);
+        rv = none_ostream_.push_submessage(session_info_, submessage_id, submessage, flags);
     }
     else if (is_besteffort_stream(stream_id))
     {
         std::lock_guard<std::mutex> lock(best_effort_omtx_);
-        rv = best_effort_ostreams_[stream_id].push_submessage(session_info_, stream_id, submessage_id, submessage);
+        rv = get_stream(best_effort_ostreams_, stream_id, stream_config_.best_effort_depth, stream_config_.flush_timeout).push_submessage(session_info_, stream_id, submessage_id, submessage, flags);
     }
     else
     {
         utils::SharedLock shared_lock(reliable_omtx_);
         rv = get_reliable_output_stream(stream_id, shared_lock).push_submessage(
-            session_info_, stream_id, submessage_id, submessage, timeout);
+            session_info_, stream_id, submessage_id, submessage, timeout, flags);
     }
     return rv;
 }
@@ -306,7 +338,7 @@ inline bool Session::get_next_output_message(
     else if (is_besteffort_stream(stream_id))
     {
         std::lock_guard<std::mutex> lock(best_effort_omtx_);
-        rv = best_effort_ostreams_[stream_id].pop_message(output_message);
+        rv = get_stream(best_effort_ostreams_, stream_id, stream_config_.best_effort_depth, stream_config_.flush_timeout).pop_message(output_message);
     }
     else
     {
@@ -332,12 +364,13 @@ inline bool Session::get_output_message(
 
 inline void Session::update_from_acknack(
         const dds::xrce::StreamId stream_id,
-        const SeqNum first_unacked)
+        const SeqNum first_unacked,
+        bool nacked)
 {
     if (is_reliable_stream(stream_id))
     {
         utils::SharedLock shared_lock(reliable_omtx_);
-        get_reliable_output_stream(stream_id, shared_lock).update_from_acknack(first_unacked);
+        get_reliable_output_stream(stream_id, shared_lock).update_from_acknack(first_unacked, nacked);
     }
 }
 
@@ -356,6 +389,70 @@ inline bool Session::fill_heartbeat(
     return rv;
 }
 
+inline bool Session::flush_output_stream(
+        dds::xrce::StreamId stream_id,
+        std::chrono::steady_clock::time_point now)
+{
+    bool rv = false;
+    if (is_besteffort_stream(stream_id))
+    {
+        std::lock_guard<std::mutex> lock(best_effort_omtx_);
+        rv = get_stream(best_effort_ostreams_, stream_id, stream_config_.best_effort_depth, stream_config_.flush_timeout).flush(now);
+    }
+    else if (is_reliable_stream(stream_id))
+    {
+        utils::SharedLock shared_lock(reliable_omtx_);
+        rv = get_reliable_output_stream(stream_id, shared_lock).flush(now);
+    }
+    return rv;
+}
+
+inline bool Session::take_output_flush_request(
+        dds::xrce::StreamId stream_id,
+        std::chrono::steady_clock::time_point& deadline)
+{
+    bool rv = false;
+    if (is_besteffort_stream(stream_id))
+    {
+        std::lock_guard<std::mutex> lock(best_effort_omtx_);
+        rv = get_stream(best_effort_ostreams_, stream_id, stream_config_.best_effort_depth, stream_config_.flush_timeout).take_flush_request(deadline);
+    }
+    else if (is_reliable_stream(stream_id))
+    {
+        utils::SharedLock shared_lock(reliable_omtx_);
+        rv = get_reliable_output_stream(stream_id, shared_lock).take_flush_request(deadline);
+    }
+    return rv;
+}
+
+inline void Session::get_output_stream_metrics(std::vector<StreamMetrics>& metrics)
+{
+    utils::SharedLock lock(reliable_omtx_);
+    for (auto& it : reliable_ostreams_)
+    {
+        metrics.emplace_back();
+        metrics.back().stream_id = it.first;
+        it.second.get_metrics(metrics.back());
+    }
+}
+
+template<class Stream, typename ... Args>
+inline Stream& Session::get_stream(
+        std::unordered_map<dds::xrce::StreamId, Stream>& streams,
+        dds::xrce::StreamId stream_id,
+        Args ... args)
+{
+    auto it = streams.find(stream_id);
+    if (it == streams.end())
+    {
+        it = streams.emplace(
+            std::piecewise_construct,
+            std::forward_as_tuple(stream_id),
+            std::forward_as_tuple(args...)).first;
+    }
+    return it->second;
+}
+
 inline ReliableOutputStream& Session::get_reliable_output_stream(
         dds::xrce::StreamId stream_id,
         utils::SharedLock& shared_lock)
@@ -371,7 +468,12 @@ inline ReliableOutputStream& Session::get_reliable_output_stream(
         shared_lock.unlock();
         utils::ExclusiveLock exclusive_lock(reliable_omtx_);
         shared_lock.lock();
-        return reliable_ostreams_[stream_id];
+        return get_stream(
+            reliable_ostreams_,
+            stream_id,
+            stream_config_.reliable_depth,
+            stream_config_.max_reliable_depth,
+            stream_config_.flush_timeout);
     }
 }
 
@@ -15,6 +15,7 @@
 #ifndef UXR_AGENT_CLIENT_SESSION_SESSION_INFO_HPP_
 #define UXR_AGENT_CLIENT_SESSION_SESSION_INFO_HPP_
 
+#include <uxr/agent/config.hpp>
 #include <uxr/agent/types/XRCETypes.hpp>
 
 namespace eprosima {
@@ -27,6 +28,33 @@ struct SessionInfo
     size_t mtu;
 };
 
+/**
+ * @brief Depth of the streams of a session.
+ *        The reliable output window starts at reliable_depth. When max_reliable_depth is greater, the window
+ *        is adaptive: it doubles each time a whole window is acknowledged without NACKs and halves on NACKs,
+ *        staying between reliable_depth and max_reliable_depth.
+ *        A non-zero flush_timeout aggregates consecutive DATA submessages of a best-effort or reliable output
+ *        stream into the same message, which is sent once it reaches the MTU or flush_timeout after it was opened.
+ */
+struct StreamConfig
+{
+    StreamConfig()
+        : reliable_depth{RELIABLE_STREAM_DEPTH}
+        , best_effort_depth{BEST_EFFORT_STREAM_DEPTH}
+        , max_reliable_depth{RELIABLE_STREAM_DEPTH}
+        , flush_timeout{0}
+    {}
+
+    bool is_adaptive() const { return max_reliable_depth > reliable_depth; }
+
+    bool is_aggregated() const { return std::chrono::microseconds(0) < flush_timeout; }
+
+    uint16_t reliable_depth;
+    uint16_t best_effort_depth;
+    uint16_t max_reliable_depth;
+    std::chrono::microseconds flush_timeout;
+};
+
 } // namespace uxr
 } // namespace eprosima
 
@@ -19,8 +19,10 @@
 #include <uxr/agent/message/Packet.hpp>
 #include <uxr/agent/utils/SeqNum.hpp>
 #include <uxr/agent/client/session/SessionInfo.hpp>
+#include <uxr/agent/client/session/stream/SeqNumRing.hpp>
 
-#include <map>
+#include <algorithm>
+#include <cstring>
 #include <mutex>
 #include <queue>
 
@@ -33,7 +35,10 @@ namespace uxr {
 class NoneInputStream
 {
 public:
-    NoneInputStream() = default;
+    explicit NoneInputStream(
+            uint16_t depth = BEST_EFFORT_STREAM_DEPTH)
+        : depth_(depth)
+    {}
 
     bool push_message(
             InputMessagePtr&& input_message);
@@ -48,6 +53,7 @@ public:
     void reset();
 
 private:
+    const uint16_t depth_;
     std::queue<InputMessagePtr> messages_;
     std::mutex mtx_;
 };
@@ -57,7 +63,7 @@ inline bool NoneInputStream::push_message(
 {
     bool rv = false;
     std::lock_guard<std::mutex> lock(mtx_);
-    if (messages_.size() < BEST_EFFORT_STREAM_DEPTH)
+    if (messages_.size() < depth_)
     {
         messages_.push(std::move(input_message));
         rv = true;
@@ -71,7 +77,7 @@ inline bool NoneInputStream::emplace_message(
 {
     bool rv = false;
     std::lock_guard<std::mutex> lock(mtx_);
-    if (messages_.size() < BEST_EFFORT_STREAM_DEPTH)
+    if (messages_.size() < depth_)
     {
         messages_.emplace(new InputMessage(std::forward<Args>(args)...));
         rv = true;
@@ -107,8 +113,10 @@ inline void NoneInputStream::reset()
 class BestEffortInputStream
 {
 public:
-    BestEffortInputStream()
-        : last_received_(UINT16_MAX)
+    explicit BestEffortInputStream(
+            uint16_t depth = BEST_EFFORT_STREAM_DEPTH)
+        : depth_(depth)
+        , last_received_(UINT16_MAX)
     {}
 
     ~BestEffortInputStream() = default;
@@ -132,6 +140,7 @@ public:
     void reset();
 
 private:
+    const uint16_t depth_;
     std::queue<InputMessagePtr> messages_;
     SeqNum last_received_;
     std::mutex mtx_;
@@ -143,7 +152,7 @@ inline bool BestEffortInputStream::push_message(
 {
     bool rv = false;
     std::lock_guard<std::mutex> lock(mtx_);
-    if ((seq_num > last_received_) && (messages_.size() < BEST_EFFORT_STREAM_DEPTH))
+    if ((seq_num > last_received_) && (messages_.size() < depth_))
     {
         messages_.push(std::move(input_message));
         last_received_ = seq_num;
@@ -159,7 +168,7 @@ inline bool BestEffortInputStream::emplace_message(
 {
     bool rv = false;
     std::lock_guard<std::mutex> lock(mtx_);
-    if ((seq_num > last_received_) && (messages_.size() < BEST_EFFORT_STREAM_DEPTH))
+    if ((seq_num > last_received_) && (messages_.size() < depth_))
     {
         messages_.emplace(new InputMessage(std::forward<Args>(args)...));
         last_received_ = seq_num;
@@ -197,10 +206,14 @@ inline void BestEffortInputStream::reset()
 class ReliableInputStream
 {
 public:
-    ReliableInputStream()
-        : last_handled_(UINT16_MAX),
+    explicit ReliableInputStream(
+            uint16_t depth = RELIABLE_STREAM_DEPTH)
+        : depth_(depth),
+          last_handled_(UINT16_MAX),
           last_announced_(UINT16_MAX),
+          messages_(depth),
           fragment_msg_{},
+          fragment_len_(0),
           fragment_message_available_(false)
     {}
 
@@ -235,10 +248,15 @@ public:
     void reset();
 
 private:
+    bool has_message(SeqNum seq_num);
+
+private:
+    const uint16_t depth_;
     SeqNum last_handled_;
     SeqNum last_announced_;
-    std::map<uint16_t, InputMessagePtr> messages_;
-    std::vector<uint8_t> fragment_msg_;
+    SeqNumRing<InputMessagePtr> messages_;
+    MessageBuffer fragment_msg_;
+    size_t fragment_len_;
     bool fragment_message_available_;
     std::mutex mtx_;
 };
@@ -249,22 +267,17 @@ inline bool ReliableInputStream::push_message(
 {
     bool rv = false;
     std::lock_guard<std::mutex> lock(mtx_);
-    if ((seq_num > last_handled_) && (seq_num <= last_handled_ + SeqNum(RELIABLE_STREAM_DEPTH)))
+    if ((seq_num > last_handled_) && (seq_num <= last_handled_ + SeqNum(depth_)))
     {
         if (seq_num > last_announced_)
         {
             last_announced_ = seq_num;
-            messages_.emplace(seq_num, std::move(message));
-            rv = true;
         }
-        else
+        InputMessagePtr& slot = messages_[seq_num];
+        if (!slot)
         {
-            auto it = messages_.find(seq_num);
-            if (it == messages_.end())
-            {
-                messages_.emplace(seq_num, std::move(message));
-                rv = true;
-            }
+            slot = std::move(message);
+            rv = true;
         }
     }
     return rv;
@@ -274,12 +287,11 @@ inline bool ReliableInputStream::pop_message(InputMessagePtr& message)
 {
     bool rv = false;
     std::lock_guard<std::mutex> lock(mtx_);
-    auto it = messages_.find(last_handled_ + 1);
-    if (it != messages_.end())
+    InputMessagePtr& slot = messages_[last_handled_ + 1];
+    if (slot)
     {
         last_handled_ += 1;
-        message = std::move(messages_.at(last_handled_));
-        messages_.erase(last_handled_);
+        message = std::move(slot);
         rv = true;
     }
     return rv;
@@ -292,25 +304,17 @@ inline bool ReliableInputStream::emplace_message(
 {
     bool rv = false;
     std::lock_guard<std::mutex> lock(mtx_);
-    if ((seq_num > last_handled_) && (seq_num <= last_handled_ + SeqNum(RELIABLE_STREAM_DEPTH)))
+    if ((seq_num > last_handled_) && (seq_num <= last_handled_ + SeqNum(depth_)))
     {
         if (seq_num > last_announced_)
         {
             last_announced_ = seq_num;
-            // gcc5 doesn't not support raw pointer as argument in std::pair when std::unique_ptr is create.
-            messages_.emplace(seq_num,
-                              std::unique_ptr<InputMessage>(new InputMessage(std::forward<Args>(args)...)));
-            rv = true;
         }
-        else
+        InputMessagePtr& slot = messages_[seq_num];
+        if (!slot)
         {
-            auto it = messages_.find(seq_num);
-            if (it == messages_.end())
-            {
-                messages_.emplace(seq_num,
-                                  std::unique_ptr<InputMessage>(new InputMessage(std::forward<Args>(args)...)));
-                rv = true;
-            }
+            slot.reset(new InputMessage(std::forward<Args>(args)...));
+            rv = true;
         }
     }
     return rv;
@@ -323,6 +327,18 @@ inline void ReliableInputStream::update_from_heartbeat(
     std::lock_guard<std::mutex> lock(mtx_);
     if (last_handled_ + 1 < first_unacked)
     {
+        /* Drop the skipped messages, otherwise their slots would be taken by the next window. */
+        if (size_t(uint16_t(first_unacked - (last_handled_ + 1))) >= messages_.capacity())
+        {
+            messages_.clear();
+        }
+        else
+        {
+            for (SeqNum seq_num = last_handled_ + 1; seq_num < first_unacked; seq_num += 1)
+            {
+                messages_[seq_num].reset();
+            }
+        }
         last_handled_ = first_unacked - 1;
     }
     if (last_announced_ < last_unacked)
@@ -340,16 +356,14 @@ inline void ReliableInputStream::fill_acknack(dds::xrce::ACKNACK_Payload& acknac
     {
         if (last_handled_ + SeqNum(i) < last_announced_)
         {
-            auto it = messages_.find(last_handled_ + SeqNum(i + 1));
-            if (it == messages_.end())
+            if (!has_message(last_handled_ + SeqNum(i + 1)))
             {
                 acknack.nack_bitmap().at(1) = acknack.nack_bitmap().at(1) | (0x01 << i);
             }
         }
         if (last_handled_ + SeqNum(i + 8) < last_announced_)
         {
-            auto it = messages_.find(last_handled_ + SeqNum(i + 9));
-            if (it == messages_.end())
+            if (!has_message(last_handled_ + SeqNum(i + 9)))
             {
                 acknack.nack_bitmap().at(0) = acknack.nack_bitmap().at(0) | (0x01 << i);
             }
@@ -357,6 +371,11 @@ inline void ReliableInputStream::fill_acknack(dds::xrce::ACKNACK_Payload& acknac
     }
 }
 
+inline bool ReliableInputStream::has_message(SeqNum seq_num)
+{
+    return (seq_num <= last_handled_ + SeqNum(depth_)) && messages_[seq_num];
+}
+
 inline void ReliableInputStream::reset()
 {
     std::lock_guard<std::mutex> lock(mtx_);
@@ -370,18 +389,28 @@ inline void ReliableInputStream::push_fragment(InputMessagePtr& message)
     std::lock_guard<std::mutex> lock(mtx_);
 
     /* Add header in case. */
-    if (fragment_msg_.empty())
+    std::array<uint8_t, 8> raw_header;
+    uint8_t header_size = (0 == fragment_len_) ? message->get_raw_header(raw_header) : 0;
+
+    /* Grow geometrically, so the fragments are reassembled in place and handed over without a copy. */
+    size_t fragment_size = message->get_subheader().submessage_length();
+    size_t required_size = fragment_len_ + header_size + fragment_size;
+    if (required_size > fragment_msg_.capacity())
     {
-        std::array<uint8_t, 8> raw_header;
-        uint8_t header_size = message->get_raw_header(raw_header);
-        fragment_msg_.insert(fragment_msg_.begin(), std::begin(raw_header), std::begin(raw_header) + header_size);
+        MessageBuffer buffer = MessageBufferPool::input_pool().acquire((std::max)(required_size, 2 * fragment_msg_.capacity()));
+        if (0 != fragment_len_)
+        {
+            memcpy(buffer.data(), fragment_msg_.data(), fragment_len_);
+        }
+        fragment_msg_ = std::move(buffer);
     }
 
+    memcpy(fragment_msg_.data() + fragment_len_, raw_header.data(), header_size);
+    fragment_len_ += header_size;
+
     /* Append fragment. */
-    size_t position = fragment_msg_.size();
-    size_t fragment_size = message->get_subheader().submessage_length();
-    fragment_msg_.resize(position + fragment_size);
-    message->get_raw_payload(fragment_msg_.data() + position, fragment_size);
+    message->get_raw_payload(fragment_msg_.data() + fragment_len_, fragment_size);
+    fragment_len_ += fragment_size;
 
     /* Check if last message. */
     fragment_message_available_ = (0 != (dds::xrce::FLAG_LAST_FRAGMENT & message->get_subheader().flags()));
@@ -393,8 +422,8 @@ inline bool ReliableInputStream::pop_fragment_message(InputMessagePtr& message)
     std::lock_guard<std::mutex> lock(mtx_);
     if (fragment_message_available_)
     {
-        message.reset(new InputMessage(fragment_msg_.data(), fragment_msg_.size()));
-        fragment_msg_.clear();
+        message.reset(new InputMessage(std::move(fragment_msg_), fragment_len_));
+        fragment_len_ = 0;
         fragment_message_available_ = false;
         return true;
     }
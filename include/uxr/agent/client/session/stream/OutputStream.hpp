@@ -19,13 +19,16 @@
 #include <uxr/agent/message/Packet.hpp>
 #include <uxr/agent/utils/SeqNum.hpp>
 #include <uxr/agent/client/session/SessionInfo.hpp>
+#include <uxr/agent/client/session/stream/SeqNumRing.hpp>
+#include <uxr/agent/types/DataPayloadView.hpp>
 #include <uxr/agent/logger/Logger.hpp>
+#include <uxr/agent/metrics/Metrics.hpp>
 
+#include <algorithm>
 #include <memory>
 #include <queue>
 #include <mutex>
 #include <array>
-#include <map>
 #include <condition_variable>
 
 namespace eprosima {
@@ -37,7 +40,10 @@ namespace uxr {
 class NoneOutputStream
 {
 public:
-    NoneOutputStream() = default;
+    explicit NoneOutputStream(
+            uint16_t depth = BEST_EFFORT_STREAM_DEPTH)
+        : depth_(depth)
+    {}
 
     ~NoneOutputStream() = default;
 
@@ -52,11 +58,13 @@ public:
     bool push_submessage(
             const SessionInfo& session_info,
             dds::xrce::SubmessageId id,
-            const T& submessage);
+            const T& submessage,
+            uint8_t flags = dds::xrce::FLAG_LITTLE_ENDIANNESS);
 
     bool pop_message(OutputMessagePtr& output_message);
 
 private:
+    const uint16_t depth_;
     std::queue<OutputMessagePtr> messages_;
     std::mutex mtx_;
 };
@@ -74,11 +82,12 @@ template<class T>
 inline bool NoneOutputStream::push_submessage(
         const SessionInfo& session_info,
         dds::xrce::SubmessageId id,
-        const T& submessage)
+        const T& submessage,
+        uint8_t flags)
 {
     bool rv = false;
     std::lock_guard<std::mutex> lock(mtx_);
-    if (BEST_EFFORT_STREAM_DEPTH > messages_.size())
+    if (depth_ > messages_.size())
     {
         /* Message header. */
         dds::xrce::MessageHeader message_header;
@@ -89,7 +98,7 @@ inline bool NoneOutputStream::push_submessage(
 
         /* Create message. */
         OutputMessagePtr output_message(new OutputMessage(message_header, session_info.mtu));
-        if (output_message->append_submessage(id, submessage))
+        if (output_message->append_submessage(id, submessage, flags))
         {
             /* Push message. */
             messages_.push(std::move(output_message));
@@ -118,8 +127,13 @@ inline bool NoneOutputStream::pop_message(OutputMessagePtr& output_message)
 class BestEffortOutputStream
 {
 public:
-    BestEffortOutputStream()
-        : last_sent_(UINT16_MAX)
+    explicit BestEffortOutputStream(
+            uint16_t depth = BEST_EFFORT_STREAM_DEPTH,
+            std::chrono::microseconds flush_timeout = std::chrono::microseconds(0))
+        : depth_(depth)
+        , flush_timeout_(flush_timeout)
+        , last_sent_(UINT16_MAX)
+        , flush_requested_(false)
     {}
 
     ~BestEffortOutputStream() = default;
@@ -138,13 +152,26 @@ public:
             const SessionInfo& session_info,
             dds::xrce::StreamId stream_id,
             dds::xrce::SubmessageId submessage_id,
-            const T& submessage);
+            const T& submessage,
+            uint8_t flags = dds::xrce::FLAG_LITTLE_ENDIANNESS);
 
     bool pop_message(OutputMessagePtr& output_message);
 
+    bool flush(std::chrono::steady_clock::time_point now);
+
+    bool take_flush_request(std::chrono::steady_clock::time_point& deadline);
+
 private:
+    void close_message();
+
+private:
+    const uint16_t depth_;
+    const std::chrono::microseconds flush_timeout_;
     std::queue<OutputMessagePtr> messages_;
+    OutputMessagePtr open_message_;
+    std::chrono::steady_clock::time_point flush_deadline_;
     SeqNum last_sent_;
+    bool flush_requested_;
     std::mutex mtx_;
 };
 
@@ -155,44 +182,78 @@ inline void BestEffortOutputStream::reset()
     {
         messages_.pop();
     }
+    open_message_.reset();
+    flush_requested_ = false;
     last_sent_ = UINT16_MAX;
 }
 
+/*
+ * Queues the aggregated message, if any. It was numbered last_sent_ + 1 when it was opened.
+ */
+inline void BestEffortOutputStream::close_message()
+{
+    if (open_message_)
+    {
+        messages_.push(std::move(open_message_));
+        last_sent_ += 1;
+    }
+}
+
 template<class T>
 inline bool BestEffortOutputStream::push_submessage(
         const SessionInfo& session_info,
         dds::xrce::StreamId stream_id,
         dds::xrce::SubmessageId submessage_id,
-        const T& submessage)
+        const T& submessage,
+        uint8_t flags)
 {
     bool rv = false;
     std::lock_guard<std::mutex> lock(mtx_);
-    if (BEST_EFFORT_STREAM_DEPTH > messages_.size())
+    const bool aggregate = (std::chrono::microseconds(0) < flush_timeout_) && (dds::xrce::DATA == submessage_id);
+    if (aggregate && open_message_ && open_message_->fits_submessage(submessage.getCdrSerializedSize()))
     {
-        /* Message header. */
-        dds::xrce::MessageHeader message_header;
-        message_header.session_id(session_info.session_id);
-        message_header.stream_id(stream_id);
-        message_header.sequence_nr(last_sent_ + 1);
-        message_header.client_key(session_info.client_key);
-
-        /* Create message. */
-        OutputMessagePtr output_message(new OutputMessage(message_header, session_info.mtu));
-        if (session_info.mtu < submessage.getCdrSerializedSize())
-        {
-            UXR_AGENT_LOG_WARN(
-                UXR_DECORATE_YELLOW("serialization warning"),
-                "Trying to serialize {:d} in {:d} MTU stream",
-                submessage.getCdrSerializedSize(),
-                session_info.mtu);
-            rv = true;
-        }
-        else if (output_message->append_submessage(submessage_id, submessage))
+        rv = open_message_->append_submessage(submessage_id, submessage, flags);
+    }
+    else
+    {
+        close_message();
+        if (depth_ > messages_.size())
         {
-            /* Push message. */
-            messages_.push(std::move(output_message));
-            last_sent_ += 1;
-            rv = true;
+            /* Message header. */
+            dds::xrce::MessageHeader message_header;
+            message_header.session_id(session_info.session_id);
+            message_header.stream_id(stream_id);
+            message_header.sequence_nr(last_sent_ + 1);
+            message_header.client_key(session_info.client_key);
+
+            /* Create message. */
+            OutputMessagePtr output_message(new OutputMessage(message_header, session_info.mtu));
+            if (session_info.mtu < submessage.getCdrSerializedSize())
+            {
+                UXR_AGENT_LOG_WARN(
+                    UXR_DECORATE_YELLOW("serialization warning"),
+                    "Trying to serialize {:d} in {:d} MTU stream",
+                    submessage.getCdrSerializedSize(),
+                    session_info.mtu);
+                rv = true;
+            }
+            else if (output_message->append_submessage(submessage_id, submessage, flags))
+            {
+                if (aggregate)
+                {
+                    /* Keep the message open for the following DATA submessages. */
+                    open_message_ = std::move(output_message);
+                    flush_deadline_ = std::chrono::steady_clock::now() + flush_timeout_;
+                    flush_requested_ = true;
+                }
+                else
+                {
+                    /* Push message. */
+                    messages_.push(std::move(output_message));
+                    last_sent_ += 1;
+                }
+                rv = true;
+            }
         }
     }
     return rv;
@@ -211,16 +272,61 @@ inline bool BestEffortOutputStream::pop_message(OutputMessagePtr& output_message
     return rv;
 }
 
+/*
+ * Closes the aggregated message once its flush deadline is due, making it available to pop_message.
+ */
+inline bool BestEffortOutputStream::flush(std::chrono::steady_clock::time_point now)
+{
+    bool rv = false;
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (open_message_ && (flush_deadline_ <= now))
+    {
+        close_message();
+        rv = true;
+    }
+    return rv;
+}
+
+/*
+ * Returns the flush deadline of a message opened since the last call, if any.
+ */
+inline bool BestEffortOutputStream::take_flush_request(std::chrono::steady_clock::time_point& deadline)
+{
+    bool rv = false;
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (flush_requested_)
+    {
+        deadline = flush_deadline_;
+        flush_requested_ = false;
+        rv = true;
+    }
+    return rv;
+}
+
 /****************************************************************************************
  * Reliable Output Stream.
  ****************************************************************************************/
 class ReliableOutputStream
 {
 public:
-    ReliableOutputStream()
-        : last_unacked_(UINT16_MAX)
+    explicit ReliableOutputStream(
+            uint16_t depth = RELIABLE_STREAM_DEPTH,
+            uint16_t max_depth = RELIABLE_STREAM_DEPTH,
+            std::chrono::microseconds flush_timeout = std::chrono::microseconds(0))
+        : min_window_(depth)
+        , max_window_((std::max)(depth, max_depth))
+        , window_(depth)
+        , acked_in_window_(0)
+        , messages_(depth)
+        , last_unacked_(UINT16_MAX)
         , last_sent_(UINT16_MAX)
         , first_unacked_(0x0000)
+        , recovery_seq_(UINT16_MAX)
+        , recovering_(false)
+        , flush_timeout_(flush_timeout)
+        , flush_requested_(false)
+        , retransmissions_(0)
+        , window_stalls_(0)
     {}
 
 //    bool push_message(OutputMessagePtr& output_message);
@@ -233,23 +339,99 @@ public:
             dds::xrce::StreamId stream_id,
             dds::xrce::SubmessageId submessage_id,
             const T& submessage,
-            std::chrono::milliseconds timeout);
+            std::chrono::milliseconds timeout,
+            uint8_t flags = dds::xrce::FLAG_LITTLE_ENDIANNESS);
 
     bool get_next_message(OutputMessagePtr& output_message);
 
+    /**
+     * @brief Gets a sent message to retransmit it, counting it as a retransmission.
+     */
     bool get_message(
             SeqNum seq_num,
             OutputMessagePtr& output_message);
 
-    void update_from_acknack(SeqNum first_unacked);
+    void update_from_acknack(
+            SeqNum first_unacked,
+            bool nacked = false);
 
     bool fill_heartbeat(dds::xrce::HEARTBEAT_Payload& heartbeat);
 
+    uint16_t get_window();
+
+    bool flush(std::chrono::steady_clock::time_point now);
+
+    bool take_flush_request(std::chrono::steady_clock::time_point& deadline);
+
+    /**
+     * @brief Fills the counters and the window state of the stream, leaving its identifiers untouched.
+     */
+    void get_metrics(StreamMetrics& metrics);
+
+private:
+    bool wait_window(
+            std::unique_lock<std::mutex>& lock,
+            std::chrono::steady_clock::time_point deadline);
+
+    void store_message(OutputMessagePtr&& output_message);
+
+    void close_message();
+
+    void update_window(
+            uint16_t acked,
+            bool nacked);
+
+    /*
+     * A submessage is split into fragments from its serialized head and its tail, the trailing bytes that are
+     * copied straight from where they lie. Only DATA payloads referring to a sample have a tail.
+     */
+    template<class T>
+    static size_t get_tail_size(
+            const T& /*submessage*/)
+    {
+        return 0;
+    }
+
+    static size_t get_tail_size(
+            const DataPayloadView& submessage)
+    {
+        return submessage.size();
+    }
+
+    template<class T>
+    static const uint8_t* serialize_head(
+            fastcdr::Cdr& serializer,
+            const T& submessage)
+    {
+        submessage.serialize(serializer);
+        return nullptr;
+    }
+
+    static const uint8_t* serialize_head(
+            fastcdr::Cdr& serializer,
+            const DataPayloadView& submessage)
+    {
+        submessage.serialize_head(serializer);
+        return submessage.data();
+    }
+
 private:
-    std::map<uint16_t, OutputMessagePtr> messages_;
+    const uint16_t min_window_;
+    const uint16_t max_window_;
+    uint16_t window_;
+    uint16_t acked_in_window_;
+    SeqNumRing<OutputMessagePtr> messages_;
     SeqNum last_unacked_;
     SeqNum last_sent_;
     SeqNum first_unacked_;
+    SeqNum recovery_seq_;
+    bool recovering_;
+    const std::chrono::microseconds flush_timeout_;
+    OutputMessagePtr open_message_;
+    std::chrono::steady_clock::time_point flush_deadline_;
+    bool flush_requested_;
+    uint64_t retransmissions_;
+    uint64_t window_stalls_;
     std::mutex mtx_;
     std::condition_variable cv_;
 };
@@ -273,7 +455,53 @@ inline void ReliableOutputStream::reset()
     last_unacked_ = UINT16_MAX;
     last_sent_ = UINT16_MAX;
     first_unacked_ = 0x0000;
+    recovery_seq_ = UINT16_MAX;
+    recovering_ = false;
+    window_ = min_window_;
+    acked_in_window_ = 0;
     messages_.clear();
+    open_message_.reset();
+    flush_requested_ = false;
+}
+
+/*
+ * Waits until the window has room for a new message, counting a stall if it is full on arrival.
+ */
+inline bool ReliableOutputStream::wait_window(
+        std::unique_lock<std::mutex>& lock,
+        std::chrono::steady_clock::time_point deadline)
+{
+    auto window_available = [&](){ return last_unacked_ + SeqNum(open_message_ ? 1 : 0) < first_unacked_ + SeqNum(window_ - 1); };
+    bool rv = window_available();
+    if (!rv)
+    {
+        ++window_stalls_;
+        rv = cv_.wait_until(lock, deadline, window_available);
+    }
+    return rv;
+}
+
+/*
+ * Stores the message of last_unacked_. The fragments of a submessage are pushed at once, so the window
+ * may exceed its depth, in that case the ring grows to hold it.
+ */
+inline void ReliableOutputStream::store_message(OutputMessagePtr&& output_message)
+{
+    messages_.reserve(size_t(uint16_t(last_unacked_ - first_unacked_)) + 1, first_unacked_, last_unacked_ - 1);
+    messages_[last_unacked_] = std::move(output_message);
+}
+
+/*
+ * Stores the aggregated message, if any. It was numbered last_unacked_ + 1 when it was opened and, although it
+ * is neither sent nor announced in heartbeats until closed, it already takes its place in the window.
+ */
+inline void ReliableOutputStream::close_message()
+{
+    if (open_message_)
+    {
+        last_unacked_ += 1;
+        store_message(std::move(open_message_));
+    }
 }
 
 template<class T>
@@ -282,16 +510,22 @@ inline bool ReliableOutputStream::push_submessage(
         dds::xrce::StreamId stream_id,
         dds::xrce::SubmessageId submessage_id,
         const T& submessage,
-        std::chrono::milliseconds timeout)
+        std::chrono::milliseconds timeout,
+        uint8_t flags)
 {
     bool rv = false;
     std::unique_lock<std::mutex> lock(mtx_);
     auto now = std::chrono::steady_clock::now();
 
-    if (cv_.wait_until(
-            lock,
-            now + timeout, [&](){ return last_unacked_ < first_unacked_ + SeqNum(RELIABLE_STREAM_DEPTH - 1); }))
+    const bool aggregate = (std::chrono::microseconds(0) < flush_timeout_) && (dds::xrce::DATA == submessage_id);
+    if (aggregate && open_message_ && open_message_->fits_submessage(submessage.getCdrSerializedSize()))
+    {
+        rv = open_message_->append_submessage(submessage_id, submessage, flags);
+    }
+    else if (wait_window(lock, now + timeout))
     {
+        close_message();
+
         /* Message header. */
         dds::xrce::MessageHeader message_header;
         message_header.session_id(session_info.session_id);
@@ -301,7 +535,7 @@ inline bool ReliableOutputStream::push_submessage(
         /* Submessage header. */
         dds::xrce::SubmessageHeader submessage_header;
         submessage_header.submessage_id(submessage_id);
-        submessage_header.flags(dds::xrce::FLAG_LITTLE_ENDIANNESS);
+        submessage_header.flags(flags);
         submessage_header.submessage_length(uint16_t(submessage.getCdrSerializedSize()));
 
         /* Compute message size. */
@@ -313,24 +547,37 @@ inline bool ReliableOutputStream::push_submessage(
         if ((header_size + submessage_size) <= session_info.mtu)
         {
             /* Create message. */
-            last_unacked_ += 1;
-            message_header.sequence_nr(last_unacked_);
-            OutputMessagePtr output_message(new OutputMessage(message_header, header_size + submessage_size));
-            if (output_message->append_submessage(submessage_id, submessage))
+            message_header.sequence_nr(last_unacked_ + 1);
+            OutputMessagePtr output_message(
+                new OutputMessage(message_header, aggregate ? session_info.mtu : header_size + submessage_size));
+            if (output_message->append_submessage(submessage_id, submessage, flags))
             {
-                /* Push message. */
-                messages_.insert(std::make_pair(last_unacked_, std::move(output_message)));
+                if (aggregate)
+                {
+                    /* Keep the message open for the following DATA submessages. */
+                    open_message_ = std::move(output_message);
+                    flush_deadline_ = std::chrono::steady_clock::now() + flush_timeout_;
+                    flush_requested_ = true;
+                }
+                else
+                {
+                    /* Push message. */
+                    last_unacked_ += 1;
+                    store_message(std::move(output_message));
+                }
                 rv = true;
             }
         }
         else
         {
-            /* Serialize submessage. */
-            std::unique_ptr<uint8_t[]> buf(new uint8_t[submessage_size]);
-            fastcdr::FastBuffer fastbuffer(reinterpret_cast<char*>(buf.get()), submessage_size);
+            /* Serialize submessage head. */
+            const size_t tail_size = get_tail_size(submessage);
+            const size_t head_size = submessage_size - tail_size;
+            std::unique_ptr<uint8_t[]> buf(new uint8_t[head_size]);
+            fastcdr::FastBuffer fastbuffer(reinterpret_cast<char*>(buf.get()), head_size);
             fastcdr::Cdr serializer(fastbuffer);
             submessage_header.serialize(serializer);
-            submessage.serialize(serializer);
+            const uint8_t* tail = serialize_head(serializer, submessage);
 
             const size_t max_fragment_size = session_info.mtu - header_size - subheader_size;
             dds::xrce::SubmessageHeader fragment_subheader;
@@ -349,7 +596,7 @@ inline bool ReliableOutputStream::push_submessage(
                 else
                 {
                     fragment_size = uint16_t(submessage_size - serialized_size);
-                    fragment_subheader.flags(submessage_header.flags() | dds::xrce::FLAG_LAST_FRAGMENT);
+                    fragment_subheader.flags(dds::xrce::FLAG_LITTLE_ENDIANNESS | dds::xrce::FLAG_LAST_FRAGMENT);
                 }
                 fragment_subheader.submessage_length(fragment_size);
 
@@ -359,10 +606,18 @@ inline bool ReliableOutputStream::push_submessage(
                 last_unacked_ += 1;
                 message_header.sequence_nr(last_unacked_);
                 OutputMessagePtr output_message(new OutputMessage(message_header, current_message_size));
-                if (output_message->append_fragment(fragment_subheader,  buf.get() + serialized_size, fragment_size))
+                const size_t head_part =
+                    (serialized_size < head_size) ? (std::min)(head_size - serialized_size, size_t(fragment_size)) : 0;
+                const size_t tail_offset = (serialized_size > head_size) ? (serialized_size - head_size) : 0;
+                if (output_message->append_fragment(
+                        fragment_subheader,
+                        buf.get() + (serialized_size - tail_offset),
+                        head_part,
+                        tail + tail_offset,
+                        fragment_size - head_part))
                 {
                     /* Push message. */
-                    messages_.insert(std::make_pair(last_unacked_, std::move(output_message)));
+                    store_message(std::move(output_message));
                     serialized_size += fragment_size;
                 }
                 else
@@ -384,7 +639,7 @@ inline bool ReliableOutputStream::get_next_message(OutputMessagePtr& output_mess
     if (last_sent_ < last_unacked_)
     {
         last_sent_ += 1;
-        output_message = messages_.at(last_sent_);
+        output_message = messages_[last_sent_];
         rv = true;
     }
     return rv;
@@ -396,26 +651,69 @@ inline bool ReliableOutputStream::get_message(
 {
     bool rv = false;
     std::lock_guard<std::mutex> lock(mtx_);
-    auto it = messages_.find(seq_num);
-    if (it != messages_.end())
+    if ((first_unacked_ <= seq_num) && (seq_num <= last_unacked_) && messages_[seq_num])
     {
-        output_message = it->second;
+        output_message = messages_[seq_num];
+        ++retransmissions_;
         rv = true;
     }
     return rv;
 }
 
-inline void ReliableOutputStream::update_from_acknack(SeqNum first_unacked)
+inline void ReliableOutputStream::update_from_acknack(
+        SeqNum first_unacked,
+        bool nacked)
 {
     std::lock_guard<std::mutex> lock(mtx_);
     if (first_unacked <= last_sent_ + 1)
     {
+        uint16_t acked = 0;
         while (first_unacked > first_unacked_)
         {
-            messages_.erase(first_unacked_);
+            messages_[first_unacked_].reset();
             first_unacked_ += 1;
+            ++acked;
+        }
+        if (min_window_ < max_window_)
+        {
+            update_window(acked, nacked);
+        }
+        cv_.notify_all();
+    }
+}
+
+/*
+ * The window doubles once a whole window is acknowledged without NACKs and halves on NACKs.
+ * NACKs received until the messages sent before the last halving are acknowledged belong to the same loss,
+ * so they do not halve the window again.
+ */
+inline void ReliableOutputStream::update_window(
+        uint16_t acked,
+        bool nacked)
+{
+    if (recovering_ && (first_unacked_ > recovery_seq_))
+    {
+        recovering_ = false;
+    }
+
+    if (nacked)
+    {
+        if (!recovering_)
+        {
+            window_ = (std::max)(uint16_t(window_ / 2), min_window_);
+            acked_in_window_ = 0;
+            recovery_seq_ = last_sent_;
+            recovering_ = true;
+        }
+    }
+    else
+    {
+        acked_in_window_ = uint16_t(acked_in_window_ + acked);
+        if (acked_in_window_ >= window_)
+        {
+            window_ = (std::min)(uint16_t(2 * window_), max_window_);
+            acked_in_window_ = 0;
         }
-        cv_.notify_one();
     }
 }
 
@@ -424,7 +722,47 @@ inline bool ReliableOutputStream::fill_heartbeat(dds::xrce::HEARTBEAT_Payload& h
     std::lock_guard<std::mutex> lock(mtx_);
     heartbeat.first_unacked_seq_nr(first_unacked_);
     heartbeat.last_unacked_seq_nr(last_unacked_);
-    return !messages_.empty();
+    return first_unacked_ <= last_unacked_;
+}
+
+inline uint16_t ReliableOutputStream::get_window()
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    return window_;
+}
+
+inline bool ReliableOutputStream::flush(std::chrono::steady_clock::time_point now)
+{
+    bool rv = false;
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (open_message_ && (flush_deadline_ <= now))
+    {
+        close_message();
+        rv = true;
+    }
+    return rv;
+}
+
+inline bool ReliableOutputStream::take_flush_request(std::chrono::steady_clock::time_point& deadline)
+{
+    bool rv = false;
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (flush_requested_)
+    {
+        deadline = flush_deadline_;
+        flush_requested_ = false;
+        rv = true;
+    }
+    return rv;
+}
+
+inline void ReliableOutputStream::get_metrics(StreamMetrics& metrics)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    metrics.retransmissions = retransmissions_;
+    metrics.window_stalls = window_stalls_;
+    metrics.window = window_;
+    metrics.unacked = uint16_t(uint16_t(last_unacked_) - uint16_t(first_unacked_) + 1);
 }
 
 } // namespace uxr
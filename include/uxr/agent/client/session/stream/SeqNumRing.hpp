@@ -0,0 +1,116 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UXR_AGENT_CLIENT_SESSION_STREAM_SEQ_NUM_RING_HPP_
+#define UXR_AGENT_CLIENT_SESSION_STREAM_SEQ_NUM_RING_HPP_
+
+#include <uxr/agent/utils/SeqNum.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace eprosima {
+namespace uxr {
+
+/**
+ * @brief Sequence-indexed circular buffer for the messages of a reliable stream window.
+ *        The slot of a sequence number is seq % capacity. The capacity is rounded up to a power of two,
+ *        which divides the 2^16 sequence space, so any window of up to capacity consecutive sequence
+ *        numbers maps to distinct slots even across the wrap-around.
+ *        A slot holding a default constructed (null) element is empty.
+ */
+template<class T>
+class SeqNumRing
+{
+public:
+    explicit SeqNumRing(
+            size_t min_capacity)
+        : slots_(round_capacity(min_capacity))
+        , mask_{slots_.size() - 1}
+    {}
+
+    SeqNumRing(SeqNumRing&&) = delete;
+    SeqNumRing(const SeqNumRing&) = delete;
+    SeqNumRing& operator=(SeqNumRing&&) = delete;
+    SeqNumRing& operator=(const SeqNumRing&) = delete;
+
+    size_t capacity() const { return slots_.size(); }
+
+    T& operator[](
+            SeqNum seq_num)
+    {
+        return slots_[uint16_t(seq_num) & mask_];
+    }
+
+    const T& operator[](
+            SeqNum seq_num) const
+    {
+        return slots_[uint16_t(seq_num) & mask_];
+    }
+
+    /**
+     * @brief Empties every slot.
+     */
+    void clear()
+    {
+        for (T& slot : slots_)
+        {
+            slot = T();
+        }
+    }
+
+    /**
+     * @brief Grows the ring until it holds at least min_capacity slots, keeping the elements of the
+     *        window [first, last].
+     */
+    void reserve(
+            size_t min_capacity,
+            SeqNum first,
+            SeqNum last)
+    {
+        size_t capacity = round_capacity(min_capacity);
+        if (capacity > slots_.size())
+        {
+            std::vector<T> slots(capacity);
+            const size_t mask = capacity - 1;
+            for (SeqNum seq_num = first; seq_num <= last; seq_num += 1)
+            {
+                slots[uint16_t(seq_num) & mask] = std::move((*this)[seq_num]);
+            }
+            slots_.swap(slots);
+            mask_ = mask;
+        }
+    }
+
+private:
+    static size_t round_capacity(
+            size_t min_capacity)
+    {
+        size_t capacity = 1;
+        while ((capacity < min_capacity) && (capacity < (size_t(UINT16_MAX) + 1)))
+        {
+            capacity <<= 1;
+        }
+        return capacity;
+    }
+
+    std::vector<T> slots_;
+    size_t mask_;
+};
+
+} // namespace uxr
+} // namespace eprosima
+
+#endif // UXR_AGENT_CLIENT_SESSION_STREAM_SEQ_NUM_RING_HPP_
@@ -31,6 +31,8 @@ class Topic;
 class DataReader : public XRCEObject
 {
 public:
+    typedef Reader<bool, const WriteFnArgs&, dds::xrce::SampleDataSeq> SeqReader;
+
     static std::unique_ptr<DataReader> create(
         const dds::xrce::ObjectId& object_id,
         uint16_t subscriber_id,
@@ -47,9 +49,15 @@ public:
     bool matched(
             const dds::xrce::ObjectVariant& new_object_rep) const final;
 
+    /**
+     * @brief Starts the delivery requested by a READ_DATA. FORMAT_DATA_SEQ batches every available sample
+     *        that fits in the session MTU into a single DATA submessage, the rest of the formats are
+     *        delivered as FORMAT_DATA.
+     */
     bool read(
         const dds::xrce::READ_DATA_Payload& read_data,
         Reader<bool>::WriteFn write_fn,
+        SeqReader::WriteFn write_seq_fn,
         WriteFnArgs& cb_args);
 
 private:
@@ -62,9 +70,18 @@ private:
         std::vector<uint8_t>& data,
         std::chrono::milliseconds timeout);
 
+    bool read_seq_fn(
+        bool,
+        dds::xrce::SampleDataSeq& samples,
+        std::chrono::milliseconds timeout);
+
 private:
     std::shared_ptr<ProxyClient> proxy_client_;
     Reader<bool> reader_;
+    SeqReader seq_reader_;
+    uint16_t max_samples_;
+    uint16_t read_samples_;
+    size_t max_seq_bytes_;
 };
 
 } // namespace uxr
@@ -0,0 +1,79 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UXR_AGENT_LOGGER_ASYNC_LOGGER_HPP_
+#define UXR_AGENT_LOGGER_ASYNC_LOGGER_HPP_
+
+#include <uxr/agent/visibility.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace eprosima {
+namespace uxr {
+
+/**
+ * @brief Moves the formatting of message traces off the threads that receive, process and send messages.
+ *        Each of those threads pushes compact binary records into its own lock-free ring, dropping them
+ *        instead of blocking when the ring is full. A background thread drains the rings and either formats
+ *        the records through the logger or appends them to a binary file.
+ *
+ *        The binary file starts with the magic "UXRLOG1\n", followed by records in host byte order:
+ *        * Event:   uint8 0x01, uint16 event id, uint16 name length and the name.
+ *        * Message: uint8 0x02, int64 nanoseconds since epoch, uint32 client key, int32 fd (-1 if none),
+ *                   uint32 message length, uint16 event id, uint16 payload length and the payload.
+ *        Each event is written before its first message. The payload is the beginning of the message,
+ *        up to ASYNC_LOG_PAYLOAD_SIZE bytes.
+ */
+class AsyncLogger
+{
+public:
+    /**
+     * @brief Starts the background thread.
+     * @param file_path The binary file to write the records to. If empty, records are formatted through
+     *                  the logger, honouring its verbose level.
+     * @return true if started, false if already started or the file cannot be opened.
+     */
+    UXR_AGENT_EXPORT static bool start(
+            const std::string& file_path);
+
+    /**
+     * @brief Stops the background thread once the pushed records are written.
+     */
+    UXR_AGENT_EXPORT static void stop();
+
+    UXR_AGENT_EXPORT static bool enabled();
+
+    /**
+     * @brief Returns the id of the event with the given name, registering it if needed.
+     */
+    UXR_AGENT_EXPORT static uint16_t register_event(
+            const std::string& name);
+
+    /**
+     * @brief Pushes a message record into the ring of the calling thread. It never blocks.
+     */
+    UXR_AGENT_EXPORT static void push_message(
+            uint16_t event,
+            uint32_t client_key,
+            int32_t fd,
+            const uint8_t* buf,
+            size_t len);
+};
+
+} // namespace uxr
+} // namespace eprosima
+
+#endif // UXR_AGENT_LOGGER_ASYNC_LOGGER_HPP_
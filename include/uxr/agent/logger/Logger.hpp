@@ -19,6 +19,7 @@
 #include <uxr/agent/utils/Color.hpp>
 
 #ifdef UAGENT_LOGGER_PROFILE
+#include <uxr/agent/logger/AsyncLogger.hpp>
 #define SPDLOG_ACTIVE_LEVEL SPDLOG_LEVEL_TRACE
 #include <spdlog/spdlog.h>
 #include <spdlog/fmt/ostr.h>
@@ -138,8 +139,20 @@
 #endif
 
 #ifdef UAGENT_LOGGER_PROFILE
+/* In async mode, the status of the first message of each call site names its event. */
+#define UXR_AGENT_LOG_ASYNC_MESSAGE(STATUS, CLIENT_KEY, FD, BUF, LEN) \
+    { \
+        static const uint16_t uxr_log_event = eprosima::uxr::AsyncLogger::register_event(STATUS); \
+        eprosima::uxr::AsyncLogger::push_message(uxr_log_event, CLIENT_KEY, FD, BUF, LEN); \
+    } \
+    void(0)
+
 #define UXR_AGENT_LOG_MESSAGE(STATUS, CLIENT_KEY, BUF, LEN) \
-    if (spdlog::default_logger()->should_log(spdlog::level::trace)) \
+    if (eprosima::uxr::AsyncLogger::enabled()) \
+    { \
+        UXR_AGENT_LOG_ASYNC_MESSAGE(STATUS, CLIENT_KEY, -1, BUF, LEN); \
+    } \
+    else if (spdlog::default_logger()->should_log(spdlog::level::trace)) \
     { \
         UXR_AGENT_LOG_DEBUG(STATUS, UXR_MESSAGE_WITH_DATA_PATTERN, CLIENT_KEY, LEN, spdlog::to_hex(BUF, BUF + LEN)); \
     } \
@@ -150,7 +163,11 @@
     void(0)
 
 #define UXR_MULTIAGENT_LOG_MESSAGE(STATUS, CLIENT_KEY, FD, BUF, LEN) \
-    if (spdlog::default_logger()->should_log(spdlog::level::trace)) \
+    if (eprosima::uxr::AsyncLogger::enabled()) \
+    { \
+        UXR_AGENT_LOG_ASYNC_MESSAGE(STATUS, CLIENT_KEY, int32_t(FD), BUF, LEN); \
+    } \
+    else if (spdlog::default_logger()->should_log(spdlog::level::trace)) \
     { \
         UXR_AGENT_LOG_DEBUG(STATUS, UXR_MESSAGE_WITH_FD_PATTERN, CLIENT_KEY, FD, LEN, spdlog::to_hex(BUF, BUF + LEN)); \
     } \
@@ -15,12 +15,18 @@
 #ifndef UXR_AGENT_MESSAGE_INPUT_MESSAGE_HPP_
 #define UXR_AGENT_MESSAGE_INPUT_MESSAGE_HPP_
 
+#include <uxr/agent/config.hpp>
+#include <uxr/agent/message/MessageBuffer.hpp>
 #include <uxr/agent/types/MessageHeader.hpp>
 #include <uxr/agent/types/SubMessageHeader.hpp>
 
 #include <fastcdr/Cdr.h>
 #include <fastcdr/exceptions/Exception.h>
 
+#include <array>
+#include <cstring>
+#include <vector>
+
 namespace eprosima {
 namespace uxr {
 
@@ -28,30 +34,51 @@ class InputMessage
 {
 public:
     InputMessage(
-            uint8_t* buf,
+            const uint8_t* buf,
             size_t len)
-        : buf_(new uint8_t[len]),
+        : buffer_(MessageBufferPool::input_pool().acquire(len)),
           len_(len),
           header_(),
           subheader_(),
-          fastbuffer_(reinterpret_cast<char*>(buf_), len_),
+          fastbuffer_(reinterpret_cast<char*>(buffer_.data()), len_),
           deserializer_(fastbuffer_)
     {
-        memcpy(buf_, buf, len);
+        memcpy(buffer_.data(), buf, len);
+        init();
+    }
 
-        // A valid XRCE message must have a valid header and at least 1 submessage
-        valid_xrce_message_ = deserialize(header_);
-        valid_xrce_message_ = valid_xrce_message_ && count_submessages() > 0;
+    /**
+     * @brief Takes ownership of a buffer the message was received into, without copying it.
+     */
+    InputMessage(
+            MessageBuffer&& buffer,
+            size_t len)
+        : buffer_(std::move(buffer)),
+          len_(len),
+          header_(),
+          subheader_(),
+          fastbuffer_(reinterpret_cast<char*>(buffer_.data()), len_),
+          deserializer_(fastbuffer_)
+    {
+        init();
     }
 
-    uint8_t* get_buf() const { return buf_; }
+    /**
+     * @brief Takes ownership of a buffer filled by a scatter read, where the bytes that did not
+     *        fit in the head buffer were written to the tail one. Only in that case they are joined.
+     */
+    InputMessage(
+            MessageBuffer&& head,
+            const uint8_t* tail,
+            size_t len)
+        : InputMessage(join(std::move(head), tail, len), len)
+    {}
+
+    uint8_t* get_buf() const { return buffer_.data(); }
 
     size_t get_len() const { return len_; }
 
-    ~InputMessage()
-    {
-        delete[] buf_;
-    }
+    ~InputMessage() = default;
 
     InputMessage(InputMessage&&) = delete;
     InputMessage(const InputMessage&) = delete;
@@ -69,6 +96,12 @@ public:
 
     bool get_raw_payload(uint8_t* buf, size_t len);
 
+    /*
+     * Points data at the next len bytes of the message and skips them, with no copy.
+     * The bytes stay valid as long as the message does.
+     */
+    bool get_payload_view(const uint8_t*& data, size_t len);
+
     bool prepare_next_submessage();
 
     size_t count_submessages();
@@ -78,80 +111,142 @@ public:
     dds::xrce::SubmessageId get_submessage_id();
 
 private:
+    void init()
+    {
+        // A valid XRCE message must have a valid header and at least 1 submessage
+        valid_xrce_message_ = deserialize(header_);
+        valid_xrce_message_ = valid_xrce_message_ && index_submessages() > 0;
+    }
+
+    /*
+     * Position and subheader of a submessage, parsed once when the message is built.
+     */
+    struct SubmessageEntry
+    {
+        uint32_t payload_offset;
+        uint16_t length;
+        uint8_t id;
+        uint8_t flags;
+    };
+
+    static constexpr size_t inline_index_size = 8;
+
+    size_t index_submessages();
+
+    const SubmessageEntry& get_submessage_entry(size_t position) const
+    {
+        return (position < inline_index_size)
+               ? inline_index_[position]
+               : overflow_index_[position - inline_index_size];
+    }
+
+    static MessageBuffer join(
+            MessageBuffer&& head,
+            const uint8_t* tail,
+            size_t len);
+
     template<class T>
     bool deserialize(T& data);
 
     void log_error();
 
 private:
-    uint8_t* buf_;
+    MessageBuffer buffer_;
     size_t len_;
     dds::xrce::MessageHeader header_;
     dds::xrce::SubmessageHeader subheader_;
     fastcdr::FastBuffer fastbuffer_;
     fastcdr::Cdr deserializer_;
     bool valid_xrce_message_ = false;
+    std::array<SubmessageEntry, inline_index_size> inline_index_;
+    std::vector<SubmessageEntry> overflow_index_;
+    size_t submessage_count_ = 0;
+    size_t next_submessage_ = 0;
 };
 
 inline bool InputMessage::prepare_next_submessage()
 {
     bool rv = false;
-    deserializer_.jump((4 - ((deserializer_.getCurrentPosition() - deserializer_.getBufferPointer()) & 3)) & 3);
-    if (fastbuffer_.getBufferSize() > deserializer_.getSerializedDataLength())
+    if (next_submessage_ < submessage_count_)
     {
-        rv = deserialize(subheader_);
+        const SubmessageEntry& entry = get_submessage_entry(next_submessage_++);
+        subheader_.submessage_id(static_cast<dds::xrce::SubmessageId>(entry.id));
+        subheader_.flags(entry.flags);
+        subheader_.submessage_length(entry.length);
+        deserializer_.reset();
+        deserializer_.jump(entry.payload_offset);
+        rv = true;
     }
     return rv;
 }
 
 inline size_t InputMessage::count_submessages()
 {
-    fastcdr::Cdr local_deserializer(fastbuffer_);
-    dds::xrce::MessageHeader local_header;
-    dds::xrce::SubmessageHeader local_subheader;
+    return submessage_count_;
+}
 
-    local_header.deserialize(local_deserializer);
+inline size_t InputMessage::index_submessages()
+{
+    const size_t subheader_size = 4;
+    size_t offset = deserializer_.getSerializedDataLength();
+    for (;;)
+    {
+        offset += (4 - (offset & 3)) & 3;
+        if (len_ < offset + subheader_size)
+        {
+            break;
+        }
 
-    bool rv = false;
-    size_t count = 0;
+        const uint8_t* raw_subheader = buffer_.data() + offset;
+        SubmessageEntry entry;
+        entry.payload_offset = uint32_t(offset + subheader_size);
+        entry.id = raw_subheader[0];
+        entry.flags = raw_subheader[1];
+        entry.length = uint16_t(raw_subheader[2] | (raw_subheader[3] << 8));
 
-    do
-    {
-        local_deserializer.jump((4 - ((local_deserializer.getCurrentPosition() - local_deserializer.getBufferPointer()) & 3)) & 3);
-        if (fastbuffer_.getBufferSize() > local_deserializer.getSerializedDataLength())
+        if (submessage_count_ < inline_index_size)
         {
-            try
-            {
-                local_subheader.deserialize(local_deserializer);
-                count++;
-            }
-            catch(eprosima::fastcdr::exception::NotEnoughMemoryException& /*exception*/)
-            {
-                rv = false;
-            }
-        } else {
-            rv = false;
+            inline_index_[submessage_count_] = entry;
         }
-    } while (rv);
+        else
+        {
+            overflow_index_.push_back(entry);
+        }
+        ++submessage_count_;
 
-    return count;
+#ifdef UAGENT_TWEAK_XRCE_WRITE_LIMIT
+        // A zero length WRITE_DATA spans up to the end of the message.
+        if ((dds::xrce::WRITE_DATA == entry.id) && (0 == entry.length))
+        {
+            break;
+        }
+#endif
+        offset = entry.payload_offset + entry.length;
+    }
+    return submessage_count_;
 }
 
 inline dds::xrce::SubmessageId InputMessage::get_submessage_id()
 {
-    fastcdr::Cdr local_deserializer(fastbuffer_);
-    dds::xrce::MessageHeader local_header;
-    dds::xrce::SubmessageHeader local_subheader;
-
-    local_header.deserialize(local_deserializer);
+    return (0 < submessage_count_)
+           ? static_cast<dds::xrce::SubmessageId>(get_submessage_entry(0).id)
+           : dds::xrce::SubmessageHeader().submessage_id();
+}
 
-    local_deserializer.jump((4 - ((local_deserializer.getCurrentPosition() - local_deserializer.getBufferPointer()) & 3)) & 3);
-    if (fastbuffer_.getBufferSize() > local_deserializer.getSerializedDataLength())
+inline MessageBuffer InputMessage::join(
+        MessageBuffer&& head,
+        const uint8_t* tail,
+        size_t len)
+{
+    MessageBuffer buffer(std::move(head));
+    if (len > buffer.capacity())
     {
-        local_subheader.deserialize(local_deserializer);
+        MessageBuffer joined = MessageBufferPool::input_pool().acquire(len);
+        memcpy(joined.data(), buffer.data(), buffer.capacity());
+        memcpy(joined.data() + buffer.capacity(), tail, len - buffer.capacity());
+        buffer = std::move(joined);
     }
-
-    return local_subheader.submessage_id();
+    return buffer;
 }
 
 template<class T>
@@ -165,12 +260,12 @@ inline uint8_t InputMessage::get_raw_header(std::array<uint8_t, 8>& buf)
     uint8_t rv;
     if (128 > header_.session_id())
     {
-        memcpy(buf.data(), buf_, 8);
+        memcpy(buf.data(), buffer_.data(), 8);
         rv = 8;
     }
     else
     {
-        memcpy(buf.data(), buf_, 4);
+        memcpy(buf.data(), buffer_.data(), 4);
         rv = 4;
     }
     return rv;
@@ -195,6 +290,18 @@ inline bool InputMessage::get_raw_payload(uint8_t* buf, size_t len)
     return rv;
 }
 
+inline bool InputMessage::get_payload_view(const uint8_t*& data, size_t len)
+{
+    bool rv = false;
+    const size_t offset = deserializer_.getSerializedDataLength();
+    if ((offset <= len_) && (len <= len_ - offset))
+    {
+        data = buffer_.data() + offset;
+        rv = deserializer_.jump(len);
+    }
+    return rv;
+}
+
 template<class T>
 inline bool InputMessage::deserialize(T& data)
 {
@@ -0,0 +1,193 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UXR_AGENT_MESSAGE_MESSAGE_BUFFER_HPP_
+#define UXR_AGENT_MESSAGE_MESSAGE_BUFFER_HPP_
+
+#include <uxr/agent/scheduler/BoundedRing.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace eprosima {
+namespace uxr {
+
+class MessageBufferPool;
+
+/**
+ * @brief Owning handle to a buffer taken from a MessageBufferPool.
+ *        The buffer goes back to the pool when the handle is destroyed.
+ */
+class MessageBuffer
+{
+    friend class MessageBufferPool;
+
+public:
+    MessageBuffer()
+        : pool_{nullptr}
+        , data_{nullptr}
+        , capacity_{0}
+    {}
+
+    ~MessageBuffer()
+    {
+        reset();
+    }
+
+    MessageBuffer(MessageBuffer&& other) noexcept
+        : pool_{other.pool_}
+        , data_{other.data_}
+        , capacity_{other.capacity_}
+    {
+        other.pool_ = nullptr;
+        other.data_ = nullptr;
+        other.capacity_ = 0;
+    }
+
+    MessageBuffer& operator=(MessageBuffer&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            std::swap(pool_, other.pool_);
+            std::swap(data_, other.data_);
+            std::swap(capacity_, other.capacity_);
+        }
+        return *this;
+    }
+
+    MessageBuffer(const MessageBuffer&) = delete;
+    MessageBuffer& operator=(const MessageBuffer&) = delete;
+
+    uint8_t* data() const { return data_; }
+
+    size_t capacity() const { return capacity_; }
+
+    void reset();
+
+private:
+    MessageBuffer(
+            MessageBufferPool* pool,
+            uint8_t* data,
+            size_t capacity)
+        : pool_{pool}
+        , data_{data}
+        , capacity_{capacity}
+    {}
+
+    MessageBufferPool* pool_;
+    uint8_t* data_;
+    size_t capacity_;
+};
+
+/**
+ * @brief Pool of message buffers split in power-of-two size classes, from the minimum block size
+ *        up to the maximum one. Each class keeps its released blocks in a lock-free free-list,
+ *        bounded so that every class caches about the same number of bytes. Requests above the
+ *        maximum block size fall back to the heap.
+ *        A zeroed pool hands out zero-filled buffers and expects their owners to clear the bytes
+ *        they wrote before releasing them, so no buffer is ever filled in full more than once.
+ */
+class MessageBufferPool
+{
+    friend class MessageBuffer;
+
+public:
+    /**
+     * @brief Pool the transports receive input messages into.
+     */
+    static MessageBufferPool& input_pool();
+
+    /**
+     * @brief Zeroed pool output messages are serialized into.
+     */
+    static MessageBufferPool& output_pool();
+
+    MessageBufferPool(
+            size_t min_block_size,
+            size_t max_block_size,
+            size_t max_cached_blocks,
+            bool zeroed = false);
+
+    ~MessageBufferPool();
+
+    MessageBufferPool(MessageBufferPool&&) = delete;
+    MessageBufferPool(const MessageBufferPool&) = delete;
+    MessageBufferPool& operator=(MessageBufferPool&&) = delete;
+    MessageBufferPool& operator=(const MessageBufferPool&) = delete;
+
+    /**
+     * @brief Returns a buffer of at least the given size, the block of the smallest size class it fits in.
+     */
+    MessageBuffer acquire(
+            size_t size);
+
+    MessageBuffer acquire()
+    {
+        return acquire(max_block_size());
+    }
+
+    size_t max_block_size() const { return size_classes_.back()->block_size; }
+
+    bool zeroed() const { return zeroed_; }
+
+private:
+    struct SizeClass
+    {
+        SizeClass(
+                size_t size,
+                size_t max_cached_blocks)
+            : block_size{size}
+            , free_blocks{max_cached_blocks}
+        {}
+
+        const size_t block_size;
+        BoundedRing<uint8_t*> free_blocks;
+    };
+
+    SizeClass* find_size_class(
+            size_t size) const;
+
+    uint8_t* allocate(
+            size_t size) const
+    {
+        return zeroed_ ? new uint8_t[size]() : new uint8_t[size];
+    }
+
+    void release(
+            uint8_t* data,
+            size_t capacity);
+
+    std::vector<std::unique_ptr<SizeClass>> size_classes_;
+    const bool zeroed_;
+};
+
+inline void MessageBuffer::reset()
+{
+    if (nullptr != data_)
+    {
+        pool_->release(data_, capacity_);
+        pool_ = nullptr;
+        data_ = nullptr;
+        capacity_ = 0;
+    }
+}
+
+} // namespace uxr
+} // namespace eprosima
+
+#endif // UXR_AGENT_MESSAGE_MESSAGE_BUFFER_HPP_
@@ -15,6 +15,7 @@
 #ifndef UXR_AGENT_MESSAGE_OUTPUT_MESSAGE_HPP_
 #define UXR_AGENT_MESSAGE_OUTPUT_MESSAGE_HPP_
 
+#include <uxr/agent/message/MessageBuffer.hpp>
 #include <uxr/agent/types/MessageHeader.hpp>
 #include <uxr/agent/types/SubMessageHeader.hpp>
 #include <uxr/agent/utils/Functions.hpp>
@@ -22,26 +23,34 @@
 #include <fastcdr/Cdr.h>
 #include <fastcdr/exceptions/Exception.h>
 
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+
 namespace eprosima {
 namespace uxr {
 
 class OutputMessage
 {
+    friend class OutputMessagePtr;
+
 public:
     OutputMessage(
             const dds::xrce::MessageHeader& header,
             size_t len)
-        : buf_(new uint8_t[len]{0}),
+        : buffer_(MessageBufferPool::output_pool().acquire(len)),
           len_(len),
-          fastbuffer_(reinterpret_cast<char*>(buf_), len_),
-          serializer_(fastbuffer_)
+          fastbuffer_(reinterpret_cast<char*>(buffer_.data()), len_),
+          serializer_(fastbuffer_),
+          ref_count_(0)
     {
         serialize(header);
     }
 
     ~OutputMessage()
     {
-        delete[] buf_;
+        /* Output buffers are handed out zeroed, so only the serialized bytes need to be cleared. */
+        memset(buffer_.data(), 0, get_len());
     }
 
     OutputMessage(OutputMessage&&) = delete;
@@ -49,10 +58,20 @@ public:
     OutputMessage& operator=(OutputMessage&&) = delete;
     OutputMessage& operator=(const OutputMessage&) = delete;
 
-    uint8_t* get_buf() const { return buf_; }
+    uint8_t* get_buf() const { return buffer_.data(); }
 
     size_t get_len() const { return serializer_.getSerializedDataLength(); }
 
+    /**
+     * @brief Checks whether a submessage with a payload of submessage_len bytes, its aligned subheader included,
+     *        still fits in the message.
+     */
+    bool fits_submessage(size_t submessage_len) const
+    {
+        const size_t len = get_len();
+        return (len + ((4 - (len & 3)) & 3) + 4 + submessage_len) <= len_;
+    }
+
     template<class T>
     bool append_submessage(
             dds::xrce::SubmessageId submessage_id,
@@ -67,9 +86,19 @@ public:
 
     bool append_fragment(
             const dds::xrce::SubmessageHeader& subheader,
-            uint8_t* buf,
+            const uint8_t* buf,
             size_t len);
 
+    /**
+     * @brief Appends a fragment made of len bytes of buf followed by tail_len bytes of tail.
+     */
+    bool append_fragment(
+            const dds::xrce::SubmessageHeader& subheader,
+            const uint8_t* buf,
+            size_t len,
+            const uint8_t* tail,
+            size_t tail_len);
+
 private:
     bool append_subheader(
             dds::xrce::SubmessageId submessage_id,
@@ -82,10 +111,107 @@ private:
     void log_error();
 
 private:
-    uint8_t* buf_;
+    MessageBuffer buffer_;
     size_t len_;
     fastcdr::FastBuffer fastbuffer_;
     fastcdr::Cdr serializer_;
+    std::atomic<uint32_t> ref_count_;
+};
+
+/**
+ * @brief Shared handle to an OutputMessage. The reference count lives in the message itself,
+ *        so sharing a message takes a single allocation.
+ */
+class OutputMessagePtr
+{
+public:
+    OutputMessagePtr() noexcept
+        : message_{nullptr}
+    {}
+
+    OutputMessagePtr(std::nullptr_t) noexcept
+        : message_{nullptr}
+    {}
+
+    explicit OutputMessagePtr(
+            OutputMessage* message) noexcept
+        : message_{message}
+    {
+        acquire();
+    }
+
+    OutputMessagePtr(
+            const OutputMessagePtr& other) noexcept
+        : message_{other.message_}
+    {
+        acquire();
+    }
+
+    OutputMessagePtr(
+            OutputMessagePtr&& other) noexcept
+        : message_{other.message_}
+    {
+        other.message_ = nullptr;
+    }
+
+    ~OutputMessagePtr()
+    {
+        release();
+    }
+
+    OutputMessagePtr& operator=(
+            const OutputMessagePtr& other) noexcept
+    {
+        OutputMessagePtr(other).swap(*this);
+        return *this;
+    }
+
+    OutputMessagePtr& operator=(
+            OutputMessagePtr&& other) noexcept
+    {
+        OutputMessagePtr(std::move(other)).swap(*this);
+        return *this;
+    }
+
+    void reset(
+            OutputMessage* message = nullptr) noexcept
+    {
+        OutputMessagePtr(message).swap(*this);
+    }
+
+    void swap(
+            OutputMessagePtr& other) noexcept
+    {
+        std::swap(message_, other.message_);
+    }
+
+    OutputMessage* get() const noexcept { return message_; }
+
+    OutputMessage& operator*() const noexcept { return *message_; }
+
+    OutputMessage* operator->() const noexcept { return message_; }
+
+    explicit operator bool() const noexcept { return nullptr != message_; }
+
+private:
+    void acquire() noexcept
+    {
+        if (nullptr != message_)
+        {
+            message_->ref_count_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void release() noexcept
+    {
+        if ((nullptr != message_) && (1 == message_->ref_count_.fetch_sub(1, std::memory_order_acq_rel)))
+        {
+            delete message_;
+        }
+        message_ = nullptr;
+    }
+
+    OutputMessage* message_;
 };
 
 template<class T>
@@ -130,8 +256,18 @@ inline bool OutputMessage::append_raw_payload(
 
 inline bool OutputMessage::append_fragment(
         const dds::xrce::SubmessageHeader& subheader,
-        uint8_t* buf,
+        const uint8_t* buf,
         size_t len)
+{
+    return append_fragment(subheader, buf, len, nullptr, 0);
+}
+
+inline bool OutputMessage::append_fragment(
+        const dds::xrce::SubmessageHeader& subheader,
+        const uint8_t* buf,
+        size_t len,
+        const uint8_t* tail,
+        size_t tail_len)
 {
     bool rv = false;
     serializer_.jump((4 - ((serializer_.getCurrentPosition() - serializer_.getBufferPointer()) & 3)) & 3);
@@ -141,6 +277,10 @@ inline bool OutputMessage::append_fragment(
         {
             rv = true;
             serializer_.serializeArray(buf, len);
+            if (0 < tail_len)
+            {
+                serializer_.serializeArray(tail, tail_len);
+            }
         }
         catch(eprosima::fastcdr::exception::NotEnoughMemoryException & /*exception*/)
         {
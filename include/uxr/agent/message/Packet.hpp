@@ -31,8 +31,6 @@ struct InputPacket
     InputMessagePtr message;
 };
 
-typedef std::shared_ptr<OutputMessage> OutputMessagePtr;
-
 template<typename EndPoint>
 struct OutputPacket
 {
@@ -0,0 +1,168 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UXR_AGENT_METRICS_METRICS_HPP_
+#define UXR_AGENT_METRICS_METRICS_HPP_
+
+#include <uxr/agent/visibility.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace eprosima {
+namespace uxr {
+
+/**
+ * @brief Counter updated by a single thread and read by any other. Updates are relaxed load-store pairs
+ *        instead of read-modify-write operations, so they cost as much as a plain increment.
+ */
+class LocalCounter
+{
+public:
+    LocalCounter()
+        : value_{0}
+    {}
+
+    void add(
+            uint64_t value)
+    {
+        value_.store(value_.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    uint64_t load() const
+    {
+        return value_.load(std::memory_order_relaxed);
+    }
+
+    void store(
+            uint64_t value)
+    {
+        value_.store(value, std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<uint64_t> value_;
+};
+
+/**
+ * @brief Histogram with bounded relative error, as in HdrHistogram. Values below 2^precision_bits have a
+ *        bucket each, and greater ones share 2^precision_bits buckets per power of two, so a bucket is never
+ *        wider than 1/16 of its values. Values of max_value_bits bits or more fall into the last bucket.
+ *        It is recorded by a single thread and read by any other.
+ */
+class Histogram
+{
+public:
+    static constexpr uint32_t precision_bits = 4;
+    static constexpr uint32_t max_value_bits = 40;
+    static constexpr size_t bucket_count = size_t(max_value_bits - precision_bits + 1) << precision_bits;
+
+    UXR_AGENT_EXPORT Histogram();
+
+    UXR_AGENT_EXPORT Histogram(
+            const Histogram& other);
+
+    UXR_AGENT_EXPORT Histogram& operator=(
+            const Histogram& other);
+
+    UXR_AGENT_EXPORT void record(
+            uint64_t value);
+
+    /**
+     * @brief Adds the values of other, which may be concurrently recorded, to this histogram.
+     */
+    UXR_AGENT_EXPORT void merge(
+            const Histogram& other);
+
+    uint64_t count() const { return count_.load(); }
+
+    uint64_t sum() const { return sum_.load(); }
+
+    uint64_t max() const { return max_.load(std::memory_order_relaxed); }
+
+    /**
+     * @return  the highest value of the bucket holding the given quantile, between 0 and 1,
+     *          or 0 if the histogram is empty.
+     */
+    UXR_AGENT_EXPORT uint64_t value_at_quantile(
+            double quantile) const;
+
+    UXR_AGENT_EXPORT static size_t get_bucket(
+            uint64_t value);
+
+    UXR_AGENT_EXPORT static uint64_t get_bucket_max(
+            size_t bucket);
+
+private:
+    std::array<LocalCounter, bucket_count> buckets_;
+    LocalCounter count_;
+    LocalCounter sum_;
+    std::atomic<uint64_t> max_;
+};
+
+/**
+ * @brief Traffic of a transport server. Packets and bytes are counted once handed to or taken from the
+ *        transport, drops are the oldest packets evicted from a full queue, and depths are instantaneous.
+ */
+struct TransportMetrics
+{
+    std::string transport;
+    uint64_t packets_in = 0;
+    uint64_t bytes_in = 0;
+    uint64_t packets_out = 0;
+    uint64_t bytes_out = 0;
+    uint64_t input_drops = 0;
+    uint64_t output_drops = 0;
+    uint64_t input_queue_depth = 0;
+    uint64_t output_queue_depth = 0;
+};
+
+/**
+ * @brief State of a reliable output stream. Retransmissions are the messages resent on ACKNACK requests,
+ *        and window stalls the submessages which had to wait for the client to acknowledge the window.
+ */
+struct StreamMetrics
+{
+    uint32_t client_key = 0;
+    uint8_t stream_id = 0;
+    uint64_t retransmissions = 0;
+    uint64_t window_stalls = 0;
+    uint16_t window = 0;
+    uint16_t unacked = 0;
+};
+
+struct AgentMetrics
+{
+    TransportMetrics transport;
+    size_t clients = 0;
+    std::vector<StreamMetrics> streams;
+    /* Nanoseconds taken by the Processor to handle each input packet. */
+    Histogram processing_latency;
+
+    /**
+     * @brief Writes the metrics in the Prometheus text exposition format.
+     */
+    UXR_AGENT_EXPORT void write_prometheus(
+            std::ostream& os) const;
+};
+
+} // namespace uxr
+} // namespace eprosima
+
+#endif // UXR_AGENT_METRICS_METRICS_HPP_
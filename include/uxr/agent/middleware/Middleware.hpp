@@ -190,6 +190,18 @@ public:
             uint16_t datawriter_id,
             const std::vector<uint8_t>& data) = 0;
 
+    /**
+     * @brief Writes the serialized sample held in [data, data + length), which is only valid during the call.
+     *        Middlewares able to serialize straight from it avoid building an intermediate vector.
+     */
+    virtual bool write_raw_data(
+            uint16_t datawriter_id,
+            const uint8_t* data,
+            size_t length)
+    {
+        return write_data(datawriter_id, std::vector<uint8_t>(data, data + length));
+    }
+
     virtual bool write_request(
             uint16_t requester_id,
             uint32_t sequence_number,
@@ -215,6 +227,40 @@ public:
             std::vector<uint8_t>& data,
             std::chrono::milliseconds timeout) = 0;
 
+    /**
+     * @brief Reads the available samples of the datareader at once, waiting at most timeout for the first one.
+     *        A sample costs its size plus 8 bytes of framing, and the samples read never exceed max_bytes,
+     *        except a single first sample larger than it. By default only one sample is read.
+     * @return true if at least one sample was read.
+     */
+    virtual bool read_data_seq(
+            uint16_t datareader_id,
+            dds::xrce::SampleDataSeq& samples,
+            size_t /*max_samples*/,
+            size_t /*max_bytes*/,
+            std::chrono::milliseconds timeout)
+    {
+        samples.resize(1);
+        bool rv = read_data(datareader_id, samples.front().serialized_data(), timeout);
+        if (!rv)
+        {
+            samples.clear();
+        }
+        return rv;
+    }
+
+    /**
+     * @brief Sets the callback invoked when new data is available for the datareader.
+     *        The callback may run on a middleware thread and shall not block.
+     * @return false if the middleware does not notify data availability, so the datareader has to be polled.
+     */
+    virtual bool set_datareader_listener(
+            uint16_t /*datareader_id*/,
+            const std::function<void ()>& /*on_data_available*/)
+    {
+        return false;
+    }
+
 /**********************************************************************************************************************
  * Matched functions.
  **********************************************************************************************************************/
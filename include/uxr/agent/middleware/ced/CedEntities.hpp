@@ -15,10 +15,13 @@
 #ifndef UXR_AGENT_MIDDLEWARE_CED_CED_ENTITIES_HPP_
 #define UXR_AGENT_MIDDLEWARE_CED_CED_ENTITIES_HPP_
 
+#include <uxr/agent/config.hpp>
+#include <uxr/agent/types/XRCETypes.hpp>
 #include <uxr/agent/utils/SeqNum.hpp>
 
 #include <string>
 #include <array>
+#include <atomic>
 #include <vector>
 #include <mutex>
 #include <condition_variable>
@@ -88,6 +91,14 @@ public:
             int16_t domain_id,
             std::shared_ptr<CedGlobalTopic>& topic);
 
+    /**
+     * @brief Sets the number of samples kept by the topics named topic_name, instead of CED_HISTORY_DEPTH.
+     *        It applies to the topics created afterwards.
+     */
+    static void set_history_depth(
+            const std::string& topic_name,
+            uint16_t history_depth);
+
 private:
     CedTopicManager() = default;
     ~CedTopicManager() = default;
@@ -100,6 +111,7 @@ private:
     static std::unordered_map<uint32_t, OnNewDomain> on_new_domain_map_;
     static std::unordered_map<uint32_t, OnNewTopic> on_new_topic_map_;
     static std::unordered_map<int16_t, std::unordered_map<std::string, std::weak_ptr<CedGlobalTopic>>> topics_;
+    static std::unordered_map<std::string, uint16_t> history_depths_;
     static std::mutex mtx_;
 };
 
@@ -113,15 +125,31 @@ class CedGlobalTopic
 public:
     CedGlobalTopic(
             const std::string& topic_name,
-            int16_t domain_id);
+            int16_t domain_id,
+            uint16_t history_depth = CED_HISTORY_DEPTH);
 
     ~CedGlobalTopic();
 
     const std::string& name() const;
 
+    size_t history_depth() const { return history_.size(); }
+
 private:
+    /*
+     * Written sample. It is immutable once published, so readers share it instead of copying it under a lock.
+     */
+    struct Sample
+    {
+        SeqNum seq_num;
+        TopicSource src;
+        std::vector<uint8_t> data;
+    };
+
+    typedef std::shared_ptr<const Sample> SamplePtr;
+
     bool write(
-            const std::vector<uint8_t>& data,
+            const uint8_t* data,
+            size_t length,
             WriteAccess write_access,
             TopicSource topic_src,
             uint8_t& errcode);
@@ -133,27 +161,51 @@ private:
             ReadAccess read_access,
             uint8_t& errcode);
 
+    bool read_seq(
+            dds::xrce::SampleDataSeq& samples,
+            size_t max_samples,
+            size_t max_bytes,
+            std::chrono::milliseconds timeout,
+            SeqNum& last_read,
+            ReadAccess read_access,
+            uint8_t& errcode);
+
     bool check_write_access(
             WriteAccess write_access,
             TopicSource topic_src);
 
     bool check_read_access(
             ReadAccess read_access,
-            size_t index);
+            TopicSource topic_src);
 
     bool get_data(
             std::vector<uint8_t>& data,
             SeqNum& last_read,
             ReadAccess read_access);
 
+    bool take_next(
+            SeqNum& last_read,
+            SamplePtr& sample);
+
+    void add_listener(
+            const void* reader,
+            const std::function<void ()>& on_data_available);
+
+    void remove_listener(
+            const void* reader);
+
 private:
     const std::string name_;
     int16_t domain_id_;
-    SeqNum last_write_;
+    std::vector<SamplePtr> history_;
+    const uint16_t mask_;
+    std::atomic<uint16_t> last_write_;
+    std::mutex write_mtx_;
+    std::atomic<uint32_t> waiters_;
     std::mutex mtx_;
     std::condition_variable cv_;
-    std::array<std::vector<uint8_t>, 16> history_; // TODO (review history size)
-    std::array<TopicSource, 16> srcs_; // TODO (review history size)
+    std::unordered_map<const void*, std::function<void ()>> listeners_;
+    std::mutex listeners_mtx_;
 };
 
 /**********************************************************************************************************************
@@ -266,6 +318,11 @@ public:
         const std::vector<uint8_t>& data,
         uint8_t& errcode) const;
 
+    bool write(
+        const uint8_t* data,
+        size_t length,
+        uint8_t& errcode) const;
+
     const std::string& topic_name() const { return topic_->get_global_topic()->name(); }
 
 private:
@@ -290,13 +347,23 @@ public:
         , last_read_(UINT16_MAX)
         , read_access_(read_access)
     {}
-    ~CedDataReader() = default;
+    ~CedDataReader();
 
     bool read(
             std::vector<uint8_t>& data,
             std::chrono::milliseconds timeout,
             uint8_t& errcode);
 
+    bool read_seq(
+            dds::xrce::SampleDataSeq& samples,
+            size_t max_samples,
+            size_t max_bytes,
+            std::chrono::milliseconds timeout,
+            uint8_t& errcode);
+
+    void set_listener(
+            const std::function<void ()>& on_data_available);
+
     const std::string& topic_name() const { return topic_->get_global_topic()->name(); }
 
 private:
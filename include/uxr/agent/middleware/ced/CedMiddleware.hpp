@@ -402,6 +402,19 @@ public:
             uint16_t datawriter_id,
             const std::vector<uint8_t>& data) override;
 
+    /**
+     * @brief Writes the serialized sample held in [data, data + length) using the CedDataWriter identified by the
+     *        datawriter_id parameter. The sample is copied once, into the topic history.
+     * @param datawriter_id The CedDataWriter identifier.
+     * @param data          The data to be written.
+     * @param length        The length of the data.
+     * @return  true in case of successful writing and false in other case.
+     */
+    bool write_raw_data(
+            uint16_t datawriter_id,
+            const uint8_t* data,
+            size_t length) override;
+
     /**
      * @brief Not implemented.
      */
@@ -430,6 +443,34 @@ public:
             std::vector<uint8_t>& data,
             std::chrono::milliseconds timeout) override;
 
+    /**
+     * @brief Read the available data using the CedDataReader identified by the datareader_id parameter,
+     *        locking the topic once for all but the first sample.
+     * @param datareader_id The CedDataReader's identifier.
+     * @param samples       The data read.
+     * @param max_samples   The maximum number of samples to read.
+     * @param max_bytes     The maximum size of the samples read, 8 bytes of framing per sample included.
+     * @param timeout       The timeout (milliseconds) of the reading of the first sample.
+     * @return  true in case of successful reading and false in other case.
+     */
+    bool read_data_seq(
+            uint16_t datareader_id,
+            dds::xrce::SampleDataSeq& samples,
+            size_t max_samples,
+            size_t max_bytes,
+            std::chrono::milliseconds timeout) override;
+
+    /**
+     * @brief Set the callback invoked each time a sample is written into the topic of the CedDataReader
+     *        identified by the datareader_id parameter. The callback runs on the thread of the writer.
+     * @param datareader_id     The CedDataReader's identifier.
+     * @param on_data_available The callback.
+     * @return  true in case of successful setting and false in other case.
+     */
+    bool set_datareader_listener(
+            uint16_t datareader_id,
+            const std::function<void ()>& on_data_available) override;
+
     /**
      * @brief Not implemented.
      */
@@ -208,6 +208,15 @@ public:
             const std::vector<uint8_t>& data,
             fastrtps::rtps::WriteParams& wparams);
 
+    bool write(
+            const uint8_t* data,
+            size_t length);
+
+    bool write(
+            const uint8_t* data,
+            size_t length,
+            fastrtps::rtps::WriteParams& wparams);
+
     const fastrtps::rtps::GUID_t& get_guid() const;
 
     const fastrtps::Participant* get_participant() const;
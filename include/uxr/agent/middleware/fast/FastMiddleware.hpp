@@ -175,6 +175,11 @@ public:
             uint16_t datawriter_id,
             const std::vector<uint8_t>& data) override;
 
+    bool write_raw_data(
+            uint16_t datawriter_id,
+            const uint8_t* data,
+            size_t length) override;
+
     bool write_request(
             uint16_t requester_id,
             uint32_t sequence_number,
@@ -26,6 +26,8 @@
 #include <uxr/agent/types/TopicPubSubType.hpp>
 #include <uxr/agent/types/XRCETypes.hpp>
 
+#include <functional>
+#include <mutex>
 #include <unordered_map>
 
 namespace eprosima {
@@ -273,6 +275,7 @@ public:
     bool match(const fastrtps::PublisherAttributes& attrs) const;
     bool match_from_bin(const dds::xrce::OBJK_DataWriter_Binary& datawriter_xrce) const;
     bool write(const std::vector<uint8_t>& data);
+    bool write(const uint8_t* data, size_t length);
     const fastdds::dds::DataWriter* ptr() const;
     const fastdds::dds::DomainParticipant* participant() const;
 
@@ -285,12 +288,16 @@ private:
 /**********************************************************************************************************************
  * FastDataReader
  **********************************************************************************************************************/
-class FastDDSDataReader
+class FastDDSDataReader : public fastdds::dds::DataReaderListener
 {
 public:
     FastDDSDataReader(const std::shared_ptr<FastDDSSubscriber>& subscriber)
         : subscriber_{subscriber}
         , ptr_{nullptr}
+        , held_data_{}
+        , held_{false}
+        , on_data_available_{}
+        , listener_mtx_{}
     {}
 
     ~FastDDSDataReader();
@@ -309,13 +316,22 @@ public:
             std::vector<uint8_t>& data,
             std::chrono::milliseconds timeout,
             fastdds::dds::SampleInfo& sample_info);
+    void hold(std::vector<uint8_t>&& data);
+    void set_listener(const std::function<void ()>& on_data_available);
     const fastdds::dds::DataReader* ptr() const;
     const fastdds::dds::DomainParticipant* participant() const;
 
+private:
+    void on_data_available(fastdds::dds::DataReader* reader) override;
+
 private:
     std::shared_ptr<FastDDSSubscriber> subscriber_;
     std::shared_ptr<FastDDSTopic> topic_;
     fastdds::dds::DataReader* ptr_;
+    std::vector<uint8_t> held_data_;
+    bool held_;
+    std::function<void ()> on_data_available_;
+    std::mutex listener_mtx_;
 };
 
 /**********************************************************************************************************************
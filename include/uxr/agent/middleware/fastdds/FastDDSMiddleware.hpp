@@ -21,6 +21,7 @@
 #include <cstdint>
 #include <memory>
 #include <unordered_map>
+#include <unordered_set>
 
 namespace eprosima {
 namespace uxr {
@@ -28,6 +29,27 @@ namespace middleware {
 class CallbackFactory;
 } // namespace middleware
 
+/*
+ * FNV-1a hash of the whole GUID, as the entities of a participant only differ in their entity id.
+ */
+struct GuidHash
+{
+    size_t operator()(
+            const fastrtps::rtps::GUID_t& guid) const
+    {
+        uint64_t hash = 0xCBF29CE484222325;
+        for (auto octet : guid.guidPrefix.value)
+        {
+            hash = (hash ^ octet) * 0x100000001B3;
+        }
+        for (auto octet : guid.entityId.value)
+        {
+            hash = (hash ^ octet) * 0x100000001B3;
+        }
+        return size_t(hash);
+    }
+};
+
 class FastDDSMiddleware : public Middleware
 {
 public:
@@ -173,6 +195,11 @@ public:
             uint16_t datawriter_id,
             const std::vector<uint8_t>& data) override;
 
+    bool write_raw_data(
+            uint16_t datawriter_id,
+            const uint8_t* data,
+            size_t length) override;
+
     bool write_request(
             uint16_t requester_id,
             uint32_t sequence_number,
@@ -187,6 +214,17 @@ public:
             std::vector<uint8_t>& data,
             std::chrono::milliseconds timeout) override;
 
+    bool read_data_seq(
+            uint16_t datareader_id,
+            dds::xrce::SampleDataSeq& samples,
+            size_t max_samples,
+            size_t max_bytes,
+            std::chrono::milliseconds timeout) override;
+
+    bool set_datareader_listener(
+            uint16_t datareader_id,
+            const std::function<void ()>& on_data_available) override;
+
     bool read_request(
             uint16_t replier_id,
             std::vector<uint8_t>& data,
@@ -293,6 +331,11 @@ private:
     std::unordered_map<uint16_t, std::shared_ptr<FastDDSRequester>> requesters_;
     std::unordered_map<uint16_t, std::shared_ptr<FastDDSReplier>> repliers_;
 
+    /* GUIDs of the local writers, whose samples are not read back when intraprocess is enabled. */
+    std::unordered_set<fastrtps::rtps::GUID_t, GuidHash> datawriter_guids_;
+    std::unordered_set<fastrtps::rtps::GUID_t, GuidHash> requester_guids_;
+    std::unordered_set<fastrtps::rtps::GUID_t, GuidHash> replier_guids_;
+
     middleware::CallbackFactory& callback_factory_;
 };
 
@@ -17,7 +17,12 @@
 
 #include <uxr/agent/middleware/Middleware.hpp>
 
+#include <chrono>
+#include <condition_variable>
 #include <cstdint>
+#include <functional>
+#include <memory>
+#include <queue>
 #include <vector>
 #include <mutex>
 
@@ -73,6 +78,8 @@ public:
 
     void check_heartbeats();
 
+    void flush_output_streams(std::chrono::milliseconds timeout);
+
 private:
     void process_input_message(
             ProxyClient& client,
@@ -130,10 +137,39 @@ private:
             const std::vector<uint8_t>& buffer,
             std::chrono::milliseconds timeout);
 
+    bool read_data_seq_callback(
+            const WriteFnArgs& write_args,
+            const dds::xrce::SampleDataSeq& samples,
+            std::chrono::milliseconds timeout);
+
+    template<typename T>
+    bool push_data_submessage(
+            const WriteFnArgs& write_args,
+            const T& data_payload,
+            dds::xrce::DataFormat data_format,
+            std::chrono::milliseconds timeout);
+
+    void schedule_flush(
+            const std::shared_ptr<ProxyClient>& client,
+            dds::xrce::StreamId stream_id);
+
 private:
+    /* Aggregated output message waiting for its flush deadline. */
+    struct FlushRequest
+    {
+        std::chrono::steady_clock::time_point deadline;
+        std::weak_ptr<ProxyClient> client;
+        dds::xrce::StreamId stream_id;
+
+        bool operator>(const FlushRequest& other) const { return deadline > other.deadline; }
+    };
+
     Server<EndPoint>& server_;
     Middleware::Kind middleware_kind_;
     Root& root_;
+    std::priority_queue<FlushRequest, std::vector<FlushRequest>, std::greater<FlushRequest>> flush_requests_;
+    std::mutex flush_mtx_;
+    std::condition_variable flush_cv_;
 };
 
 } // namespace uxr
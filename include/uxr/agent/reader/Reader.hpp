@@ -15,14 +15,18 @@
 #ifndef UXR_AGENT_READER_READER_HPP_
 #define UXR_AGENT_READER_READER_HPP_
 
+#include <uxr/agent/config.hpp>
 #include <uxr/agent/types/XRCETypes.hpp>
+#include <uxr/agent/reader/ReaderExecutor.hpp>
 #include <uxr/agent/utils/TokenBucket.hpp>
 
 #include <atomic>
-#include <thread>
+#include <functional>
+#include <memory>
 #include <mutex>
 #include <chrono>
 #include <type_traits>
+#include <vector>
 
 namespace eprosima {
 namespace uxr {
@@ -38,14 +42,23 @@ struct WriteFnArgs
     dds::xrce::RequestId request_id;
 };
 
-template<typename RA, typename WA = const WriteFnArgs&>
+/**
+ * @brief Delivers the samples of a reader according to a DataDeliveryControl.
+ *        The delivery runs as a task of the shared ReaderExecutor instead of a thread per reader. The task is woken
+ *        up by notify() when the middleware signals new data or, for middlewares without notifications, polled
+ *        every READER_POLL_PERIOD. Pacing and full output streams reschedule it through the executor timers.
+ *        Each read and write handles a single sample, or a batch of them when D is a SampleDataSeq.
+ */
+template<typename RA, typename WA = const WriteFnArgs&, typename D = std::vector<uint8_t>>
 class Reader
 {
 public:
-    typedef const std::function<bool (RA, std::vector<uint8_t>&, std::chrono::milliseconds)> ReadFn;
-    typedef const std::function<bool (WA, const std::vector<uint8_t>&, std::chrono::milliseconds)> WriteFn;
+    typedef const std::function<bool (RA, D&, std::chrono::milliseconds)> ReadFn;
+    typedef const std::function<bool (WA, const D&, std::chrono::milliseconds)> WriteFn;
 
 public:
+    Reader();
+
     ~Reader();
 
     bool start_reading(
@@ -57,34 +70,98 @@ public:
 
     bool stop_reading();
 
-private:
-    void read_task(
-        ReadFn read_fn,
-        WriteFn write_fn);
+    /**
+     * @brief Enables notify() as the only trigger of the reads, instead of polling.
+     */
+    void set_event_driven(bool event_driven) { event_driven_ = event_driven; }
+
+    /**
+     * @brief Signals that new data may be available. It may be called from any thread.
+     */
+    void notify();
 
 private:
-    dds::xrce::DataDeliveryControl delivery_control_;
-    typename std::decay<RA>::type read_args_;
-    typename std::decay<WA>::type write_args_;
-    std::atomic<bool> running_cond_;
-    std::thread thread_;
+    class ReadTask : public ReaderExecutor::Task
+    {
+    public:
+        ReadTask(
+                ReaderExecutor& executor,
+                const dds::xrce::DataDeliveryControl& delivery_control,
+                ReadFn& read_fn,
+                RA read_args,
+                WriteFn& write_fn,
+                WA write_args,
+                bool event_driven);
+
+        void run() override;
+
+    private:
+        bool is_finished(std::chrono::steady_clock::time_point now) const;
+
+        void wait_until(std::chrono::steady_clock::time_point time);
+
+    private:
+        ReaderExecutor& executor_;
+        const dds::xrce::DataDeliveryControl delivery_control_;
+        typename std::decay<ReadFn>::type read_fn_;
+        typename std::decay<RA>::type read_args_;
+        typename std::decay<WriteFn>::type write_fn_;
+        typename std::decay<WA>::type write_args_;
+        const bool event_driven_;
+        const bool paced_;
+        utils::TokenBucket token_bucket_;
+        const std::chrono::steady_clock::time_point final_time_;
+        uint16_t message_count_;
+        D data_;
+        bool pending_;
+        bool paid_;
+    };
+
+    ReaderExecutor* executor_;
+    std::shared_ptr<ReadTask> task_;
+    std::atomic<bool> event_driven_;
     std::mutex mtx_;
+    std::mutex task_mtx_;
+
+    static size_t get_size(const std::vector<uint8_t>& data) { return data.size(); }
+
+    static size_t get_size(const dds::xrce::SampleDataSeq& data)
+    {
+        size_t size = 0;
+        for (const auto& sample : data)
+        {
+            size += sample.serialized_data().size();
+        }
+        return size;
+    }
 
-    static constexpr uint8_t rw_timeout = 100;
+    static uint16_t get_sample_count(const std::vector<uint8_t>& /*data*/) { return 1; }
+
+    static uint16_t get_sample_count(const dds::xrce::SampleDataSeq& data) { return uint16_t(data.size()); }
+
+    /* Reads and writes per run before yielding the worker to other readers. */
+    static constexpr uint16_t max_batch = 32;
     static constexpr uint16_t max_samples_zero = 0;
     static constexpr uint16_t max_samples_unlimited = 0xFFFF;
     static constexpr uint16_t max_elapsed_time_unlimited = 0;
     static constexpr uint16_t max_bytes_per_second_unlimited = 0;
 };
 
-template<typename RA, typename WA>
-inline Reader<RA, WA>::~Reader()
+template<typename RA, typename WA, typename D>
+inline Reader<RA, WA, D>::Reader()
+    : executor_{nullptr}
+    , task_{}
+    , event_driven_{false}
+{}
+
+template<typename RA, typename WA, typename D>
+inline Reader<RA, WA, D>::~Reader()
 {
     stop_reading();
 }
 
-template<typename RA, typename WA>
-inline bool Reader<RA, WA>::start_reading(
+template<typename RA, typename WA, typename D>
+inline bool Reader<RA, WA, D>::start_reading(
         const dds::xrce::DataDeliveryControl& delivery_control,
         ReadFn read_fn,
         RA read_args,
@@ -93,86 +170,164 @@ inline bool Reader<RA, WA>::start_reading(
 {
     std::lock_guard<std::mutex> lock(mtx_);
     bool rv = false;
-    if (!running_cond_)
+    if (!task_)
     {
-        delivery_control_ = delivery_control;
-        read_args_ = read_args;
-        write_args_ = write_args;
-        running_cond_ = true;
-        thread_ = std::thread(&Reader<RA, WA>::read_task, this, read_fn, write_fn);
+        if (!executor_)
+        {
+            executor_ = &ReaderExecutor::get();
+        }
+        std::shared_ptr<ReadTask> task = std::make_shared<ReadTask>(
+            *executor_, delivery_control, read_fn, read_args, write_fn, write_args, event_driven_);
+        {
+            std::lock_guard<std::mutex> task_lock(task_mtx_);
+            task_ = task;
+        }
+        executor_->schedule(task);
         rv = true;
     }
     return rv;
 }
 
-template<typename RA, typename WA>
-inline bool Reader<RA, WA>::stop_reading()
+template<typename RA, typename WA, typename D>
+inline bool Reader<RA, WA, D>::stop_reading()
 {
     std::lock_guard<std::mutex> lock(mtx_);
-    bool rv = true;
-    if (running_cond_)
+    std::shared_ptr<ReadTask> task;
     {
-        running_cond_ = false;
-        if (thread_.joinable())
-        {
-            thread_.join();
-        }
-        else
-        {
-            rv = false;
-        }
+        std::lock_guard<std::mutex> task_lock(task_mtx_);
+        task.swap(task_);
     }
-    return rv;
+    if (task)
+    {
+        executor_->cancel(task);
+    }
+    return true;
 }
 
-template<typename RA, typename WA>
-inline void Reader<RA, WA>::read_task(
-        ReadFn read_fn,
-        WriteFn write_fn)
+template<typename RA, typename WA, typename D>
+inline void Reader<RA, WA, D>::notify()
+{
+    std::shared_ptr<ReadTask> task;
+    {
+        std::lock_guard<std::mutex> task_lock(task_mtx_);
+        task = task_;
+    }
+    if (task)
+    {
+        executor_->schedule(task);
+    }
+}
+
+template<typename RA, typename WA, typename D>
+inline Reader<RA, WA, D>::ReadTask::ReadTask(
+        ReaderExecutor& executor,
+        const dds::xrce::DataDeliveryControl& delivery_control,
+        ReadFn& read_fn,
+        RA read_args,
+        WriteFn& write_fn,
+        WA write_args,
+        bool event_driven)
+    : executor_(executor)
+    , delivery_control_(delivery_control)
+    , read_fn_(read_fn)
+    , read_args_(read_args)
+    , write_fn_(write_fn)
+    , write_args_(write_args)
+    , event_driven_(event_driven)
+    , paced_(max_bytes_per_second_unlimited != delivery_control.max_bytes_per_second())
+    , token_bucket_(paced_ ? delivery_control.max_bytes_per_second() : 1)
+    , final_time_((max_elapsed_time_unlimited == delivery_control.max_elapsed_time())
+        ? std::chrono::steady_clock::time_point::max()
+        : std::chrono::steady_clock::now() + std::chrono::seconds(delivery_control.max_elapsed_time()))
+    , message_count_(0)
+    , data_{}
+    , pending_(false)
+    , paid_(false)
+{}
+
+template<typename RA, typename WA, typename D>
+inline bool Reader<RA, WA, D>::ReadTask::is_finished(std::chrono::steady_clock::time_point now) const
+{
+    return ((max_samples_unlimited != delivery_control_.max_samples()) &&
+            (message_count_ >= delivery_control_.max_samples())) ||
+           (now >= final_time_);
+}
+
+/*
+ * Runs the task again at the given time, or at the end of the delivery if it comes first.
+ */
+template<typename RA, typename WA, typename D>
+inline void Reader<RA, WA, D>::ReadTask::wait_until(std::chrono::steady_clock::time_point time)
+{
+    executor_.schedule_at(
+        this->shared_from_this(),
+        (time < final_time_) ? time : final_time_);
+}
+
+template<typename RA, typename WA, typename D>
+inline void Reader<RA, WA, D>::ReadTask::run()
 {
-    using namespace eprosima::uxr::utils;
     using namespace std::chrono;
 
-    constexpr std::chrono::milliseconds max_timeout{rw_timeout};
-
-    size_t rate = (max_bytes_per_second_unlimited == delivery_control_.max_bytes_per_second())
-        ? SIZE_MAX
-        : delivery_control_.max_bytes_per_second();
-    TokenBucket token_bucket{rate};
-    bool stop_cond = false;
-    uint16_t message_count = 0;
-    std::vector<uint8_t> data;
-    time_point<steady_clock> init_time = steady_clock::now();
-    time_point<steady_clock> final_time = (max_elapsed_time_unlimited == delivery_control_.max_elapsed_time()) 
-        ? time_point<steady_clock>::max()
-        : init_time + seconds(delivery_control_.max_elapsed_time());
-
-    milliseconds timeout;
-    while (running_cond_ && !stop_cond)
+    bool yield = true;
+    for (uint16_t i = 0; yield && (i < max_batch); ++i)
     {
-        timeout = std::min(max_timeout, duration_cast<milliseconds>(final_time - steady_clock::now()));
-        if (read_fn(read_args_, data, timeout))
+        const steady_clock::time_point now = steady_clock::now();
+        if (this->is_cancelled())
         {
-            bool submessage_pushed = false;
-            do {
-                if (token_bucket.consume_tokens(data.size(), timeout))
+            /* A write may have released the reader, and with it what read_fn_ and write_fn_ use. */
+            yield = false;
+        }
+        else if (!pending_ && is_finished(now))
+        {
+            yield = false;
+        }
+        else if (!pending_ && !read_fn_(read_args_, data_, milliseconds(0)))
+        {
+            /* Nothing to deliver until the middleware notifies new data or the next poll. */
+            wait_until(event_driven_ ? steady_clock::time_point::max() : now + READER_POLL_PERIOD);
+            yield = false;
+        }
+        else
+        {
+            pending_ = true;
+            steady_clock::time_point retry_time;
+            if (!paid_ && paced_ && !token_bucket_.try_consume_tokens(get_size(data_), retry_time))
+            {
+                if (steady_clock::time_point::max() == retry_time)
                 {
-                    do {
-                        timeout = std::min(max_timeout, duration_cast<milliseconds>(final_time - steady_clock::now()));
-                        submessage_pushed = write_fn(write_args_, data, timeout);
-                    } while (running_cond_ && !submessage_pushed);
-
-                    if (submessage_pushed)
-                    {
-                        ++message_count;
-                    }
+                    /* The data exceeds the bytes allowed per second, it can never be delivered. */
+                    pending_ = false;
                 }
-            } while(running_cond_ && !submessage_pushed);
+                else
+                {
+                    wait_until(retry_time);
+                    yield = false;
+                }
+            }
+            else
+            {
+                paid_ = true;
+                if (write_fn_(write_args_, data_, milliseconds(0)))
+                {
+                    pending_ = false;
+                    paid_ = false;
+                    message_count_ += get_sample_count(data_);
+                }
+                else
+                {
+                    /* The output stream is full. */
+                    wait_until(now + READER_POLL_PERIOD);
+                    yield = false;
+                }
+            }
         }
+    }
 
-        stop_cond = ((max_samples_unlimited != delivery_control_.max_samples()) &&
-                     (message_count == delivery_control_.max_samples())) || 
-                    (std::chrono::steady_clock::now() > final_time);
+    if (yield)
+    {
+        /* Let the other readers run before delivering the rest. */
+        executor_.schedule(this->shared_from_this());
     }
 }
 
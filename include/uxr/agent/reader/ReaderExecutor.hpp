@@ -0,0 +1,145 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UXR_AGENT_READER_READER_EXECUTOR_HPP_
+#define UXR_AGENT_READER_READER_EXECUTOR_HPP_
+
+#include <uxr/agent/utils/TimerWheel.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace eprosima {
+namespace uxr {
+
+/**
+ * @brief Runs the delivery tasks of the readers on a fixed pool of worker threads.
+ *        A task is queued when its reader signals new data or when one of its timers expires, and it is never
+ *        run by two workers at once. Timers are kept in a timer wheel served by a single thread.
+ *        The executor shared by every reader lives as long as the process. Its last reader may be released by one
+ *        of its own tasks, and a thread cannot join itself, so it is never destroyed.
+ */
+class ReaderExecutor
+{
+public:
+    class Task : public std::enable_shared_from_this<Task>
+    {
+        friend class ReaderExecutor;
+    public:
+        Task()
+            : queued_(false)
+            , running_(false)
+            , notified_(false)
+            , cancelled_(false)
+            , runner_{}
+        {}
+
+        virtual ~Task() = default;
+
+        /**
+         * @brief Delivers the available samples. It shall not block, but reschedule itself instead.
+         */
+        virtual void run() = 0;
+
+    protected:
+        /**
+         * @brief Tells whether the task was cancelled. A run shall check it after calling anything which may
+         *        cancel the task, as the owner of what it uses may already be gone.
+         */
+        bool is_cancelled()
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            return cancelled_;
+        }
+
+    private:
+        std::mutex mtx_;
+        std::condition_variable cv_;
+        bool queued_;
+        bool running_;
+        bool notified_;
+        bool cancelled_;
+        std::thread::id runner_;
+    };
+
+    static ReaderExecutor& get();
+
+    explicit ReaderExecutor(
+            size_t workers);
+
+    /**
+     * @brief Stops and joins the threads. It shall not be called from one of them.
+     */
+    ~ReaderExecutor();
+
+    ReaderExecutor(ReaderExecutor&&) = delete;
+    ReaderExecutor(const ReaderExecutor&) = delete;
+    ReaderExecutor& operator=(ReaderExecutor&&) = delete;
+    ReaderExecutor& operator=(const ReaderExecutor&) = delete;
+
+    /**
+     * @brief Queues the task. If it is running, it runs again once it finishes.
+     */
+    void schedule(
+            const std::shared_ptr<Task>& task);
+
+    /**
+     * @brief Queues the task at the given time. Expired timers of cancelled or destroyed tasks are dropped.
+     */
+    void schedule_at(
+            const std::shared_ptr<Task>& task,
+            std::chrono::steady_clock::time_point time);
+
+    /**
+     * @brief Prevents any further run of the task, waiting for the current one, if any, to finish.
+     *        When called from the task itself, it returns without waiting.
+     */
+    void cancel(
+            const std::shared_ptr<Task>& task);
+
+private:
+    void worker_loop();
+
+    void timer_loop();
+
+    void execute(
+            const std::shared_ptr<Task>& task);
+
+    void push_ready(
+            const std::shared_ptr<Task>& task);
+
+private:
+    std::vector<std::thread> workers_;
+    std::thread timer_thread_;
+    std::atomic<bool> running_cond_;
+
+    std::deque<std::shared_ptr<Task>> ready_;
+    std::mutex ready_mtx_;
+    std::condition_variable ready_cv_;
+
+    utils::TimerWheel<std::weak_ptr<Task>> timers_;
+    std::mutex timer_mtx_;
+    std::condition_variable timer_cv_;
+};
+
+} // namespace uxr
+} // namespace eprosima
+
+#endif // UXR_AGENT_READER_READER_EXECUTOR_HPP_
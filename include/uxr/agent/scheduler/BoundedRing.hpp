@@ -0,0 +1,218 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UXR_AGENT_SCHEDULER_BOUNDED_RING_HPP_
+#define UXR_AGENT_SCHEDULER_BOUNDED_RING_HPP_
+
+#include <uxr/agent/utils/Functions.hpp>
+
+#include <atomic>
+#include <memory>
+#include <new>
+#include <cstddef>
+#include <cstdint>
+
+namespace eprosima {
+namespace uxr {
+
+/**
+ * @brief Bounded lock-free ring (D. Vyukov's MPMC queue). Each slot holds a sequence number telling
+ *        whether it is free or filled for the current lap, so producers and consumers only contend
+ *        on their own position counter. Slots are padded to a cache line to avoid false sharing.
+ *        The capacity is at least 2, otherwise a filled slot could not be told from a free one.
+ */
+template<class T>
+class BoundedRing
+{
+public:
+    explicit BoundedRing(
+            size_t capacity);
+
+    ~BoundedRing();
+
+    BoundedRing(BoundedRing&&) = delete;
+    BoundedRing(const BoundedRing&) = delete;
+    BoundedRing& operator=(BoundedRing&&) = delete;
+    BoundedRing& operator=(const BoundedRing&) = delete;
+
+    size_t capacity() const { return capacity_; }
+
+    /**
+     * @brief Pushes an element at the tail.
+     * @return  false if the ring is full, in that case the element is left untouched.
+     */
+    bool try_push(
+            T&& element);
+
+    /**
+     * @brief Pops the element at the head.
+     * @return  false if there is no element ready.
+     */
+    bool try_pop(
+            T& element);
+
+    /**
+     * @brief Checks whether the element at the head is ready to be popped.
+     */
+    bool ready() const;
+
+    /**
+     * @brief Returns the number of elements, which is approximate while pushing or popping.
+     */
+    size_t size() const;
+
+private:
+    struct Slot
+    {
+        std::atomic<size_t> sequence;
+        T data;
+    };
+
+    static constexpr size_t slot_size = ((sizeof(Slot) + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE) * CACHE_LINE_SIZE;
+
+    Slot& slot(
+            size_t position) const
+    {
+        return *reinterpret_cast<Slot*>(slots_ + ((position % capacity_) * slot_size));
+    }
+
+    const size_t capacity_;
+    std::unique_ptr<uint8_t[]> storage_;
+    uint8_t* slots_;
+    uint8_t padding_0_[CACHE_LINE_SIZE];
+    std::atomic<size_t> enqueue_position_;
+    uint8_t padding_1_[CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+    std::atomic<size_t> dequeue_position_;
+    uint8_t padding_2_[CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+};
+
+template<class T>
+constexpr size_t BoundedRing<T>::slot_size;
+
+template<class T>
+inline BoundedRing<T>::BoundedRing(
+        size_t capacity)
+    : capacity_{(2 < capacity) ? capacity : 2}
+    , storage_{new uint8_t[(capacity_ * slot_size) + CACHE_LINE_SIZE]}
+    , slots_{nullptr}
+    , padding_0_{}
+    , enqueue_position_{0}
+    , padding_1_{}
+    , dequeue_position_{0}
+    , padding_2_{}
+{
+    void* base = storage_.get();
+    size_t space = (capacity_ * slot_size) + CACHE_LINE_SIZE;
+    slots_ = static_cast<uint8_t*>(std::align(CACHE_LINE_SIZE, capacity_ * slot_size, base, space));
+    for (size_t i = 0; i < capacity_; ++i)
+    {
+        Slot* s = new (slots_ + (i * slot_size)) Slot();
+        s->sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+template<class T>
+inline BoundedRing<T>::~BoundedRing()
+{
+    for (size_t i = 0; i < capacity_; ++i)
+    {
+        reinterpret_cast<Slot*>(slots_ + (i * slot_size))->~Slot();
+    }
+}
+
+template<class T>
+inline bool BoundedRing<T>::try_push(
+        T&& element)
+{
+    size_t position = enqueue_position_.load(std::memory_order_relaxed);
+    Slot* s = nullptr;
+    for (;;)
+    {
+        s = &slot(position);
+        size_t sequence = s->sequence.load(std::memory_order_acquire);
+        intptr_t diff = intptr_t(sequence) - intptr_t(position);
+        if (0 == diff)
+        {
+            if (enqueue_position_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (0 > diff)
+        {
+            return false;
+        }
+        else
+        {
+            position = enqueue_position_.load(std::memory_order_relaxed);
+        }
+    }
+
+    s->data = std::move(element);
+    s->sequence.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+template<class T>
+inline bool BoundedRing<T>::try_pop(
+        T& element)
+{
+    size_t position = dequeue_position_.load(std::memory_order_relaxed);
+    Slot* s = nullptr;
+    for (;;)
+    {
+        s = &slot(position);
+        size_t sequence = s->sequence.load(std::memory_order_acquire);
+        intptr_t diff = intptr_t(sequence) - intptr_t(position + 1);
+        if (0 == diff)
+        {
+            if (dequeue_position_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (0 > diff)
+        {
+            return false;
+        }
+        else
+        {
+            position = dequeue_position_.load(std::memory_order_relaxed);
+        }
+    }
+
+    element = std::move(s->data);
+    s->sequence.store(position + capacity_, std::memory_order_release);
+    return true;
+}
+
+template<class T>
+inline bool BoundedRing<T>::ready() const
+{
+    size_t position = dequeue_position_.load(std::memory_order_relaxed);
+    return slot(position).sequence.load(std::memory_order_acquire) == (position + 1);
+}
+
+template<class T>
+inline size_t BoundedRing<T>::size() const
+{
+    size_t dequeue_position = dequeue_position_.load(std::memory_order_relaxed);
+    size_t enqueue_position = enqueue_position_.load(std::memory_order_relaxed);
+    return (enqueue_position > dequeue_position) ? (enqueue_position - dequeue_position) : 0;
+}
+
+} // namespace uxr
+} // namespace eprosima
+
+#endif // UXR_AGENT_SCHEDULER_BOUNDED_RING_HPP_
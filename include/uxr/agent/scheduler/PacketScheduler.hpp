@@ -16,8 +16,12 @@
 #define UXR_AGENT_SCHEDULER_FCFS_SCHEDULER_HPP_
 
 #include <uxr/agent/scheduler/Scheduler.hpp>
+#include <uxr/agent/scheduler/BoundedRing.hpp>
 
 #include <deque>
+#include <vector>
+#include <map>
+#include <memory>
 #include <mutex>
 #include <condition_variable>
 #include <atomic>
@@ -25,19 +29,29 @@
 namespace eprosima {
 namespace uxr {
 
+/**
+ * @brief Multi-producer single-consumer priority scheduler. Each priority is a lock-free bounded ring
+ *        which drops its oldest element when full. The consumer only parks on the condition
+ *        variable when every ring is empty, and producers only take the mutex to wake it up.
+ */
 template<class T>
 class PacketScheduler : public Scheduler<T>
 {
 public:
     PacketScheduler(
             size_t max_size)
-        : deque_()
+        : queues_()
         , mtx_()
         , cond_var_()
         , running_cond_(false)
+        , waiting_(false)
+        , dropped_(0)
         , max_size_{max_size}
     {}
 
+    /**
+     * @brief Sets the capacity of a priority. It shall be called before pushing to that priority.
+     */
     void set_priority_size(uint8_t priority, size_t size);
 
     void init() final;
@@ -48,6 +62,9 @@ public:
             T&& element,
             uint8_t priority) final;
 
+    /**
+     * @brief Puts an element back at the head of a priority. It shall be called from the consumer thread.
+     */
     void push_front(
             T&& element,
             uint8_t priority);
@@ -55,38 +72,84 @@ public:
     bool pop(
             T& element) final;
 
+    bool pop(
+            std::vector<T>& elements,
+            size_t max_elements);
+
+    /**
+     * @brief Returns the number of elements waiting in the rings, which is approximate while pushing or popping.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Returns the number of elements evicted from a full ring so far.
+     */
+    uint64_t get_dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
 private:
-    bool empty();
+    struct PriorityQueue
+    {
+        PriorityQueue(size_t size)
+            : ring(size)
+            , retries()
+        {}
+
+        BoundedRing<T> ring;
+        std::deque<T> retries;
+    };
+
+    PriorityQueue& get_queue(uint8_t priority);
+
+    bool try_pop(T& element);
+
+    bool ready() const;
+
+    bool wait();
 
-    std::map<uint8_t, std::deque<T>> deque_;
-    std::map<uint8_t, size_t> sizes_;
+    void notify();
+
+    std::vector<std::unique_ptr<PriorityQueue>> queues_;
     std::mutex mtx_;
     std::condition_variable cond_var_;
-    bool running_cond_;
+    std::atomic<bool> running_cond_;
+    std::atomic<bool> waiting_;
+    std::atomic<uint64_t> dropped_;
     const size_t max_size_;
 };
 
 template<class T>
 inline void PacketScheduler<T>::set_priority_size(uint8_t priority, size_t size)
 {
-    std::lock_guard<std::mutex> lock(mtx_);
-    sizes_[priority] = size;
+    if (queues_.size() <= priority)
+    {
+        queues_.resize(size_t(priority) + 1);
+    }
+    if (!queues_[priority] || (queues_[priority]->ring.capacity() != size))
+    {
+        queues_[priority].reset(new PriorityQueue(size));
+    }
 }
 
 template<class T>
 inline void PacketScheduler<T>::init()
 {
-    std::lock_guard<std::mutex> lock(mtx_);
-    sizes_[0] = max_size_;
+    set_priority_size(0, max_size_);
     running_cond_ = true;
 }
 
 template<class T>
 inline void PacketScheduler<T>::deinit()
 {
-    std::lock_guard<std::mutex> lock(mtx_);
     running_cond_ = false;
-    cond_var_.notify_one();
+    std::lock_guard<std::mutex> lock(mtx_);
+    cond_var_.notify_all();
+}
+
+template<class T>
+inline typename PacketScheduler<T>::PriorityQueue& PacketScheduler<T>::get_queue(uint8_t priority)
+{
+    /* Unset priorities fall back to the default one. */
+    return ((priority < queues_.size()) && queues_[priority]) ? *queues_[priority] : *queues_[0];
 }
 
 template<class T>
@@ -94,13 +157,16 @@ inline void PacketScheduler<T>::push(
         T&& element,
         uint8_t priority)
 {
-    std::lock_guard<std::mutex> lock(mtx_);
-    if (sizes_[priority] <= deque_[priority].size())
+    BoundedRing<T>& ring = get_queue(priority).ring;
+    while (!ring.try_push(std::move(element)))
     {
-        deque_[priority].pop_front();
+        T oldest;
+        if (ring.try_pop(oldest))
+        {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
     }
-    deque_[priority].push_back(std::move(element));
-    cond_var_.notify_one();
+    notify();
 }
 
 template<class T>
@@ -108,21 +174,81 @@ inline void PacketScheduler<T>::push_front(
         T&& element,
         uint8_t priority)
 {
-    std::lock_guard<std::mutex> lock(mtx_);
-    deque_[priority].push_front(std::forward<T>(element));
+    get_queue(priority).retries.push_front(std::move(element));
 }
 
 template<class T>
-inline bool PacketScheduler<T>::empty()
+inline bool PacketScheduler<T>::try_pop(
+        T& element)
 {
-    for (auto& deque : deque_) {
-        if (!deque.second.empty())
+    for (auto iter = queues_.rbegin(); iter != queues_.rend(); ++iter)
+    {
+        if (!*iter)
         {
-            return false;
+            continue;
+        }
+        if (!(*iter)->retries.empty())
+        {
+            element = std::move((*iter)->retries.front());
+            (*iter)->retries.pop_front();
+            return true;
+        }
+        if ((*iter)->ring.try_pop(element))
+        {
+            return true;
         }
     }
+    return false;
+}
 
-    return true;
+template<class T>
+inline bool PacketScheduler<T>::ready() const
+{
+    for (const auto& queue : queues_)
+    {
+        if (queue && (!queue->retries.empty() || queue->ring.ready()))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+template<class T>
+inline size_t PacketScheduler<T>::size() const
+{
+    size_t rv = 0;
+    for (const auto& queue : queues_)
+    {
+        if (queue)
+        {
+            rv += queue->ring.size();
+        }
+    }
+    return rv;
+}
+
+template<class T>
+inline bool PacketScheduler<T>::wait()
+{
+    std::unique_lock<std::mutex> lock(mtx_);
+    waiting_.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    cond_var_.wait(lock, [this] { return !running_cond_ || ready(); });
+    waiting_.store(false, std::memory_order_relaxed);
+    return running_cond_;
+}
+
+template<class T>
+inline void PacketScheduler<T>::notify()
+{
+    /* Pairs with the fence in wait(): either the consumer sees the element or we see it parked. */
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiting_.load(std::memory_order_relaxed))
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        cond_var_.notify_one();
+    }
 }
 
 template<class T>
@@ -130,23 +256,31 @@ inline bool PacketScheduler<T>::pop(
         T& element)
 {
     bool rv = false;
-    std::unique_lock<std::mutex> lock(mtx_);
-    cond_var_.wait(lock, [this] { return !(empty() && running_cond_); });
-    if (running_cond_)
+    while (running_cond_ && !rv)
     {
-        uint8_t available_priority;
+        rv = try_pop(element) || (wait() && try_pop(element));
+    }
+    return rv;
+}
 
-        for(auto iter = deque_.rbegin(); iter != deque_.rend(); ++iter){
-            if(iter->second.size() > 0){
-                available_priority = iter->first;
-                break;
-            }
+template<class T>
+inline bool PacketScheduler<T>::pop(
+        std::vector<T>& elements,
+        size_t max_elements)
+{
+    bool rv = false;
+    T element;
+    while (running_cond_ && !rv)
+    {
+        rv = try_pop(element) || (wait() && try_pop(element));
+    }
+    if (rv)
+    {
+        elements.push_back(std::move(element));
+        while ((elements.size() < max_elements) && try_pop(element))
+        {
+            elements.push_back(std::move(element));
         }
-
-        element = std::move(deque_[available_priority].front());
-        deque_[available_priority].pop_front();
-        rv = true;
-        cond_var_.notify_one();
     }
     return rv;
 }
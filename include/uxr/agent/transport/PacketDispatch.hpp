@@ -0,0 +1,106 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UXR_AGENT_TRANSPORT_PACKET_DISPATCH_HPP_
+#define UXR_AGENT_TRANSPORT_PACKET_DISPATCH_HPP_
+
+#include <uxr/agent/message/Packet.hpp>
+#include <uxr/agent/transport/SessionManager.hpp>
+#include <uxr/agent/transport/endpoint/IPv4EndPoint.hpp>
+#include <uxr/agent/transport/endpoint/IPv6EndPoint.hpp>
+#include <uxr/agent/utils/Conversion.hpp>
+#include <uxr/agent/utils/Functions.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace eprosima {
+namespace uxr {
+
+/* Spreads the endpoints of IP transports across shards and workers; other transports always map to 0. */
+template<typename EndPoint>
+inline uint32_t get_endpoint_hash(const EndPoint& /* endpoint */)
+{
+    return 0;
+}
+
+template<>
+inline uint32_t get_endpoint_hash(const IPv4EndPoint& endpoint)
+{
+    uint64_t key = (uint64_t(endpoint.get_addr()) << 16) | endpoint.get_port();
+    return fibonacci_hash(key, 32);
+}
+
+template<>
+inline uint32_t get_endpoint_hash(const IPv6EndPoint& endpoint)
+{
+    uint64_t key = endpoint.get_port();
+    for (const auto& byte : endpoint.get_addr())
+    {
+        key = (key * 31) + byte;
+    }
+    return fibonacci_hash(key, 32);
+}
+
+inline uint32_t get_client_key_hash(uint32_t raw_client_key)
+{
+    return fibonacci_hash(raw_client_key, 32);
+}
+
+/**
+ * @brief Worker which processes an input packet. Sessions carrying the client key in their header go to
+ *        the worker of that key, the others to the worker of their source endpoint, which is how the
+ *        Processor identifies their client. The worker of a session never depends on whether it is
+ *        established, so all its packets, from CREATE_CLIENT on, are processed in order by one worker.
+ * @param workers   Number of workers, greater than 0.
+ */
+template<typename EndPoint>
+inline size_t get_input_worker(
+        const InputPacket<EndPoint>& input_packet,
+        size_t workers)
+{
+    uint32_t hash = 0;
+    if (input_packet.message->is_valid_xrce_message() &&
+        has_session_client_key(input_packet.message->get_header().session_id()))
+    {
+        hash = get_client_key_hash(conversion::clientkey_to_raw(input_packet.message->get_header().client_key()));
+    }
+    else
+    {
+        hash = get_endpoint_hash(input_packet.source);
+    }
+    return size_t(hash) % workers;
+}
+
+/**
+ * @brief Scheduler priority of an input packet: 1 for messages holding a single HEARTBEAT, 0 otherwise.
+ */
+template<typename EndPoint>
+inline uint8_t get_input_priority(
+        const InputPacket<EndPoint>& input_packet)
+{
+    uint8_t rv = 0;
+    if (input_packet.message->is_valid_xrce_message() &&
+        1U == input_packet.message->count_submessages() &&
+        dds::xrce::HEARTBEAT == input_packet.message->get_submessage_id())
+    {
+        rv = 1;
+    }
+    return rv;
+}
+
+} // namespace uxr
+} // namespace eprosima
+
+#endif // UXR_AGENT_TRANSPORT_PACKET_DISPATCH_HPP_
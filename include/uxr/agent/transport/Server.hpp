@@ -21,8 +21,12 @@
 #include <uxr/agent/scheduler/PacketScheduler.hpp>
 #include <uxr/agent/message/Packet.hpp>
 #include <uxr/agent/processor/Processor.hpp>
+#include <uxr/agent/metrics/Metrics.hpp>
 
+#include <mutex>
 #include <thread>
+#include <memory>
+#include <vector>
 
 namespace eprosima {
 namespace uxr {
@@ -35,13 +39,31 @@ class Server : public Agent, public SessionManager<EndPoint>
 {
     friend class Processor<EndPoint>;
 public:
-    Server(Middleware::Kind middleware_kind);
+    Server(
+            Middleware::Kind middleware_kind,
+            size_t io_batch_size = 1);
 
     virtual ~Server();
 
     UXR_AGENT_EXPORT bool start();
     UXR_AGENT_EXPORT bool stop();
 
+    /**
+     * @brief Splits the server into the given number of shards, each one with its own
+     *        receiver, processing and sender threads. It shall be called before start().
+     * @return  true if the transport supports sharding (or shards is 1), false otherwise.
+     */
+    UXR_AGENT_EXPORT bool set_shards(size_t shards);
+    UXR_AGENT_EXPORT virtual bool has_sharding() { return false; }
+
+    /**
+     * @brief Sets the number of processing workers. Input packets are dispatched by the client key
+     *        of their header, or by their source endpoint for sessions without it, so each session is
+     *        always processed in order by the same worker. It shall be called before start().
+     * @param workers   Number of workers, 0 means one per shard.
+     */
+    UXR_AGENT_EXPORT bool set_processing_workers(size_t workers);
+
 #ifdef UAGENT_DISCOVERY_PROFILE
     UXR_AGENT_EXPORT virtual bool has_discovery() = 0;
     UXR_AGENT_EXPORT bool enable_discovery(uint16_t discovery_port = DISCOVERY_PORT);
@@ -58,6 +80,12 @@ private:
     void push_output_packet(
             OutputPacket<EndPoint>&& output_packet);
 
+    void push_input_packet(
+            InputPacket<EndPoint>&& input_packet);
+
+    size_t get_worker_id(
+            const InputPacket<EndPoint>& input_packet);
+
     virtual bool init() = 0;
 
     virtual bool fini() = 0;
@@ -98,32 +126,111 @@ private:
             OutputPacket<EndPoint> output_packet,
             TransportRc& transport_rc) = 0;
 
+    virtual bool recv_message(
+            std::vector<InputPacket<EndPoint>>& input_packets,
+            size_t shard_id,
+            int timeout,
+            TransportRc& transport_rc);
+
+    /**
+     * @brief Sends a batch of packets through the given shard. Packets successfully handed to the
+     *        transport are removed from output_packets, so on failure it only holds the pending ones.
+     */
+    virtual bool send_message(
+            std::vector<OutputPacket<EndPoint>>& output_packets,
+            size_t shard_id,
+            TransportRc& transport_rc);
+
     virtual bool handle_error(TransportRc transport_rc) = 0;
 
-    void receiver_loop();
+    /**
+     * @brief Recovers a shard from a server error. Only the receiver and sender threads of that shard are
+     *        kept out of the transport meanwhile, so transports with sharding shall recover that shard alone.
+     *        By default it recovers the whole transport.
+     */
+    virtual bool handle_error(
+            TransportRc transport_rc,
+            size_t shard_id);
+
+    void get_transport_metrics(AgentMetrics& metrics) final;
+
+    void receiver_loop(size_t shard_id);
+
+    void sender_loop(size_t shard_id);
 
-    void sender_loop();
+    void batch_sender_loop(size_t shard_id);
 
-    void processing_loop();
+    void processing_loop(size_t worker_id);
 
     void heartbeat_loop();
 
+    void flush_loop();
+
     void error_handler_loop();
 
+    /*
+     * Reports a server error of a shard and waits until it is recovered.
+     */
+    void wait_error_handled(
+            size_t shard_id,
+            TransportRc transport_rc);
+
 protected:
+    size_t get_shards() const { return shards_.size(); }
+
     Processor<EndPoint>* processor_;
 
 private:
+    /* Updated only by the receiver or the sender thread of a shard. */
+    struct TrafficCounters
+    {
+        LocalCounter packets;
+        LocalCounter bytes;
+    };
+
+    struct Shard
+    {
+        Shard()
+            : output_scheduler(SERVER_QUEUE_MAX_SIZE)
+        {}
+
+        std::thread receiver_thread;
+        std::thread sender_thread;
+        /* Held by each thread while it uses the transport, so that the error handler can recover the shard. */
+        std::mutex receiver_mtx;
+        std::mutex sender_mtx;
+        /* Guarded by error_mtx_. */
+        TransportRc transport_rc = TransportRc::ok;
+        /* The scheduler keeps the counters of both threads in different cache lines. */
+        TrafficCounters received;
+        PacketScheduler<OutputPacket<EndPoint>> output_scheduler;
+        TrafficCounters sent;
+    };
+
+    struct Worker
+    {
+        Worker()
+            : input_scheduler(SERVER_QUEUE_MAX_SIZE)
+        {}
+
+        std::thread processing_thread;
+        PacketScheduler<InputPacket<EndPoint>> input_scheduler;
+        Histogram processing_latency;
+    };
+
+    bool is_batched() const { return (1 < io_batch_size_) || (1 < shards_.size()); }
+
+    const size_t io_batch_size_;
     std::mutex mtx_;
-    std::thread receiver_thread_;
-    std::thread sender_thread_;
-    std::thread processing_thread_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+    size_t processing_workers_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    /* Guards the replacement of shards and workers against the collection of metrics. */
+    std::mutex topology_mtx_;
     std::thread heartbeat_thread_;
+    std::thread flush_thread_;
     std::thread error_handler_thread_;
     std::atomic<bool> running_cond_;
-    PacketScheduler<InputPacket<EndPoint>> input_scheduler_;
-    PacketScheduler<OutputPacket<EndPoint>> output_scheduler_;
-    TransportRc transport_rc_;
     std::mutex error_mtx_;
     std::condition_variable error_cv_;
 };
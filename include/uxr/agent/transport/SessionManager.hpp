@@ -16,10 +16,10 @@
 #define UXR_AGENT_TRANSPORT_SESSIONMANAGER_HPP_
 
 #include <uxr/agent/logger/Logger.hpp>
+#include <uxr/agent/utils/SnapshotMap.hpp>
 
 #include <memory>
 #include <mutex>
-#include <map>
 
 namespace eprosima {
 namespace uxr {
@@ -29,6 +29,10 @@ inline constexpr bool has_session_client_key(uint8_t session_id)
     return 128 > session_id;
 }
 
+/**
+ * @brief Maps endpoints to client keys and back. Lookups never lock, so the receiving, sending and
+ *        processing threads do not serialize on them. Sessions are established and destroyed one at a time.
+ */
 template<typename EndPoint>
 class SessionManager
 {
@@ -53,8 +57,8 @@ public:
             EndPoint& endpoint);
 
 private:
-    std::map<EndPoint, uint32_t> endpoint_to_client_map_;
-    std::map<uint32_t, EndPoint> client_to_endpoint_map_;
+    utils::SnapshotMap<EndPoint, uint32_t> endpoint_to_client_map_;
+    utils::SnapshotMap<uint32_t, EndPoint> client_to_endpoint_map_;
     std::mutex mtx_;
 };
 
@@ -66,11 +70,11 @@ void SessionManager<EndPoint>::establish_session(
 {
     std::lock_guard<std::mutex> lock(mtx_);
 
-    auto it_client = client_to_endpoint_map_.find(client_key);
-    if (it_client != client_to_endpoint_map_.end())
+    EndPoint old_endpoint;
+    if (client_to_endpoint_map_.find(client_key, old_endpoint))
     {
-        endpoint_to_client_map_.erase(it_client->second);
-        it_client->second = endpoint;
+        endpoint_to_client_map_.erase(old_endpoint);
+        client_to_endpoint_map_.insert_or_assign(client_key, endpoint);
         UXR_AGENT_LOG_INFO(
             UXR_DECORATE_GREEN("session re-established"),
             "client_key: 0x{:08X}, address: {}",
@@ -79,7 +83,7 @@ void SessionManager<EndPoint>::establish_session(
     }
     else
     {
-        client_to_endpoint_map_.emplace(client_key, endpoint);
+        client_to_endpoint_map_.insert_or_assign(client_key, endpoint);
         UXR_AGENT_LOG_INFO(
             UXR_DECORATE_GREEN("session established"),
             "client_key: 0x{:08X}, address: {}",
@@ -89,15 +93,7 @@ void SessionManager<EndPoint>::establish_session(
 
     if (!has_session_client_key(session_id))
     {
-        auto it_endpoint = endpoint_to_client_map_.find(endpoint);
-        if (it_endpoint != endpoint_to_client_map_.end())
-        {
-            it_endpoint->second = client_key;
-        }
-        else
-        {
-            endpoint_to_client_map_.emplace(endpoint, client_key);
-        }
+        endpoint_to_client_map_.insert_or_assign(endpoint, client_key);
     }
 }
 
@@ -107,16 +103,16 @@ void SessionManager<EndPoint>::destroy_session(
 {
     std::lock_guard<std::mutex> lock(mtx_);
 
-    auto it = endpoint_to_client_map_.find(endpoint);
-    if (it != endpoint_to_client_map_.end())
+    uint32_t client_key;
+    if (endpoint_to_client_map_.find(endpoint, client_key))
     {
         UXR_AGENT_LOG_INFO(
             UXR_DECORATE_GREEN("session closed"),
             "client_key: 0x{:08X}, address: {}",
-            it->second,
+            client_key,
             endpoint);
-        client_to_endpoint_map_.erase(it->second);
-        endpoint_to_client_map_.erase(it->first);
+        client_to_endpoint_map_.erase(client_key);
+        endpoint_to_client_map_.erase(endpoint);
     }
 }
 
@@ -126,16 +122,16 @@ void SessionManager<EndPoint>::destroy_session(
 {
     std::lock_guard<std::mutex> lock(mtx_);
 
-    auto it = client_to_endpoint_map_.find(client_key);
-    if (it != client_to_endpoint_map_.end())
+    EndPoint endpoint;
+    if (client_to_endpoint_map_.find(client_key, endpoint))
     {
         UXR_AGENT_LOG_INFO(
             UXR_DECORATE_GREEN("session closed"),
             "client_key: 0x{:08X}, address: {}",
             client_key,
-            it->second);
-        endpoint_to_client_map_.erase(it->second);
-        client_to_endpoint_map_.erase(it->first);
+            endpoint);
+        endpoint_to_client_map_.erase(endpoint);
+        client_to_endpoint_map_.erase(client_key);
     }
 }
 
@@ -144,17 +140,7 @@ bool SessionManager<EndPoint>::get_client_key(
         const EndPoint& endpoint,
         uint32_t& client_key)
 {
-    bool rv = false;
-    std::lock_guard<std::mutex> lock(mtx_);
-
-    auto it = endpoint_to_client_map_.find(endpoint);
-    if (it != endpoint_to_client_map_.end())
-    {
-        client_key = it->second;
-        rv = true;
-    }
-
-    return rv;
+    return endpoint_to_client_map_.find(endpoint, client_key);
 }
 
 template<typename EndPoint>
@@ -162,17 +148,7 @@ bool SessionManager<EndPoint>::get_endpoint(
         uint32_t client_key,
         EndPoint& endpoint)
 {
-    bool rv = false;
-    std::lock_guard<std::mutex> lock(mtx_);
-
-    auto it = client_to_endpoint_map_.find(client_key);
-    if (it != client_to_endpoint_map_.end())
-    {
-        endpoint = it->second;
-        rv = true;
-    }
-
-    return rv;
+    return client_to_endpoint_map_.find(client_key, endpoint);
 }
 
 } // namespace uxr
@@ -88,6 +88,8 @@ public:
     /**
      * @brief Constructor.
      * @param name Name of the middleware to be implemented by this CustomAgent.
+     * @param endpoint Endpoint filled by recv_msg_function. Its members shall be added before
+     *        the agent is started, as it is frozen once init_function succeeds.
      * @param middleware_kind The middleware selected to represent the XRCE entities
      *        in the DDS world (FastDDS, FastRTPS, CED...)
      * @param framing Whether this agent transport shall use framing or not.
@@ -16,6 +16,7 @@
 #define _UXR_AGENT_TRANSPORT_CAN_ENDPOINT_HPP_
 
 #include <stdint.h>
+#include <functional>
 
 namespace eprosima {
 namespace uxr {
@@ -32,6 +33,11 @@ public:
 
     ~CanEndPoint() {}
 
+    bool operator==(const CanEndPoint& other) const
+    {
+        return (can_id_ == other.can_id_);
+    }
+
     bool operator<(const CanEndPoint& other) const
     {
         return (can_id_ < other.can_id_);
@@ -52,4 +58,17 @@ private:
 } // namespace uxr
 } // namespace eprosima
 
+namespace std {
+
+template<>
+struct hash<eprosima::uxr::CanEndPoint>
+{
+    size_t operator()(const eprosima::uxr::CanEndPoint& endpoint) const
+    {
+        return std::hash<uint32_t>{}(endpoint.get_can_id());
+    }
+};
+
+} // namespace std
+
 #endif //_UXR_AGENT_TRANSPORT_CAN_ENDPOINT_HPP_
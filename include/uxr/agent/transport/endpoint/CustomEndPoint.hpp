@@ -15,9 +15,17 @@
 #ifndef UXR_AGENT_TRANSPORT_ENDPOINT_CUSTOM_ENDPOINT_HPP_
 #define UXR_AGENT_TRANSPORT_ENDPOINT_CUSTOM_ENDPOINT_HPP_
 
+#include <cstring>
+#include <functional>
+#include <list>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <new>
 #include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
 
 namespace eprosima {
 namespace uxr {
@@ -27,6 +35,9 @@ namespace uxr {
  *        implementation, if applicable.
  *        A certain set of values are permitted, including unsigned integers and
  *        strings, which usually are more than enough to characterize an endpoint.
+ *        Once its members are added, an endpoint without string members can be frozen:
+ *        its values are then packed into a small inline key with a precomputed hash,
+ *        so copying, comparing and hashing it does not go through the members map.
  */
 class CustomEndPoint
 {
@@ -56,6 +67,32 @@ private:
         std::shared_ptr<void> data;
     } Member;
 
+    /**
+     * @brief Position of a member within the key of a frozen endpoint.
+     */
+    struct Slot
+    {
+        std::string name;
+        MemberKind kind;
+        uint8_t offset;
+        uint8_t size;
+    };
+
+    /**
+     * @brief Member layout of frozen endpoints. Layouts are interned and never released,
+     *        so that frozen endpoints only hold a pointer to theirs.
+     */
+    struct Layout
+    {
+        std::vector<Slot> slots;
+        uint8_t size;
+    };
+
+    /**
+     * @brief Maximum size of the key of a frozen endpoint.
+     */
+    static constexpr size_t frozen_key_capacity = 32;
+
     /**
      * @brief Exception to be launched when trying to insert two elements
      *        with the same key on the CustomEndPoint map.
@@ -110,6 +147,31 @@ private:
         std::string message_;
     };
 
+    class MemberSizeException : public std::exception
+    {
+    public:
+        MemberSizeException(
+                const char* file,
+                int line,
+                const char* func,
+                const std::string& key)
+        {
+            std::stringstream what;
+            what << file << ":" << line << ":" << func
+                 << ": Member '"
+                 << key << "' has a different size.";
+            message_ = what.str();
+        }
+
+        const char* what() const noexcept
+        {
+            return message_.c_str();
+        }
+
+    private:
+        std::string message_;
+    };
+
     class EmptyMemberException : public std::exception
     {
     public:
@@ -148,12 +210,17 @@ public:
      * @param name The member name,
      * @param kind The member kind.
      * @throw SameKeyException if member already exists.
-     * @return true if the insert was successful, or false otherwise.
+     * @return true if the insert was successful, or false otherwise, as when the endpoint is frozen.
      */
     bool add_member(
             const std::string& name,
             const MemberKind& kind)
     {
+        if (nullptr != layout_)
+        {
+            return false;
+        }
+
         if (members_.end() != members_.find(name))
         {
             throw SameKeyException(__FILE__, __LINE__, __FUNCTION__, name);
@@ -177,11 +244,67 @@ public:
     bool add_member(
             const std::string& name);
 
+    /**
+     * @brief Freezes the member layout: no more members can be added, and the member values are
+     *        kept in a packed key instead of the members map.
+     *        Only endpoints whose members are all unsigned integers, and fit in the key, can be frozen.
+     * @return true if the endpoint is frozen, false otherwise.
+     */
+    bool freeze()
+    {
+        if (nullptr != layout_)
+        {
+            return true;
+        }
+
+        Layout layout;
+        layout.size = 0;
+        /* Larger members first, so that every member is naturally aligned within the key. */
+        for (size_t member_size : {16, 8, 4, 2, 1})
+        {
+            for (const auto& member : members_)
+            {
+                if (member_size == kind_size(member.second.kind))
+                {
+                    layout.slots.push_back(Slot{member.first, member.second.kind, layout.size, uint8_t(member_size)});
+                    layout.size = uint8_t(layout.size + member_size);
+                }
+            }
+        }
+
+        if ((layout.slots.size() != members_.size())
+            || (frozen_key_capacity < layout.size)
+            || (64 < layout.slots.size()))
+        {
+            return false;
+        }
+
+        layout_ = intern(std::move(layout));
+        members_.clear();
+        reset();
+        return true;
+    }
+
+    /**
+     * @brief Tells whether the endpoint is frozen.
+     */
+    bool is_frozen() const
+    {
+        return nullptr != layout_;
+    }
+
     /**
      * @brief Helper method to reset all the contained data within members.
      */
     void reset()
     {
+        if (nullptr != layout_)
+        {
+            std::memset(key_, 0, layout_->size);
+            set_mask_ = 0;
+            hash_ = hash_key();
+        }
+
         for (auto& member : members_)
         {
             member.second.data.reset();
@@ -199,7 +322,11 @@ public:
             const std::string& name,
             const T& value)
     {
-        if (members_.end() == members_.find(name))
+        if (nullptr != layout_)
+        {
+            set_frozen_member<T>(name, value);
+        }
+        else if (members_.end() == members_.find(name))
         {
             throw NoExistingMemberException(__FILE__, __LINE__, __FUNCTION__, name);
         }
@@ -220,7 +347,11 @@ public:
             const std::string& name,
             T&& value)
     {
-        if (members_.end() == members_.find(name))
+        if (nullptr != layout_)
+        {
+            set_frozen_member<typename std::decay<T>::type>(name, value);
+        }
+        else if (members_.end() == members_.find(name))
         {
             throw NoExistingMemberException(__FILE__, __LINE__, __FUNCTION__, name);
         }
@@ -235,6 +366,17 @@ public:
      */
     void check_non_empty_members()
     {
+        if (nullptr != layout_)
+        {
+            for (size_t i = 0; i < layout_->slots.size(); ++i)
+            {
+                if (0 == (set_mask_ & (uint64_t(1) << i)))
+                {
+                    throw EmptyMemberException(layout_->slots[i].name);
+                }
+            }
+        }
+
         for (const auto& member : members_)
         {
             if (nullptr == member.second.data.get())
@@ -280,6 +422,15 @@ public:
     bool operator <(
             const CustomEndPoint& other) const
     {
+        if ((nullptr != layout_) || (nullptr != other.layout_))
+        {
+            if (layout_ != other.layout_)
+            {
+                return std::less<const Layout*>{}(layout_, other.layout_);
+            }
+            return 0 > std::memcmp(key_, other.key_, layout_->size);
+        }
+
         for (const auto& member : members_)
         {
             const std::string& member_name = member.first;
@@ -348,6 +499,82 @@ public:
         return false;
     }
 
+    /**
+     * @brief Operator == overload.
+     * @param other The CustomEndPoint to be checked against this one.
+     * @return True if neither endpoint is lower than the other.
+     */
+    bool operator ==(
+            const CustomEndPoint& other) const
+    {
+        if ((nullptr != layout_) || (nullptr != other.layout_))
+        {
+            return (layout_ == other.layout_)
+                && (hash_ == other.hash_)
+                && (0 == std::memcmp(key_, other.key_, layout_->size));
+        }
+        return !(*this < other) && !(other < *this);
+    }
+
+    /**
+     * @brief Hashes the member values, so that equal endpoints have equal hashes.
+     * @return The hash of this CustomEndPoint.
+     */
+    size_t hash() const
+    {
+        if (nullptr != layout_)
+        {
+            return hash_;
+        }
+
+        size_t rv = 0;
+        for (const auto& member : members_)
+        {
+            size_t member_hash = 0;
+            if (nullptr != member.second.data.get())
+            {
+                switch (member.second.kind)
+                {
+                    case MemberKind::UINT8:
+                    {
+                        member_hash = std::hash<uint8_t>{}(*static_cast<uint8_t *>(member.second.data.get()));
+                        break;
+                    }
+                    case MemberKind::UINT16:
+                    {
+                        member_hash = std::hash<uint16_t>{}(*static_cast<uint16_t *>(member.second.data.get()));
+                        break;
+                    }
+                    case MemberKind::UINT32:
+                    {
+                        member_hash = std::hash<uint32_t>{}(*static_cast<uint32_t *>(member.second.data.get()));
+                        break;
+                    }
+                    case MemberKind::UINT64:
+                    {
+                        member_hash = std::hash<uint64_t>{}(*static_cast<uint64_t *>(member.second.data.get()));
+                        break;
+                    }
+#ifdef __SIZEOF_UINT128__
+                    case MemberKind::UINT128:
+                    {
+                        uint128_t value = *static_cast<uint128_t *>(member.second.data.get());
+                        member_hash = std::hash<uint64_t>{}(uint64_t(value) ^ uint64_t(value >> 64));
+                        break;
+                    }
+#endif // __SIZEOF_UINT128__
+                    case MemberKind::STRING:
+                    {
+                        member_hash = std::hash<std::string>{}(*static_cast<std::string *>(member.second.data.get()));
+                        break;
+                    }
+                }
+            }
+            rv ^= member_hash + 0x9E3779B9 + (rv << 6) + (rv >> 2);
+        }
+        return rv;
+    }
+
     /**
      * @brief Operator << overload for ostream operations.
      * @param os The ostream object to which the output is sent.
@@ -358,6 +585,52 @@ public:
             std::ostream& os,
             const CustomEndPoint& endpoint)
     {
+        if (nullptr != endpoint.layout_)
+        {
+            for (const auto& slot : endpoint.layout_->slots)
+            {
+                if (&slot != &endpoint.layout_->slots.front())
+                {
+                    os << ", ";
+                }
+                os << slot.name << ": ";
+                switch (slot.kind)
+                {
+                    case MemberKind::UINT8:
+                    {
+                        os << *reinterpret_cast<const uint8_t *>(endpoint.key_ + slot.offset);
+                        break;
+                    }
+                    case MemberKind::UINT16:
+                    {
+                        os << *reinterpret_cast<const uint16_t *>(endpoint.key_ + slot.offset);
+                        break;
+                    }
+                    case MemberKind::UINT32:
+                    {
+                        os << *reinterpret_cast<const uint32_t *>(endpoint.key_ + slot.offset);
+                        break;
+                    }
+                    case MemberKind::UINT64:
+                    {
+                        os << *reinterpret_cast<const uint64_t *>(endpoint.key_ + slot.offset);
+                        break;
+                    }
+#ifdef __SIZEOF_UINT128__
+                    case MemberKind::UINT128:
+                    {
+                        os << *reinterpret_cast<const uint128_t *>(endpoint.key_ + slot.offset);
+                        break;
+                    }
+#endif // __SIZEOF_UINT128__
+                    case MemberKind::STRING:
+                    {
+                        break;
+                    }
+                }
+            }
+        }
+
         for (const auto& member : endpoint.members_)
         {
             os << member.first << ": ";
@@ -426,7 +699,12 @@ public:
     const T& get_member(
             const char* key) const
     {
-        if (members_.end() == members_.find(key))
+        if (nullptr != layout_)
+        {
+            const Slot& slot = get_slot<T>(key);
+            return *reinterpret_cast<const T *>(key_ + slot.offset);
+        }
+        else if (members_.end() == members_.find(key))
         {
             throw NoExistingMemberException(__FILE__, __LINE__, __FUNCTION__, key);
         }
@@ -449,8 +727,112 @@ public:
         return this->get_member<T>(key.c_str());
     }
 
+private:
+    /**
+     * @brief Size of the members of the given kind in a frozen key, or 0 if they cannot be frozen.
+     */
+    static size_t kind_size(
+            MemberKind kind)
+    {
+        switch (kind)
+        {
+            case MemberKind::UINT8:
+                return sizeof(uint8_t);
+            case MemberKind::UINT16:
+                return sizeof(uint16_t);
+            case MemberKind::UINT32:
+                return sizeof(uint32_t);
+            case MemberKind::UINT64:
+                return sizeof(uint64_t);
+#ifdef __SIZEOF_UINT128__
+            case MemberKind::UINT128:
+                return sizeof(uint128_t);
+#endif // __SIZEOF_UINT128__
+            default:
+                return 0;
+        }
+    }
+
+    /**
+     * @brief Returns the interned layout equal to the given one, interning it if there is none.
+     */
+    static const Layout* intern(
+            Layout&& layout)
+    {
+        static std::mutex mtx;
+        static std::list<Layout> layouts;
+
+        std::lock_guard<std::mutex> lock(mtx);
+        for (const auto& interned : layouts)
+        {
+            bool equal = (interned.slots.size() == layout.slots.size());
+            for (size_t i = 0; equal && i < layout.slots.size(); ++i)
+            {
+                equal = (interned.slots[i].name == layout.slots[i].name)
+                    && (interned.slots[i].kind == layout.slots[i].kind);
+            }
+            if (equal)
+            {
+                return &interned;
+            }
+        }
+        layouts.push_back(std::move(layout));
+        return &layouts.back();
+    }
+
+    /**
+     * @brief Finds the slot of a member of a frozen endpoint.
+     * @throw NoExistingMemberException if the member is not found.
+     * @throw MemberSizeException if the member size is not the size of T.
+     */
+    template <typename T>
+    const Slot& get_slot(
+            const std::string& name) const
+    {
+        for (const auto& slot : layout_->slots)
+        {
+            if (slot.name == name)
+            {
+                if (sizeof(T) != slot.size)
+                {
+                    throw MemberSizeException(__FILE__, __LINE__, __FUNCTION__, name);
+                }
+                return slot;
+            }
+        }
+        throw NoExistingMemberException(__FILE__, __LINE__, __FUNCTION__, name);
+    }
+
+    template <typename T>
+    void set_frozen_member(
+            const std::string& name,
+            const T& value)
+    {
+        const Slot& slot = get_slot<T>(name);
+        new (key_ + slot.offset) T(value);
+        set_mask_ |= uint64_t(1) << (&slot - layout_->slots.data());
+        hash_ = hash_key();
+    }
+
+    /**
+     * @brief FNV-1a over the key of a frozen endpoint.
+     */
+    size_t hash_key() const
+    {
+        uint64_t rv = UINT64_C(0xCBF29CE484222325);
+        for (size_t i = 0; i < layout_->size; ++i)
+        {
+            rv = (rv ^ key_[i]) * UINT64_C(0x100000001B3);
+        }
+        return size_t(rv);
+    }
+
 private:
     std::map<std::string, Member> members_;
+    const Layout* layout_ = nullptr;
+    alignas(16) unsigned char key_[frozen_key_capacity] = {};
+    uint64_t set_mask_ = 0;
+    size_t hash_ = 0;
 };
 
 /**
@@ -504,4 +886,17 @@ inline bool CustomEndPoint::add_member<std::string>(
 } // namespace uxr
 } // namespace eprosima
 
+namespace std {
+
+template<>
+struct hash<eprosima::uxr::CustomEndPoint>
+{
+    size_t operator()(const eprosima::uxr::CustomEndPoint& endpoint) const
+    {
+        return endpoint.hash();
+    }
+};
+
+} // namespace std
+
 #endif // UXR_AGENT_TRANSPORT_ENDPOINT_IPV4_ENDPOINT_HPP_
@@ -16,6 +16,7 @@
 #define UXR_AGENT_TRANSPORT_ENDPOINT_IPV4_ENDPOINT_HPP_
 
 #include <stdint.h>
+#include <functional>
 #include <iostream>
 
 namespace eprosima {
@@ -35,6 +36,11 @@ public:
 
     ~IPv4EndPoint() = default;
 
+    bool operator==(const IPv4EndPoint& other) const
+    {
+        return (addr_ == other.addr_) && (port_ == other.port_);
+    }
+
     bool operator<(const IPv4EndPoint& other) const
     {
         return (addr_ < other.addr_) || ((addr_ == other.addr_) && (port_ < other.port_));
@@ -62,4 +68,17 @@ private:
 } // namespace uxr
 } // namespace eprosima
 
+namespace std {
+
+template<>
+struct hash<eprosima::uxr::IPv4EndPoint>
+{
+    size_t operator()(const eprosima::uxr::IPv4EndPoint& endpoint) const
+    {
+        return std::hash<uint64_t>{}((uint64_t(endpoint.get_addr()) << 16) | endpoint.get_port());
+    }
+};
+
+} // namespace std
+
 #endif // UXR_AGENT_TRANSPORT_ENDPOINT_IPV4_ENDPOINT_HPP_
@@ -16,6 +16,7 @@
 #define UXR_AGENT_TRANSPORT_ENDPOINT_IPV6_ENDPOINT_HPP_
 
 #include <stdint.h>
+#include <functional>
 #include <iostream>
 #include <iomanip>
 #include <array>
@@ -37,6 +38,11 @@ public:
 
     ~IPv6EndPoint() = default;
 
+    bool operator==(const IPv6EndPoint& other) const
+    {
+        return (addr_ == other.addr_) && (port_ == other.port_);
+    }
+
     bool operator<(const IPv6EndPoint& other) const
     {
         return (addr_ < other.addr_) || ((addr_ == other.addr_) && (port_ < other.port_));
@@ -83,4 +89,25 @@ private:
 } // namespace uxr
 } // namespace eprosima
 
+namespace std {
+
+template<>
+struct hash<eprosima::uxr::IPv6EndPoint>
+{
+    size_t operator()(const eprosima::uxr::IPv6EndPoint& endpoint) const
+    {
+        /* FNV-1a over the address and the port. */
+        uint64_t rv = UINT64_C(0xCBF29CE484222325);
+        for (uint8_t byte : endpoint.get_addr())
+        {
+            rv = (rv ^ byte) * UINT64_C(0x100000001B3);
+        }
+        rv = (rv ^ uint8_t(endpoint.get_port())) * UINT64_C(0x100000001B3);
+        rv = (rv ^ uint8_t(endpoint.get_port() >> 8)) * UINT64_C(0x100000001B3);
+        return size_t(rv);
+    }
+};
+
+} // namespace std
+
 #endif // UXR_AGENT_TRANSPORT_ENDPOINT_IPV6_ENDPOINT_HPP_
@@ -16,6 +16,7 @@
 #define _UXR_AGENT_TRANSPORT_MULTISERIAL_ENDPOINT_HPP_
 
 #include <stdint.h>
+#include <functional>
 
 namespace eprosima {
 namespace uxr {
@@ -33,6 +34,11 @@ public:
 
     ~MultiSerialEndPoint() {}
 
+    bool operator==(const MultiSerialEndPoint& other) const
+    {
+        return (fd_ == other.fd_);
+    }
+
     bool operator<(const MultiSerialEndPoint& other) const
     {
         return (fd_ < other.fd_);
@@ -55,4 +61,17 @@ private:
 } // namespace uxr
 } // namespace eprosima
 
+namespace std {
+
+template<>
+struct hash<eprosima::uxr::MultiSerialEndPoint>
+{
+    size_t operator()(const eprosima::uxr::MultiSerialEndPoint& endpoint) const
+    {
+        return std::hash<int>{}(endpoint.get_fd());
+    }
+};
+
+} // namespace std
+
 #endif //_UXR_AGENT_TRANSPORT_SERIAL_ENDPOINT_HPP_
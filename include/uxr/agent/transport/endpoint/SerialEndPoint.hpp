@@ -16,6 +16,7 @@
 #define _UXR_AGENT_TRANSPORT_SERIAL_ENDPOINT_HPP_
 
 #include <stdint.h>
+#include <functional>
 
 namespace eprosima {
 namespace uxr {
@@ -32,6 +33,11 @@ public:
 
     ~SerialEndPoint() {}
 
+    bool operator==(const SerialEndPoint& other) const
+    {
+        return (addr_ == other.addr_);
+    }
+
     bool operator<(const SerialEndPoint& other) const
     {
         return (addr_ < other.addr_);
@@ -52,4 +58,17 @@ private:
 } // namespace uxr
 } // namespace eprosima
 
+namespace std {
+
+template<>
+struct hash<eprosima::uxr::SerialEndPoint>
+{
+    size_t operator()(const eprosima::uxr::SerialEndPoint& endpoint) const
+    {
+        return std::hash<uint8_t>{}(endpoint.get_addr());
+    }
+};
+
+} // namespace std
+
 #endif //_UXR_AGENT_TRANSPORT_SERIAL_ENDPOINT_HPP_
@@ -74,6 +74,8 @@ private:
     static constexpr uint8_t framing_esc_flag = 0x7D;
     static constexpr uint8_t framing_xor_flag = 0x20;
 
+    static constexpr size_t framing_buffer_size = 1024;
+
     /**
      * @brief Possible states for the framing protocol.
      */
@@ -163,6 +165,45 @@ private:
             uint16_t& crc,
             const uint8_t data);
 
+    /**
+     * @brief Static method to update CRC with a block of data, eight octets at a time (slicing-by-8).
+     * @param crc CRC code to be updated.
+     * @param data New data to be loaded into the CRC code.
+     * @param len Length of the data.
+     */
+    static void update_crc(
+            uint16_t& crc,
+            const uint8_t* data,
+            size_t len);
+
+    /**
+     * @brief Finds the first octet which has to be escaped, that is, a begin or an escape flag.
+     * @return Pointer to that octet, or end if there is none.
+     */
+    static const uint8_t* find_flag(
+            const uint8_t* begin,
+            const uint8_t* end);
+
+    /**
+     * @brief Copies the octets at the beginning of the read buffer which need no unescaping.
+     * @param buf Buffer to copy the octets into.
+     * @param len Maximum number of octets to copy.
+     * @return Number of octets copied.
+     */
+    size_t get_next_octets(
+            uint8_t* buf,
+            size_t len);
+
+    /**
+     * @brief Copies into the write buffer the octets at the beginning of the data which need no escaping.
+     * @param buf Data to be written.
+     * @param len Length of the data.
+     * @return Number of octets copied.
+     */
+    size_t add_next_octets(
+            const uint8_t* buf,
+            size_t len);
+
     /**
      * @brief Get next octet from the read buffer.
      * @param octet Octet to which the data will be written.
@@ -203,9 +244,9 @@ private:
     uint8_t local_addr_;
     uint8_t remote_addr_;
 
-    uint8_t read_buffer_[42];
-    uint8_t read_buffer_head_;
-    uint8_t read_buffer_tail_;
+    uint8_t read_buffer_[framing_buffer_size];
+    size_t read_buffer_head_;
+    size_t read_buffer_tail_;
 
     ReadCallback read_callback_;
 
@@ -214,8 +255,8 @@ private:
     uint16_t msg_crc_;
     uint16_t cmp_crc_;
 
-    uint8_t write_buffer_[42];
-    uint8_t write_buffer_pos_;
+    uint8_t write_buffer_[framing_buffer_size];
+    size_t write_buffer_pos_;
 
     WriteCallback write_callback_;
 };
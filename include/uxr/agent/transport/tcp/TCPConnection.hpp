@@ -19,28 +19,22 @@
 #include <uxr/agent/transport/endpoint/IPv6EndPoint.hpp>
 
 #include <stdint.h>
+#include <stddef.h>
 #include <vector>
 #include <mutex>
 
 namespace eprosima {
 namespace uxr {
 
-typedef enum TCPInputBufferState
-{
-    TCP_BUFFER_EMPTY,
-    TCP_SIZE_INCOMPLETE,
-    TCP_SIZE_READ,
-    TCP_MESSAGE_INCOMPLETE,
-    TCP_MESSAGE_AVAILABLE
-
-} TCPInputBufferState;
-
+/**
+ * @brief Receive buffer of a connection. Bytes in [head, tail) have been received but not consumed
+ *        yet, they hold the complete messages pending to be carved and the beginning of the next one.
+ */
 struct TCPInputBuffer
 {
     std::vector<uint8_t> buffer;
-    uint16_t position;
-    TCPInputBufferState state;
-    uint16_t msg_size;
+    size_t head;
+    size_t tail;
 };
 
 struct TCPConnection
@@ -17,9 +17,12 @@
 
 #include <uxr/agent/transport/tcp/TCPConnection.hpp>
 #include <uxr/agent/transport/TransportRc.hpp>
+#include <uxr/agent/config.hpp>
 
+#include <algorithm>
 #include <cstdint>
 #include <cstddef>
+#include <cstring>
 
 namespace eprosima {
 namespace uxr {
@@ -41,120 +44,92 @@ private:
             TransportRc& transport_rc) = 0;
 
 protected:
-    uint16_t read_data(
+    /**
+     * @brief Receives as many bytes as the connection has available with a single recv_data call.
+     *        The complete messages received are then taken out with next_message.
+     * @return  The number of bytes received.
+     */
+    size_t read_data(
             Connection& connection,
             TransportRc& transport_rc);
+
+    /**
+     * @brief Carves the next complete length-prefixed message out of the connection receive buffer.
+     *        The message points into that buffer, so it is only valid until the next read_data call.
+     * @return  false if the receive buffer does not hold a complete message.
+     */
+    bool next_message(
+            Connection& connection,
+            const uint8_t*& message,
+            uint16_t& message_len);
 };
 
 template<typename Connection>
-inline uint16_t TCPServerBase<Connection>::read_data(
+inline size_t TCPServerBase<Connection>::read_data(
         Connection& connection,
         TransportRc& transport_rc)
 {
-    uint16_t rv = 0;
-    bool exit_flag = false;
-    transport_rc = TransportRc::ok;
+    TCPInputBuffer& input_buffer = connection.input_buffer;
+
+    /* Move the beginning of the next message to the front, messages are never split across the end. */
+    if (0 < input_buffer.head)
+    {
+        std::memmove(
+            input_buffer.buffer.data(),
+            input_buffer.buffer.data() + input_buffer.head,
+            input_buffer.tail - input_buffer.head);
+        input_buffer.tail -= input_buffer.head;
+        input_buffer.head = 0;
+    }
 
-    do
+    /* Make room for the whole message once its length prefix is known. */
+    size_t required_size = TCP_RECV_BUFFER_SIZE;
+    if (2 <= input_buffer.tail)
     {
-        switch (connection.input_buffer.state)
+        size_t msg_size = size_t((uint16_t(input_buffer.buffer[1]) << 8) | input_buffer.buffer[0]);
+        required_size = (std::max)(required_size, msg_size + 2);
+    }
+    if (input_buffer.buffer.size() < required_size)
+    {
+        input_buffer.buffer.resize(required_size);
+    }
+
+    size_t bytes_received =
+            recv_data(connection,
+                      input_buffer.buffer.data() + input_buffer.tail,
+                      input_buffer.buffer.size() - input_buffer.tail,
+                      transport_rc);
+    input_buffer.tail += bytes_received;
+    return bytes_received;
+}
+
+template<typename Connection>
+inline bool TCPServerBase<Connection>::next_message(
+        Connection& connection,
+        const uint8_t*& message,
+        uint16_t& message_len)
+{
+    bool rv = false;
+    TCPInputBuffer& input_buffer = connection.input_buffer;
+
+    while (!rv && (2 <= (input_buffer.tail - input_buffer.head)))
+    {
+        const uint8_t* msg_size_buf = input_buffer.buffer.data() + input_buffer.head;
+        uint16_t msg_size = uint16_t((uint16_t(msg_size_buf[1]) << 8) | msg_size_buf[0]);
+        if ((size_t(msg_size) + 2) > (input_buffer.tail - input_buffer.head))
         {
-            case TCP_BUFFER_EMPTY:
-            {
-                connection.input_buffer.position = 0;
-                uint8_t size_buf[2];
-                size_t bytes_received = recv_data(connection, size_buf, 2, transport_rc);
-                if (0 < bytes_received)
-                {
-                    connection.input_buffer.msg_size = 0;
-                    if (2 == bytes_received)
-                    {
-                        connection.input_buffer.msg_size = uint16_t((uint16_t(size_buf[1]) << 8) | size_buf[0]);
-                        if (connection.input_buffer.msg_size != 0)
-                        {
-                            connection.input_buffer.state = TCP_SIZE_READ;
-                        }
-                    }
-                    else
-                    {
-                        connection.input_buffer.msg_size = uint16_t(size_buf[0]);
-                        connection.input_buffer.state = TCP_SIZE_INCOMPLETE;
-                    }
-                }
-                break;
-            }
-            case TCP_SIZE_INCOMPLETE:
-            {
-                uint8_t size_msb;
-                size_t bytes_received = recv_data(connection, &size_msb, 1, transport_rc);
-                if (0 < bytes_received)
-                {
-                    connection.input_buffer.msg_size = uint16_t((uint16_t(size_msb) << 8) | connection.input_buffer.msg_size);
-                    if (connection.input_buffer.msg_size != 0)
-                    {
-                        connection.input_buffer.state = TCP_SIZE_READ;
-                    }
-                    else
-                    {
-                        connection.input_buffer.state = TCP_BUFFER_EMPTY;
-                    }
-                }
-                break;
-            }
-            case TCP_SIZE_READ:
-            {
-                connection.input_buffer.buffer.resize(connection.input_buffer.msg_size);
-                size_t bytes_received =
-                        recv_data(connection,
-                                  connection.input_buffer.buffer.data(),
-                                  connection.input_buffer.buffer.size(),
-                                  transport_rc);
-                if (0 < bytes_received)
-                {
-                    if (uint16_t(bytes_received) == connection.input_buffer.msg_size)
-                    {
-                        connection.input_buffer.state = TCP_MESSAGE_AVAILABLE;
-                    }
-                    else
-                    {
-                        connection.input_buffer.position = uint16_t(bytes_received);
-                        connection.input_buffer.state = TCP_MESSAGE_INCOMPLETE;
-                        exit_flag = true;
-                    }
-                }
-                break;
-            }
-            case TCP_MESSAGE_INCOMPLETE:
-            {
-                size_t bytes_received =
-                        recv_data(connection,
-                                  connection.input_buffer.buffer.data() + connection.input_buffer.position,
-                                  connection.input_buffer.buffer.size() - connection.input_buffer.position,
-                                  transport_rc);
-                if (0 < bytes_received)
-                {
-                    connection.input_buffer.position += uint16_t(bytes_received);
-                    if (connection.input_buffer.position == connection.input_buffer.msg_size)
-                    {
-                        connection.input_buffer.state = TCP_MESSAGE_AVAILABLE;
-                    }
-                    else
-                    {
-                        exit_flag = true;
-                    }
-                }
-                break;
-            }
-            case TCP_MESSAGE_AVAILABLE:
-            {
-                rv = connection.input_buffer.msg_size;
-                connection.input_buffer.state = TCP_BUFFER_EMPTY;
-                exit_flag = true;
-                break;
-            }
+            break;
         }
-    } while(!exit_flag && (TransportRc::ok == transport_rc));
 
+        /* Empty messages are skipped. */
+        input_buffer.head += size_t(msg_size) + 2;
+        if (0 != msg_size)
+        {
+            message = msg_size_buf + 2;
+            message_len = msg_size;
+            rv = true;
+        }
+    }
     return rv;
 }
 
@@ -22,18 +22,25 @@
 #endif
 
 #include <netinet/in.h>
+#include <sys/uio.h>
+#ifdef __APPLE__
 #include <sys/poll.h>
+#else
+#include <sys/epoll.h>
+#endif
 #include <array>
 #include <list>
+#include <memory>
 #include <set>
 #include <queue>
+#include <vector>
 
 namespace eprosima {
 namespace uxr {
 
 struct TCPv6ConnectionLinux : public TCPv6Connection
 {
-    struct pollfd* poll_fd;
+    int fd;
 };
 
 extern template class Server<IPv6EndPoint>;
@@ -82,6 +89,20 @@ private:
             OutputPacket<IPv6EndPoint> output_packet,
             TransportRc& transport_rc) final;
 
+    bool recv_message(
+            std::vector<InputPacket<IPv6EndPoint>>& input_packets,
+            int timeout,
+            TransportRc& transport_rc) final;
+
+    /**
+     * @brief Writes the packets queued for the same connection with a single writev,
+     *        each one as its length prefix followed by its payload.
+     */
+    bool send_message(
+            std::vector<OutputPacket<IPv6EndPoint>>& output_packets,
+            size_t shard_id,
+            TransportRc& transport_rc) final;
+
     bool handle_error(
             TransportRc transport_rc) final;
 
@@ -89,6 +110,18 @@ private:
             int timeout,
             TransportRc& transport_rc);
 
+    bool read_connection(
+            TCPv6ConnectionLinux& connection,
+            TransportRc& transport_rc);
+
+    bool write_connection(
+            TCPv6ConnectionLinux& connection,
+            const OutputPacket<IPv6EndPoint>* const* output_packets,
+            size_t count,
+            TransportRc& transport_rc);
+
+    void accept_connections();
+
     bool open_connection(
             int fd,
             struct sockaddr_in6& sockaddr);
@@ -96,10 +129,6 @@ private:
     bool close_connection(
             TCPv6ConnectionLinux& connection);
 
-    bool connection_available();
-
-    void listener_loop();
-
     static void init_input_buffer(
             TCPInputBuffer& buffer);
 
@@ -118,18 +147,23 @@ private:
             TransportRc& transport_rc) final;
 
 private:
-    std::array<TCPv6ConnectionLinux, TCP_MAX_CONNECTIONS> connections_;
+    std::vector<std::unique_ptr<TCPv6ConnectionLinux>> connections_;
     std::set<uint32_t> active_connections_;
     std::list<uint32_t> free_connections_;
     std::map<IPv6EndPoint, uint32_t> endpoint_to_connection_map_;
     std::mutex connections_mtx_;
-    struct pollfd listener_poll_;
-    std::array<struct pollfd, TCP_MAX_CONNECTIONS> poll_fds_;
+    int listener_fd_;
+#ifdef __APPLE__
+    std::vector<struct pollfd> poll_fds_;
+#else
+    int epoll_fd_;
+    std::vector<struct epoll_event> epoll_events_;
+#endif
     uint8_t buffer_[SERVER_BUFFER_SIZE];
     uint16_t agent_port_;
-    std::thread listener_thread_;
-    std::atomic<bool> running_cond_;
     std::queue<InputPacket<IPv6EndPoint>> messages_queue_;
+    std::vector<uint8_t> send_size_bufs_;
+    std::vector<struct iovec> send_iovecs_;
 #ifdef UAGENT_DISCOVERY_PROFILE
     DiscoveryServerLinux<IPv6EndPoint> discovery_server_;
 #endif
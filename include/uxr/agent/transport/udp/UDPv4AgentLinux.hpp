@@ -27,7 +27,11 @@
 #include <cstdint>
 #include <cstddef>
 #include <sys/poll.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
 #include <unordered_map>
+#include <vector>
+#include <memory>
 
 namespace eprosima {
 namespace uxr {
@@ -51,6 +55,10 @@ public:
     bool has_p2p() final { return true; }
 #endif
 
+#ifndef __APPLE__
+    bool has_sharding() final { return true; }
+#endif
+
 private:
     bool init() final;
 
@@ -77,13 +85,53 @@ private:
             OutputPacket<IPv4EndPoint> output_packet,
             TransportRc& transport_rc) final;
 
+#ifndef __APPLE__
+    bool recv_message(
+            std::vector<InputPacket<IPv4EndPoint>>& input_packets,
+            size_t shard_id,
+            int timeout,
+            TransportRc& transport_rc) final;
+
+    bool send_message(
+            std::vector<OutputPacket<IPv4EndPoint>>& output_packets,
+            size_t shard_id,
+            TransportRc& transport_rc) final;
+#endif
+
     bool handle_error(
             TransportRc transport_rc) final;
 
+    bool handle_error(
+            TransportRc transport_rc,
+            size_t shard_id) final;
+
 private:
-    struct pollfd poll_fd_;
+#ifndef __APPLE__
+    struct BatchBuffers
+    {
+        std::vector<MessageBuffer> recv_blocks;
+        std::vector<uint8_t> recv_tails;
+        std::vector<struct iovec> recv_iovecs;
+        std::vector<struct sockaddr_in> recv_addrs;
+        std::vector<struct mmsghdr> recv_msgs;
+        std::vector<struct iovec> send_iovecs;
+        std::vector<struct sockaddr_in> send_addrs;
+        std::vector<struct mmsghdr> send_msgs;
+    };
+
+    void init_batch_buffers();
+#endif
+
+    bool open_socket(size_t shard_id);
+
+    bool close_socket(size_t shard_id);
+
+    std::vector<struct pollfd> poll_fds_;
     uint8_t buffer_[SERVER_BUFFER_SIZE];
     uint16_t agent_port_;
+#ifndef __APPLE__
+    std::vector<std::unique_ptr<BatchBuffers>> batch_buffers_;
+#endif
 #ifdef UAGENT_DISCOVERY_PROFILE
     DiscoveryServerLinux<IPv4EndPoint> discovery_server_;
 #endif
@@ -0,0 +1,129 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UXR_AGENT_TYPES_DATA_PAYLOAD_VIEW_HPP_
+#define UXR_AGENT_TYPES_DATA_PAYLOAD_VIEW_HPP_
+
+#include <uxr/agent/types/XRCETypes.hpp>
+
+#include <fastcdr/Cdr.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace eprosima {
+namespace uxr {
+
+/**
+ * @brief DATA payload in FORMAT_DATA that refers to a sample instead of owning it, so the sample is serialized
+ *        straight into the output messages. It serializes as dds::xrce::DATA_Payload_Data.
+ *        The sample shall outlive the view.
+ */
+class DataPayloadView
+{
+public:
+    DataPayloadView(
+            const dds::xrce::RequestId& request_id,
+            const dds::xrce::ObjectId& object_id,
+            const uint8_t* data,
+            size_t size)
+        : base_{}
+        , data_{data}
+        , size_{size}
+    {
+        base_.request_id(request_id);
+        base_.object_id(object_id);
+    }
+
+    size_t getCdrSerializedSize(
+            size_t current_alignment = 0) const
+    {
+        return base_.getCdrSerializedSize(current_alignment) + size_;
+    }
+
+    void serialize(
+            fastcdr::Cdr& scdr) const
+    {
+        serialize_head(scdr);
+        scdr.serializeArray(data_, size_);
+    }
+
+    /**
+     * @brief Serializes everything but the sample, which follows it in the serialized payload.
+     */
+    void serialize_head(
+            fastcdr::Cdr& scdr) const
+    {
+        base_.serialize(scdr);
+    }
+
+    const uint8_t* data() const { return data_; }
+
+    size_t size() const { return size_; }
+
+private:
+    dds::xrce::BaseObjectRequest base_;
+    const uint8_t* data_;
+    size_t size_;
+};
+
+/**
+ * @brief DATA payload in FORMAT_DATA_SEQ that refers to the samples instead of owning them.
+ *        It serializes as dds::xrce::DATA_Payload_DataSeq. The samples shall outlive the view.
+ */
+class DataSeqPayloadView
+{
+public:
+    DataSeqPayloadView(
+            const dds::xrce::RequestId& request_id,
+            const dds::xrce::ObjectId& object_id,
+            const dds::xrce::SampleDataSeq& samples)
+        : base_{}
+        , samples_(samples)
+    {
+        base_.request_id(request_id);
+        base_.object_id(object_id);
+    }
+
+    size_t getCdrSerializedSize(
+            size_t current_alignment = 0) const
+    {
+        size_t initial_alignment = current_alignment;
+
+        current_alignment += base_.getCdrSerializedSize(current_alignment);
+        current_alignment += 4 + fastcdr::Cdr::alignment(current_alignment, 4);
+        for (const auto& sample : samples_)
+        {
+            current_alignment += sample.getCdrSerializedSize(current_alignment);
+        }
+
+        return current_alignment - initial_alignment;
+    }
+
+    void serialize(
+            fastcdr::Cdr& scdr) const
+    {
+        base_.serialize(scdr);
+        scdr << samples_;
+    }
+
+private:
+    dds::xrce::BaseObjectRequest base_;
+    const dds::xrce::SampleDataSeq& samples_;
+};
+
+} // namespace uxr
+} // namespace eprosima
+
+#endif // UXR_AGENT_TYPES_DATA_PAYLOAD_VIEW_HPP_
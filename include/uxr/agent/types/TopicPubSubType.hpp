@@ -23,10 +23,78 @@ using namespace eprosima::fastrtps;
 namespace eprosima {
 namespace uxr {
 
+/**
+ * @brief Type of the topics, whose samples are already serialized by the clients.
+ *        Every sample handed to or taken from it is a TopicPubSubType::Sample, the type createData returns.
+ */
 class TopicPubSubType: public TopicDataType
 {
 public:
-    typedef std::vector<unsigned char> type;
+    /**
+     * @brief Sample of the type. Samples to be written may point at data owned by the caller, which is
+     *        copied only once, straight into the payload. Deserialized samples hold their data in buffer.
+     */
+    class Sample
+    {
+    public:
+        Sample()
+            : data_(nullptr)
+            , size_(0)
+            , buffer_{}
+        {}
+
+        Sample(
+                const unsigned char* data,
+                size_t size)
+            : data_(data)
+            , size_(size)
+            , buffer_{}
+        {}
+
+        Sample(Sample&&) = delete;
+        Sample(const Sample&) = delete;
+        Sample& operator=(Sample&&) = delete;
+        Sample& operator=(const Sample&) = delete;
+
+        const unsigned char* data() const { return data_; }
+
+        size_t size() const { return size_; }
+
+        /**
+         * @brief Copies the data into the buffer of the sample, which points at it from then on.
+         */
+        void assign(
+                const unsigned char* begin,
+                const unsigned char* end)
+        {
+            buffer_.assign(begin, end);
+            data_ = buffer_.data();
+            size_ = buffer_.size();
+        }
+
+        /**
+         * @brief Moves the data out of the buffer, leaving the sample empty.
+         */
+        void take(
+                std::vector<unsigned char>& data)
+        {
+            if (buffer_.data() != data_)
+            {
+                buffer_.assign(data_, data_ + size_);
+            }
+            data = std::move(buffer_);
+            buffer_.clear();
+            data_ = nullptr;
+            size_ = 0;
+        }
+
+    private:
+        const unsigned char* data_;
+        size_t size_;
+        std::vector<unsigned char> buffer_;
+    };
+
+    typedef Sample type;
 
     explicit TopicPubSubType(bool with_key);
     ~TopicPubSubType() override = default;
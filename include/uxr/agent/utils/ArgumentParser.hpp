@@ -469,6 +469,17 @@ public:
         , refs_("-r", "--refs")
         , verbose_("-v", "--verbose", static_cast<uint16_t>(DEFAULT_VERBOSE_LEVEL),
             {0, 1, 2, 3, 4, 5, 6})
+        , workers_("-w", "--workers", static_cast<uint16_t>(0), {}, false)
+        , reliable_depth_("-R", "--reliable-depth", RELIABLE_STREAM_DEPTH, {}, false)
+        , best_effort_depth_("-B", "--best-effort-depth", BEST_EFFORT_STREAM_DEPTH, {}, false)
+        , adaptive_window_("-A", "--adaptive-window", static_cast<uint16_t>(0), {}, false)
+        , flush_timeout_("-F", "--flush-timeout", static_cast<uint32_t>(0), {}, false)
+        , metrics_file_("-M", "--metrics-file")
+        , metrics_period_("-T", "--metrics-period", static_cast<uint32_t>(1000), {}, false)
+#ifdef UAGENT_LOGGER_PROFILE
+        , async_log_("-a", "--async-log", ArgumentKind::NO_VALUE)
+        , log_file_("-l", "--log-file")
+#endif
 #ifdef UAGENT_DISCOVERY_PROFILE
         , discovery_("-d", "--discovery", static_cast<uint16_t>(DEFAULT_DISCOVERY_PORT), {}, false)
 #endif
@@ -528,6 +539,29 @@ public:
             result.first = false;
             return result;
         }
+        if (ParseResult::INVALID == workers_.parse_argument(argc, argv))
+        {
+            result.first = false;
+            return result;
+        }
+        if ((ParseResult::INVALID == reliable_depth_.parse_argument(argc, argv)) ||
+            (ParseResult::INVALID == best_effort_depth_.parse_argument(argc, argv)) ||
+            (ParseResult::INVALID == adaptive_window_.parse_argument(argc, argv)) ||
+            (ParseResult::INVALID == flush_timeout_.parse_argument(argc, argv)) ||
+            (ParseResult::INVALID == metrics_file_.parse_argument(argc, argv)) ||
+            (ParseResult::INVALID == metrics_period_.parse_argument(argc, argv)))
+        {
+            result.first = false;
+            return result;
+        }
+#ifdef UAGENT_LOGGER_PROFILE
+        if ((ParseResult::INVALID == async_log_.parse_argument(argc, argv)) ||
+            (ParseResult::INVALID == log_file_.parse_argument(argc, argv)))
+        {
+            result.first = false;
+            return result;
+        }
+#endif
 #ifdef UAGENT_DISCOVERY_PROFILE
         if (ParseResult::INVALID == discovery_.parse_argument(argc, argv))
         {
@@ -545,6 +579,40 @@ public:
         return result;
     }
 
+    void apply_settings(
+            std::unique_ptr<AgentType>& server)
+    {
+        if (workers_.found())
+        {
+            server->set_processing_workers(workers_.value());
+        }
+        if (reliable_depth_.found() || best_effort_depth_.found() || adaptive_window_.found())
+        {
+            if (!server->set_stream_depth(
+                    reliable_depth_.value(), best_effort_depth_.value(), adaptive_window_.value()))
+            {
+                UXR_AGENT_LOG_WARN(
+                        UXR_DECORATE_YELLOW("Stream depth error"),
+                        "Depths shall be between 1 and {}",
+                        MAX_STREAM_DEPTH);
+            }
+        }
+        if (flush_timeout_.found())
+        {
+            if (!server->set_flush_timeout(std::chrono::microseconds(flush_timeout_.value())))
+            {
+                UXR_AGENT_LOG_WARN(
+                        UXR_DECORATE_YELLOW("Flush timeout error"),
+                        "Timeout shall not exceed {} us",
+                        MAX_FLUSH_TIMEOUT.count());
+            }
+        }
+        if (metrics_file_.found())
+        {
+            server->enable_metrics_dump(metrics_file_.value(), std::chrono::milliseconds(metrics_period_.value()));
+        }
+    }
+
     void apply_actions(
             std::unique_ptr<AgentType>& server)
     {
@@ -588,6 +656,18 @@ public:
         {
             server->set_verbose_level(verbose_.value());
         }
+#ifdef UAGENT_LOGGER_PROFILE
+        if (async_log_.found() || log_file_.found())
+        {
+            if (!server->enable_async_logging(log_file_.found() ? log_file_.value() : std::string()))
+            {
+                UXR_AGENT_LOG_WARN(
+                        UXR_DECORATE_YELLOW("Async logging error"),
+                        "Cannot enable it, log file: '{}'",
+                        log_file_.value());
+            }
+        }
+#endif
     }
 
     const std::string get_help() const
@@ -597,6 +677,17 @@ public:
         ss << "    " << middleware_.get_help() << std::endl;
         ss << "    " << refs_.get_help() << std::endl;
         ss << "    " << verbose_.get_help() << std::endl;
+        ss << "    " << workers_.get_help() << std::endl;
+        ss << "    " << reliable_depth_.get_help() << std::endl;
+        ss << "    " << best_effort_depth_.get_help() << std::endl;
+        ss << "    " << adaptive_window_.get_help() << std::endl;
+        ss << "    " << flush_timeout_.get_help() << std::endl;
+        ss << "    " << metrics_file_.get_help() << std::endl;
+        ss << "    " << metrics_period_.get_help() << std::endl;
+#ifdef UAGENT_LOGGER_PROFILE
+        ss << "    " << async_log_.get_help() << std::endl;
+        ss << "    " << log_file_.get_help() << std::endl;
+#endif
 #ifdef UAGENT_DISCOVERY_PROFILE
         ss << "    " << discovery_.get_help() << std::endl;
 #endif
@@ -611,6 +702,17 @@ private:
     Argument<std::string> middleware_;
     Argument<std::string> refs_;
     Argument<uint8_t> verbose_;
+    Argument<uint16_t> workers_;
+    Argument<uint16_t> reliable_depth_;
+    Argument<uint16_t> best_effort_depth_;
+    Argument<uint16_t> adaptive_window_;
+    Argument<uint32_t> flush_timeout_;
+    Argument<std::string> metrics_file_;
+    Argument<uint32_t> metrics_period_;
+#ifdef UAGENT_LOGGER_PROFILE
+    Argument<dummy_type> async_log_;
+    Argument<std::string> log_file_;
+#endif
 #ifdef UAGENT_DISCOVERY_PROFILE
     Argument<uint16_t> discovery_;
 #endif
@@ -628,6 +730,7 @@ class IPvXArgs
 public:
     IPvXArgs()
         : port_("-p", "--port")
+        , shards_("-s", "--shards", static_cast<uint16_t>(1), {}, false)
     {
     }
 
@@ -640,6 +743,10 @@ public:
         {
             std::cerr << "Warning: '--port <value>' is required" << std::endl;
         }
+        if (ParseResult::INVALID == shards_.parse_argument(argc, argv))
+        {
+            return false;
+        }
         return (ParseResult::VALID == parse_port ? true : false);
     }
 
@@ -648,15 +755,29 @@ public:
         return port_.value();
     }
 
+    void apply_actions(
+            std::unique_ptr<AgentType>& server)
+    {
+        if (shards_.found() && !server->set_shards(shards_.value()))
+        {
+            UXR_AGENT_LOG_WARN(
+                    UXR_DECORATE_YELLOW("Sharding error"),
+                    "Not supported on selected transport",
+                    "");
+        }
+    }
+
     const std::string get_help() const
     {
         std::stringstream ss;
         ss << "    " << port_.get_help() << std::endl;
+        ss << "    " << shards_.get_help() << std::endl;
         return ss.str();
     }
 
 private:
     Argument<uint16_t> port_;
+    Argument<uint16_t> shards_;
 };
 
 #ifndef _WIN32
@@ -1016,6 +1137,8 @@ public:
     bool launch_agent()
     {
         agent_server_.reset(new AgentType(ip_args_.port(), utils::get_mw_kind(common_args_.middleware())));
+        common_args_.apply_settings(agent_server_);
+        ip_args_.apply_actions(agent_server_);
         if (agent_server_->start())
         {
             common_args_.apply_actions(agent_server_);
@@ -1126,6 +1249,7 @@ template<> inline bool ArgumentParser<TermiosAgent>::launch_agent()
     
     agent_server_.reset(new TermiosAgent(
         serial_args_.dev().c_str(),  O_RDWR | O_NOCTTY, attr, 0, utils::get_mw_kind(common_args_.middleware())));
+    common_args_.apply_settings(agent_server_);
 
     if (agent_server_->start())
     {
@@ -1146,6 +1270,7 @@ template<> inline bool ArgumentParser<MultiTermiosAgent>::launch_agent()
 
     agent_server_.reset(new MultiTermiosAgent(
         multiserial_args_.devs(),  O_RDWR | O_NOCTTY, attr, 0, utils::get_mw_kind(common_args_.middleware())));
+    common_args_.apply_settings(agent_server_);
 
     if (agent_server_->start())
     {
@@ -1164,6 +1289,7 @@ template<> inline bool ArgumentParser<PseudoTerminalAgent>::launch_agent()
 {
     agent_server_.reset(new PseudoTerminalAgent(
             O_RDWR | O_NOCTTY, pseudoterminal_args_.baud_rate().c_str(), 0, utils::get_mw_kind(common_args_.middleware())));
+    common_args_.apply_settings(agent_server_);
     if (agent_server_->start())
     {
         common_args_.apply_actions(agent_server_);
@@ -1183,6 +1309,7 @@ template<> inline bool ArgumentParser<CanAgent>::launch_agent()
     uint32_t can_id = strtoul(can_args_.can_id().c_str(), NULL, 16);
     agent_server_.reset(new CanAgent(
             can_args_.dev().c_str(), can_id, utils::get_mw_kind(common_args_.middleware())));
+    common_args_.apply_settings(agent_server_);
     if (agent_server_->start())
     {
         common_args_.apply_actions(agent_server_);
@@ -15,14 +15,29 @@
 #ifndef _UXR_AGENT_UTILS_FUNCTIONS_HPP_
 #define _UXR_AGENT_UTILS_FUNCTIONS_HPP_
 
+#include <cstddef>
+#include <cstdint>
+
 namespace eprosima {
 namespace uxr {
 
+constexpr size_t CACHE_LINE_SIZE = 64;
+
 template<typename T> constexpr const T& max_mtu(const T& fe, const T& se)
 {
   return fe > se ? fe : se;
 }
 
+/**
+ * @brief Fibonacci hashing: the top bits of the key multiplied by 2^64 / phi. Consecutive keys, and the
+ *        identity std::hash of integers, end up spread over every shard or worker.
+ * @param bits Number of bits of the result, between 1 and 32.
+ */
+inline uint32_t fibonacci_hash(uint64_t key, uint32_t bits)
+{
+  return uint32_t((key * UINT64_C(0x9E3779B97F4A7C15)) >> (64 - bits));
+}
+
 }
 }
 
@@ -0,0 +1,340 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UXR_AGENT_UTILS_SNAPSHOT_MAP_HPP_
+#define UXR_AGENT_UTILS_SNAPSHOT_MAP_HPP_
+
+#include <uxr/agent/utils/Functions.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace eprosima {
+namespace uxr {
+namespace utils {
+
+/**
+ * @brief Read-mostly hash map. Entries are spread over shards, and each shard publishes an immutable
+ *        unordered_map through an atomic pointer. Lookups only load that pointer inside a read section,
+ *        which announces the reader on one of two counters of the shard, so they are lock-free and lookups
+ *        on different shards share no memory. Modifications copy the map of their shard under the shard
+ *        mutex, publish the copy and free the previous map once the readers which may hold it have left,
+ *        flipping the epoch of the shard twice so that both counters drain.
+ */
+template<class Key, class Value, class Hash = std::hash<Key>>
+class SnapshotMap
+{
+public:
+    SnapshotMap()
+        : storage_{new uint8_t[(shard_count * sizeof(Shard)) + CACHE_LINE_SIZE]}
+        , shards_{nullptr}
+    {
+        void* base = storage_.get();
+        size_t space = (shard_count * sizeof(Shard)) + CACHE_LINE_SIZE;
+        shards_ = static_cast<Shard*>(std::align(CACHE_LINE_SIZE, shard_count * sizeof(Shard), base, space));
+        for (size_t i = 0; i < shard_count; ++i)
+        {
+            Shard& shard = *new (shards_ + i) Shard();
+            shard.entries.store(new Map());
+            shard.epoch.store(0);
+            shard.readers[0].store(0);
+            shard.readers[1].store(0);
+        }
+    }
+
+    ~SnapshotMap()
+    {
+        for (size_t i = 0; i < shard_count; ++i)
+        {
+            delete shards_[i].entries.load();
+            shards_[i].~Shard();
+        }
+    }
+
+    SnapshotMap(SnapshotMap&&) = delete;
+    SnapshotMap(const SnapshotMap&) = delete;
+    SnapshotMap& operator=(SnapshotMap&&) = delete;
+    SnapshotMap& operator=(const SnapshotMap&) = delete;
+
+    bool find(
+            const Key& key,
+            Value& value) const
+    {
+        bool rv = false;
+        ReadSection section(get_shard(key));
+        const Map* entries = section.entries();
+        auto it = entries->find(key);
+        if (it != entries->end())
+        {
+            value = it->second;
+            rv = true;
+        }
+        return rv;
+    }
+
+    /**
+     * @return true if the key was not in the map.
+     */
+    bool insert_or_assign(
+            const Key& key,
+            const Value& value)
+    {
+        bool rv = false;
+        Shard& shard = get_shard(key);
+        std::lock_guard<std::mutex> lock(shard.mtx);
+        modify(shard, [&](Map& entries)
+        {
+            auto res = entries.emplace(key, value);
+            if (!res.second)
+            {
+                res.first->second = value;
+            }
+            rv = res.second;
+        });
+        return rv;
+    }
+
+    /**
+     * @brief Calls update(current, value) under the mutex of the shard of the key, where current points at
+     *        the value of the key or is null if it is not in the map. The key is assigned the value set by
+     *        update only if it returns true, so lookups are not disturbed otherwise.
+     * @return what update returned.
+     */
+    template<class Update>
+    bool update(
+            const Key& key,
+            const Update& update)
+    {
+        Shard& shard = get_shard(key);
+        std::lock_guard<std::mutex> lock(shard.mtx);
+        const Map* entries = shard.entries.load();
+        auto it = entries->find(key);
+        Value value{};
+        bool rv = update((it != entries->end()) ? &it->second : nullptr, value);
+        if (rv)
+        {
+            modify(shard, [&](Map& modified_entries){ modified_entries[key] = std::move(value); });
+        }
+        return rv;
+    }
+
+    /**
+     * @return true if the key was in the map.
+     */
+    bool erase(
+            const Key& key)
+    {
+        bool rv = false;
+        Shard& shard = get_shard(key);
+        std::lock_guard<std::mutex> lock(shard.mtx);
+        if (0 != shard.entries.load()->count(key))
+        {
+            modify(shard, [&](Map& entries){ entries.erase(key); });
+            rv = true;
+        }
+        return rv;
+    }
+
+    /**
+     * @brief Erases the key, handing its value over.
+     * @return true if the key was in the map.
+     */
+    bool erase(
+            const Key& key,
+            Value& value)
+    {
+        bool rv = false;
+        Shard& shard = get_shard(key);
+        std::lock_guard<std::mutex> lock(shard.mtx);
+        const Map* entries = shard.entries.load();
+        auto it = entries->find(key);
+        if (it != entries->end())
+        {
+            value = it->second;
+            modify(shard, [&](Map& modified_entries){ modified_entries.erase(key); });
+            rv = true;
+        }
+        return rv;
+    }
+
+    /**
+     * @brief Calls function(key, value) for every entry, one shard at a time. Entries inserted or erased
+     *        meanwhile may or may not be visited.
+     */
+    template<class Function>
+    void for_each(
+            const Function& function) const
+    {
+        for (size_t i = 0; i < shard_count; ++i)
+        {
+            Shard& shard = shards_[i];
+            ReadSection section(shard);
+            for (const auto& entry : *section.entries())
+            {
+                function(entry.first, entry.second);
+            }
+        }
+    }
+
+    void clear()
+    {
+        for (size_t i = 0; i < shard_count; ++i)
+        {
+            Shard& shard = shards_[i];
+            std::lock_guard<std::mutex> lock(shard.mtx);
+            publish(shard, new Map());
+        }
+    }
+
+    /**
+     * @brief Empties the map, appending the erased values to values.
+     */
+    void clear(
+            std::vector<Value>& values)
+    {
+        for (size_t i = 0; i < shard_count; ++i)
+        {
+            Shard& shard = shards_[i];
+            std::lock_guard<std::mutex> lock(shard.mtx);
+            for (const auto& entry : *shard.entries.load())
+            {
+                values.push_back(entry.second);
+            }
+            publish(shard, new Map());
+        }
+    }
+
+    /**
+     * @return true if lookups are lock-free on this platform.
+     */
+    bool is_lock_free() const
+    {
+        const Shard& shard = shards_[0];
+        return shard.entries.is_lock_free() && shard.epoch.is_lock_free() && shard.readers[0].is_lock_free();
+    }
+
+private:
+    using Map = std::unordered_map<Key, Value, Hash>;
+
+    /*
+     * Shards start on their own cache lines, and the reader counters, written by every lookup, get one of their
+     * own, so neither adjacent shards nor the mutex and the published map of the same shard share it. Shards live
+     * in storage aligned by hand, as operator new does not honour their alignment before C++17, and that keeps
+     * the map itself, and its owners, normally aligned.
+     */
+    struct alignas(CACHE_LINE_SIZE) Shard
+    {
+        std::mutex mtx;
+        std::atomic<const Map*> entries;
+        std::atomic<uint32_t> epoch;
+        alignas(CACHE_LINE_SIZE) std::array<std::atomic<uint32_t>, 2> readers;
+    };
+
+    /*
+     * Keeps the map of a shard alive while it is read. The epoch parity selects the counter a reader
+     * announces itself on, and the map is loaded only after the announcement.
+     */
+    class ReadSection
+    {
+    public:
+        explicit ReadSection(
+                Shard& shard)
+            : counter_(shard.readers[shard.epoch.load() & 1])
+        {
+            counter_.fetch_add(1);
+            entries_ = shard.entries.load();
+        }
+
+        ~ReadSection()
+        {
+            counter_.fetch_sub(1);
+        }
+
+        ReadSection(ReadSection&&) = delete;
+        ReadSection(const ReadSection&) = delete;
+        ReadSection& operator=(ReadSection&&) = delete;
+        ReadSection& operator=(const ReadSection&) = delete;
+
+        const Map* entries() const { return entries_; }
+
+    private:
+        std::atomic<uint32_t>& counter_;
+        const Map* entries_;
+    };
+
+    static constexpr uint32_t shard_bits = 6;
+    static constexpr size_t shard_count = size_t(1) << shard_bits;
+
+    Shard& get_shard(
+            const Key& key) const
+    {
+        /* std::hash of integers is usually the identity. */
+        return shards_[fibonacci_hash(uint64_t(Hash{}(key)), shard_bits)];
+    }
+
+    /*
+     * Both shall be called under the shard mutex.
+     */
+    template<class Modify>
+    static void modify(
+            Shard& shard,
+            const Modify& modify_entries)
+    {
+        Map* entries = new Map(*shard.entries.load());
+        modify_entries(*entries);
+        publish(shard, entries);
+    }
+
+    static void publish(
+            Shard& shard,
+            const Map* entries)
+    {
+        const Map* previous = shard.entries.load();
+        shard.entries.store(entries);
+
+        /*
+         * A reader still holding the previous map announced itself before the store above, on either counter.
+         * After each flip, new readers go to the other counter, so both drain in turn.
+         */
+        for (int i = 0; i < 2; ++i)
+        {
+            const uint32_t epoch = shard.epoch.load();
+            shard.epoch.store(epoch + 1);
+            while (0 != shard.readers[epoch & 1].load())
+            {
+                std::this_thread::yield();
+            }
+        }
+        delete previous;
+    }
+
+private:
+    std::unique_ptr<uint8_t[]> storage_;
+    Shard* shards_;
+};
+
+} // namespace utils
+} // namespace uxr
+} // namespace eprosima
+
+#endif // UXR_AGENT_UTILS_SNAPSHOT_MAP_HPP_
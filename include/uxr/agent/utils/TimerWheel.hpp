@@ -0,0 +1,205 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UXR_AGENT_UTILS_TIMER_WHEEL_HPP_
+#define UXR_AGENT_UTILS_TIMER_WHEEL_HPP_
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace eprosima {
+namespace uxr {
+namespace utils {
+
+/**
+ * @brief Hashed timer wheel. Time is split in ticks and each timer is stored in the slot of its expiration tick
+ *        modulo the number of slots, so scheduling takes constant time and advancing only visits the slots of the
+ *        elapsed ticks. Timers further than a whole turn stay in their slot until their own tick comes.
+ *        Timers expire at the end of the tick holding their expiration time, never earlier.
+ */
+template<class T>
+class TimerWheel
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit TimerWheel(
+            std::chrono::microseconds tick = std::chrono::milliseconds(1),
+            size_t min_slots = 256)
+        : slots_(round_slots(min_slots))
+        , mask_{slots_.size() - 1}
+        , tick_{(std::chrono::microseconds(0) < tick) ? tick : std::chrono::microseconds(1)}
+        , origin_{Clock::now()}
+        , current_tick_{0}
+        , earliest_tick_{0}
+        , size_{0}
+    {}
+
+    TimerWheel(TimerWheel&&) = delete;
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(TimerWheel&&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    bool empty() const { return 0 == size_; }
+
+    size_t size() const { return size_; }
+
+    /**
+     * @brief Time at which the next tick ends, that is, the earliest time at which a timer may expire.
+     */
+    Clock::time_point next_expiration() const
+    {
+        return origin_ + (tick_ * int64_t(current_tick_ + 1));
+    }
+
+    /**
+     * @brief Time at which the earliest timer expires, so that a waiter only wakes up when a timer is due.
+     *        It is the next tick end if there are no timers.
+     */
+    Clock::time_point earliest_expiration() const
+    {
+        return (0 == size_) ? next_expiration() : origin_ + (tick_ * int64_t(earliest_tick_ + 1));
+    }
+
+    void schedule(
+            Clock::time_point expiration,
+            T&& item)
+    {
+        uint64_t tick = get_tick(expiration);
+        if (tick < current_tick_)
+        {
+            tick = current_tick_;
+        }
+        slots_[size_t(tick) & mask_].emplace_back(Entry{tick, std::move(item)});
+        if ((0 == size_) || (tick < earliest_tick_))
+        {
+            earliest_tick_ = tick;
+        }
+        ++size_;
+    }
+
+    /**
+     * @brief Moves the timers of every tick ended by now into expired.
+     */
+    void advance(
+            Clock::time_point now,
+            std::vector<T>& expired)
+    {
+        if (next_expiration() <= now)
+        {
+            const uint64_t last_tick = get_tick(now) - 1;
+            if (0 < size_)
+            {
+                const uint64_t last_slot_tick = (std::min)(last_tick, current_tick_ + mask_);
+                for (uint64_t tick = current_tick_; tick <= last_slot_tick; ++tick)
+                {
+                    std::vector<Entry>& slot = slots_[size_t(tick) & mask_];
+                    for (size_t i = 0; i < slot.size();)
+                    {
+                        if (slot[i].tick <= last_tick)
+                        {
+                            expired.emplace_back(std::move(slot[i].item));
+                            slot[i] = std::move(slot.back());
+                            slot.pop_back();
+                            --size_;
+                        }
+                        else
+                        {
+                            ++i;
+                        }
+                    }
+                }
+            }
+            current_tick_ = last_tick + 1;
+            if ((0 < size_) && (earliest_tick_ < current_tick_))
+            {
+                earliest_tick_ = find_earliest_tick();
+            }
+        }
+    }
+
+private:
+    struct Entry
+    {
+        uint64_t tick;
+        T item;
+    };
+
+    static size_t round_slots(
+            size_t min_slots)
+    {
+        size_t slots = 1;
+        while (slots < min_slots)
+        {
+            slots <<= 1;
+        }
+        return slots;
+    }
+
+    /**
+     * @brief Walks the ticks of the current turn up to the first one holding a timer, and only looks at every timer
+     *        if the whole turn is empty. Requires timers to be present.
+     */
+    uint64_t find_earliest_tick() const
+    {
+        uint64_t rv = UINT64_MAX;
+        for (uint64_t tick = current_tick_; (UINT64_MAX == rv) && (tick <= current_tick_ + mask_); ++tick)
+        {
+            for (const Entry& entry : slots_[size_t(tick) & mask_])
+            {
+                if (tick == entry.tick)
+                {
+                    rv = tick;
+                    break;
+                }
+            }
+        }
+        if (UINT64_MAX == rv)
+        {
+            for (const std::vector<Entry>& slot : slots_)
+            {
+                for (const Entry& entry : slot)
+                {
+                    rv = (std::min)(rv, entry.tick);
+                }
+            }
+        }
+        return rv;
+    }
+
+    uint64_t get_tick(
+            Clock::time_point time) const
+    {
+        return (time <= origin_)
+            ? 0
+            : uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(time - origin_).count() / tick_.count());
+    }
+
+    std::vector<std::vector<Entry>> slots_;
+    const size_t mask_;
+    const std::chrono::microseconds tick_;
+    const Clock::time_point origin_;
+    uint64_t current_tick_;
+    uint64_t earliest_tick_;
+    size_t size_;
+};
+
+} // namespace utils
+} // namespace uxr
+} // namespace eprosima
+
+#endif // UXR_AGENT_UTILS_TIMER_WHEEL_HPP_
@@ -41,6 +41,10 @@ public:
             size_t required_tokens,
             T&& timeout);
 
+    bool try_consume_tokens(
+            size_t required_tokens,
+            std::chrono::steady_clock::time_point& retry_time);
+
     size_t get_rate() { return rate_; }
     size_t get_capacity() { return capacity_; }
     size_t get_available_tokens() { return tokens_; }
@@ -110,6 +114,42 @@ inline bool TokenBucket::consume_tokens(
     return rv;
 }
 
+/*
+ * Non-blocking version of consume_tokens. When there are not enough tokens, retry_time is set to the time at which
+ * the bucket will hold them.
+ */
+inline bool TokenBucket::try_consume_tokens(
+        size_t required_tokens,
+        std::chrono::steady_clock::time_point& retry_time)
+{
+    using namespace std::chrono;
+
+    bool rv = false;
+    const steady_clock::time_point now = steady_clock::now();
+    if (required_tokens > capacity_)
+    {
+        retry_time = steady_clock::time_point::max();
+    }
+    else
+    {
+        const size_t current_tokens = std::min(
+            capacity_,
+            tokens_ + size_t((rate_ * uint64_t(duration_cast<milliseconds>(now - timestamp_).count())) / std::milli::den));
+        if (current_tokens < required_tokens)
+        {
+            retry_time = now + milliseconds(
+                ((uint64_t(required_tokens - current_tokens) * std::milli::den) + rate_ - 1) / rate_);
+        }
+        else
+        {
+            tokens_ = current_tokens - required_tokens;
+            timestamp_ = now;
+            rv = true;
+        }
+    }
+    return rv;
+}
+
 } // namespace utils
 } // namespace uxr
 } // namespace eprosima
@@ -17,6 +17,11 @@
 #include <uxr/agent/utils/Conversion.hpp>
 #include <uxr/agent/datawriter/DataWriter.hpp>
 #include <uxr/agent/middleware/utils/Callbacks.hpp>
+#include <uxr/agent/logger/Logger.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
 
 namespace eprosima {
 namespace uxr {
@@ -215,6 +220,10 @@ void fill_object_variant<Agent::REPLIER_OBJK>(
 Agent::Agent()
     : root_(new Root())
     , callback_factory_(callback_factory_.getInstance())
+    , metrics_dump_mtx_{}
+    , metrics_dump_file_{}
+    , metrics_dump_period_{0}
+    , metrics_dump_deadline_{}
 {}
 
 Agent::~Agent() = default;
@@ -535,6 +544,139 @@ void Agent::set_verbose_level(uint8_t verbose_level)
     root_->set_verbose_level(verbose_level);
 }
 
+bool Agent::enable_async_logging(const std::string& file_path)
+{
+#ifdef UAGENT_LOGGER_PROFILE
+    return AsyncLogger::start(file_path);
+#else
+    (void) file_path;
+    return false;
+#endif
+}
+
+void Agent::disable_async_logging()
+{
+#ifdef UAGENT_LOGGER_PROFILE
+    AsyncLogger::stop();
+#endif
+}
+
+bool Agent::set_stream_depth(
+        uint16_t reliable_depth,
+        uint16_t best_effort_depth,
+        uint16_t max_reliable_depth)
+{
+    bool rv = false;
+    if ((0 < reliable_depth) && (MAX_STREAM_DEPTH >= reliable_depth) &&
+        (0 < best_effort_depth) && (MAX_STREAM_DEPTH >= best_effort_depth) &&
+        (MAX_STREAM_DEPTH >= max_reliable_depth))
+    {
+        StreamConfig stream_config = root_->get_stream_config();
+        stream_config.reliable_depth = reliable_depth;
+        stream_config.best_effort_depth = best_effort_depth;
+        stream_config.max_reliable_depth = (std::max)(reliable_depth, max_reliable_depth);
+        root_->set_stream_config(stream_config);
+        rv = true;
+    }
+    return rv;
+}
+
+bool Agent::set_flush_timeout(std::chrono::microseconds flush_timeout)
+{
+    bool rv = false;
+    if ((std::chrono::microseconds(0) <= flush_timeout) && (MAX_FLUSH_TIMEOUT >= flush_timeout))
+    {
+        StreamConfig stream_config = root_->get_stream_config();
+        stream_config.flush_timeout = flush_timeout;
+        root_->set_stream_config(stream_config);
+        rv = true;
+    }
+    return rv;
+}
+
+/**********************************************************************************************************************
+ * Metrics.
+ **********************************************************************************************************************/
+void Agent::get_metrics(AgentMetrics& metrics)
+{
+    metrics = AgentMetrics();
+    get_transport_metrics(metrics);
+
+    std::vector<std::shared_ptr<ProxyClient>> clients;
+    root_->get_clients(clients);
+    metrics.clients = clients.size();
+    for (const auto& client : clients)
+    {
+        const size_t first_stream = metrics.streams.size();
+        client->session().get_output_stream_metrics(metrics.streams);
+        const uint32_t raw_client_key = conversion::clientkey_to_raw(client->get_client_key());
+        for (size_t i = first_stream; i < metrics.streams.size(); ++i)
+        {
+            metrics.streams[i].client_key = raw_client_key;
+        }
+    }
+}
+
+bool Agent::dump_metrics(const std::string& file_path)
+{
+    AgentMetrics metrics;
+    get_metrics(metrics);
+
+    /* Written aside and renamed, so that readers never see a partial file. */
+    const std::string tmp_file_path = file_path + ".tmp";
+    std::ofstream file(tmp_file_path, std::ios::out | std::ios::trunc);
+    bool rv = file.is_open();
+    if (rv)
+    {
+        metrics.write_prometheus(file);
+        file.close();
+        rv = !file.fail();
+    }
+    if (rv && (0 != std::rename(tmp_file_path.c_str(), file_path.c_str())))
+    {
+        /* Renaming onto an existing file fails on some platforms. */
+        std::remove(file_path.c_str());
+        rv = (0 == std::rename(tmp_file_path.c_str(), file_path.c_str()));
+    }
+    return rv;
+}
+
+void Agent::enable_metrics_dump(
+        const std::string& file_path,
+        std::chrono::milliseconds period)
+{
+    std::lock_guard<std::mutex> lock(metrics_dump_mtx_);
+    metrics_dump_file_ = file_path;
+    metrics_dump_period_ = period;
+    metrics_dump_deadline_ = std::chrono::steady_clock::now();
+}
+
+void Agent::disable_metrics_dump()
+{
+    std::lock_guard<std::mutex> lock(metrics_dump_mtx_);
+    metrics_dump_file_.clear();
+}
+
+void Agent::dump_metrics_if_due()
+{
+    std::unique_lock<std::mutex> lock(metrics_dump_mtx_);
+    auto now = std::chrono::steady_clock::now();
+    if (!metrics_dump_file_.empty() && (metrics_dump_deadline_ <= now))
+    {
+        const std::string file_path = metrics_dump_file_;
+        metrics_dump_deadline_ = now + metrics_dump_period_;
+        lock.unlock();
+
+        if (!dump_metrics(file_path))
+        {
+            UXR_AGENT_LOG_WARN(
+                UXR_DECORATE_YELLOW("metrics dump error"),
+                "file: {}",
+                file_path);
+        }
+    }
+}
+
 /**********************************************************************************************************************
  * Write Data.
  **********************************************************************************************************************/
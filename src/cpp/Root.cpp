@@ -32,10 +32,9 @@ namespace uxr {
 
 Root::Root()
     : mtx_(),
-      clients_(),
-      current_client_()
+      stream_config_(),
+      clients_()
 {
-    current_client_ = clients_.begin();
 #ifdef UAGENT_LOGGER_PROFILE
     spdlog::set_level(spdlog::level::info);
     spdlog::set_pattern(UXR_LOG_PATTERN);
@@ -45,11 +44,7 @@ Root::Root()
 /* It must be here instead of the hpp because the forward declaration of Middleware in the hpp. */
 Root::~Root()
 {
-    for (auto it = clients_.begin(); it != clients_.end(); )
-    {
-        it->second->release();
-        it = clients_.erase(it);
-    }
+    reset();
 }
 
 dds::xrce::ResultStatus Root::create_client(
@@ -77,58 +72,58 @@ dds::xrce::ResultStatus Root::create_client(
     {
         if (client_representation.xrce_version()[0] == dds::xrce::XRCE_VERSION_MAJOR)
         {
-            std::lock_guard<std::mutex> lock(mtx_);
+            const StreamConfig stream_config = get_stream_config();
             dds::xrce::ClientKey client_key = client_representation.client_key();
             dds::xrce::SessionId session_id = client_representation.session_id();
-            auto it = clients_.find(client_key);
-            if (it == clients_.end())
+            uint32_t raw_client_key = conversion::clientkey_to_raw(client_key);
+            bool created = false;
+            clients_.update(raw_client_key,
+                [&](const std::shared_ptr<ProxyClient>* client, std::shared_ptr<ProxyClient>& new_client)
             {
-                std::unordered_map<std::string, std::string> client_properties;
-
-                if (client_representation.properties())
-                {   
-                    auto v = *client_representation.properties();
-                    for (auto it_props = v.begin(); it_props != v.end(); ++it_props)
-                    {
-                        client_properties.insert(std::pair<std::string, std::string>(it_props->name(), it_props->value()));
-                    }
-                }
-
-                std::shared_ptr<ProxyClient> new_client = std::make_shared<ProxyClient>(
-                    client_representation,
-                    middleware_kind,
-                    std::move(client_properties));
-                if (clients_.emplace(client_key, std::move(new_client)).second)
+                bool rv = true;
+                if (nullptr == client)
                 {
-                    UXR_AGENT_LOG_INFO(
-                        UXR_DECORATE_GREEN("create"),
-                        UXR_CREATE_SESSION_PATTERN,
-                        conversion::clientkey_to_raw(client_key),
-                        session_id);
-                }
-                else
-                {
-                    result_status.status(dds::xrce::STATUS_ERR_RESOURCES);
+                    std::unordered_map<std::string, std::string> client_properties;
+
+                    if (client_representation.properties())
+                    {   
+                        auto v = *client_representation.properties();
+                        for (auto it_props = v.begin(); it_props != v.end(); ++it_props)
+                        {
+                            client_properties.insert(std::pair<std::string, std::string>(it_props->name(), it_props->value()));
+                        }
+                    }
 
-                    UXR_AGENT_LOG_INFO(
-                        UXR_DECORATE_RED("resources error"),
-                        UXR_CLIENT_KEY_PATTERN,
-                        conversion::clientkey_to_raw(client_representation.client_key()));
+                    new_client = std::make_shared<ProxyClient>(
+                        client_representation,
+                        middleware_kind,
+                        std::move(client_properties),
+                        stream_config);
+                    created = true;
                 }
-            }
-            else
-            {
-                std::shared_ptr<ProxyClient> client = clients_.at(client_key);
-                if (session_id != client->get_session_id())
+                else if (session_id != (*client)->get_session_id())
                 {
-                    it->second = std::make_shared<ProxyClient>(
+                    new_client = std::make_shared<ProxyClient>(
                         client_representation,
-                        middleware_kind);
+                        middleware_kind,
+                        std::unordered_map<std::string, std::string>{},
+                        stream_config);
                 }
                 else
                 {
-                    client->session().reset();
+                    (*client)->session().reset();
+                    rv = false;
                 }
+                return rv;
+            });
+
+            if (created)
+            {
+                UXR_AGENT_LOG_INFO(
+                    UXR_DECORATE_GREEN("create"),
+                    UXR_CREATE_SESSION_PATTERN,
+                    raw_client_key,
+                    session_id);
             }
         }
         else
@@ -179,20 +174,18 @@ dds::xrce::ResultStatus Root::get_info(dds::xrce::ObjectInfo& agent_info)
 dds::xrce::ResultStatus Root::delete_client(const dds::xrce::ClientKey& client_key)
 {
     dds::xrce::ResultStatus result_status;
-    if (std::shared_ptr<ProxyClient> client = get_client(client_key))
+    uint32_t raw_client_key = conversion::clientkey_to_raw(client_key);
+    std::shared_ptr<ProxyClient> client;
+    clients_.erase(raw_client_key, client);
+
+    if (client)
     {
-        std::lock_guard<std::mutex> lock(mtx_);
-        if (current_client_ != clients_.end() && client_key == current_client_->first)
-        {
-            ++current_client_;
-        }
         client->release();
-        clients_.erase(client_key);
         result_status.status(dds::xrce::STATUS_OK);
         UXR_AGENT_LOG_INFO(
             UXR_DECORATE_GREEN("delete"),
             UXR_CLIENT_KEY_PATTERN,
-            conversion::clientkey_to_raw(client_key));
+            raw_client_key);
     }
     else
     {
@@ -201,7 +194,7 @@ dds::xrce::ResultStatus Root::delete_client(const dds::xrce::ClientKey& client_k
         UXR_AGENT_LOG_INFO(
             UXR_DECORATE_RED("unknown client"),
             UXR_CLIENT_KEY_PATTERN,
-            conversion::clientkey_to_raw(client_key));
+            raw_client_key);
     }
     return result_status;
 }
@@ -209,30 +202,17 @@ dds::xrce::ResultStatus Root::delete_client(const dds::xrce::ClientKey& client_k
 std::shared_ptr<ProxyClient> Root::get_client(const dds::xrce::ClientKey& client_key)
 {
     std::shared_ptr<ProxyClient> client;
-    std::lock_guard<std::mutex> lock(mtx_);
-    auto it = clients_.find(client_key);
-    if (it != clients_.end())
-    {
-        client = clients_.at(client_key);
-    }
+    clients_.find(conversion::clientkey_to_raw(client_key), client);
     return client;
 }
 
-bool Root::get_next_client(std::shared_ptr<ProxyClient>& next_client)
+void Root::get_clients(std::vector<std::shared_ptr<ProxyClient>>& clients)
 {
-    bool rv = false;
-    std::lock_guard<std::mutex> lock(mtx_);
-    if (current_client_ != clients_.end())
+    clients.clear();
+    clients_.for_each([&](uint32_t, const std::shared_ptr<ProxyClient>& client)
     {
-        next_client = current_client_->second;
-        ++current_client_;
-        rv = true;
-    }
-    else
-    {
-        current_client_ = clients_.begin();
-    }
-    return rv;
+        clients.push_back(client);
+    });
 }
 
 bool Root::load_config_file(const std::string& file_path)
@@ -303,16 +283,33 @@ void Root::set_verbose_level(uint8_t verbose_level)
 #endif
 }
 
-void Root::reset()
+void Root::set_stream_config(const StreamConfig& stream_config)
 {
     std::lock_guard<std::mutex> lock(mtx_);
-    for (auto it = clients_.begin(); it != clients_.end(); )
+    stream_config_ = stream_config;
+    UXR_AGENT_LOG_INFO(
+        UXR_DECORATE_GREEN("stream config"),
+        "reliable depth: {}, best-effort depth: {}, max reliable depth: {}, flush timeout: {} us",
+        stream_config.reliable_depth,
+        stream_config.best_effort_depth,
+        stream_config.max_reliable_depth,
+        stream_config.flush_timeout.count());
+}
+
+StreamConfig Root::get_stream_config()
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    return stream_config_;
+}
+
+void Root::reset()
+{
+    std::vector<std::shared_ptr<ProxyClient>> clients;
+    clients_.clear(clients);
+    for (const auto& client : clients)
     {
-        it->second->release();
-        it = clients_.erase(it);
+        client->release();
     }
-    clients_.clear();
-    current_client_ = clients_.begin();
 }
 
 } // namespace uxr
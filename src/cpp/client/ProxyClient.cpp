@@ -22,6 +22,9 @@
 #include <uxr/agent/topic/Topic.hpp>
 #include <uxr/agent/logger/Logger.hpp>
 
+#include <algorithm>
+#include <cctype>
+
 #ifdef UAGENT_FAST_PROFILE
 #include <uxr/agent/middleware/fast/FastMiddleware.hpp>
 #include <uxr/agent/middleware/fastdds/FastDDSMiddleware.hpp>
@@ -34,13 +37,100 @@
 namespace eprosima {
 namespace uxr {
 
+namespace {
+
+/*
+ * Reads a stream setting from the client properties, keeping the current value when it is absent or invalid.
+ */
+bool read_stream_property(
+        const dds::xrce::CLIENT_Representation& representation,
+        const std::unordered_map<std::string, std::string>& properties,
+        const std::string& name,
+        unsigned long min_value,
+        unsigned long max_value,
+        unsigned long& value)
+{
+    bool rv = false;
+    auto it = properties.find(name);
+    if (it != properties.end())
+    {
+        const std::string& raw_value = it->second;
+        unsigned long parsed = 0;
+        bool valid = !raw_value.empty() && (raw_value.size() <= 9) && std::all_of(raw_value.begin(), raw_value.end(), ::isdigit);
+        if (valid)
+        {
+            parsed = std::stoul(raw_value);
+            valid = (min_value <= parsed) && (max_value >= parsed);
+        }
+
+        if (valid)
+        {
+            value = parsed;
+            rv = true;
+        }
+        else
+        {
+            UXR_AGENT_LOG_WARN(
+                UXR_DECORATE_YELLOW("invalid stream property"),
+                "client_key: 0x{:08X}, property: {}, value: {}",
+                conversion::clientkey_to_raw(representation.client_key()),
+                name,
+                raw_value);
+        }
+    }
+    return rv;
+}
+
+void read_depth_property(
+        const dds::xrce::CLIENT_Representation& representation,
+        const std::unordered_map<std::string, std::string>& properties,
+        const std::string& name,
+        uint16_t& depth)
+{
+    unsigned long value = 0;
+    if (read_stream_property(representation, properties, name, 1, MAX_STREAM_DEPTH, value))
+    {
+        depth = uint16_t(value);
+    }
+}
+
+/*
+ * Stream settings of the session: the agent defaults, overridden by the client properties
+ * uxr_rd (reliable depth), uxr_bd (best-effort depth), uxr_aw (maximum adaptive reliable depth)
+ * and uxr_ag (DATA aggregation flush timeout in microseconds, 0 disables it).
+ */
+StreamConfig get_stream_config(
+        const dds::xrce::CLIENT_Representation& representation,
+        const std::unordered_map<std::string, std::string>& properties,
+        const StreamConfig& default_config)
+{
+    StreamConfig stream_config = default_config;
+    read_depth_property(representation, properties, "uxr_rd", stream_config.reliable_depth);
+    read_depth_property(representation, properties, "uxr_bd", stream_config.best_effort_depth);
+    read_depth_property(representation, properties, "uxr_aw", stream_config.max_reliable_depth);
+    stream_config.max_reliable_depth = (std::max)(stream_config.max_reliable_depth, stream_config.reliable_depth);
+
+    unsigned long flush_timeout = 0;
+    if (read_stream_property(
+            representation, properties, "uxr_ag", 0, (unsigned long)MAX_FLUSH_TIMEOUT.count(), flush_timeout))
+    {
+        stream_config.flush_timeout = std::chrono::microseconds(flush_timeout);
+    }
+    return stream_config;
+}
+
+} // namespace
+
 ProxyClient::ProxyClient(
         const dds::xrce::CLIENT_Representation& representation,
         Middleware::Kind middleware_kind,
-        std::unordered_map<std::string, std::string>&& properties)
+        std::unordered_map<std::string, std::string>&& properties,
+        const StreamConfig& stream_config)
     : representation_(representation)
     , objects_()
-    , session_(SessionInfo{representation.client_key(), representation.session_id(), representation.mtu()})
+    , session_(
+        SessionInfo{representation.client_key(), representation.session_id(), representation.mtu()},
+        get_stream_config(representation, properties, stream_config))
     , state_{State::alive}
     , timestamp_{std::chrono::steady_clock::now()}
     , properties_(std::move(properties))
@@ -88,6 +178,15 @@ ProxyClient::ProxyClient(
             conversion::clientkey_to_raw(representation.client_key()),
             std::stoi(properties_["uxr_hl"]));
     }
+    const StreamConfig& session_stream_config = session_.get_stream_config();
+    UXR_AGENT_LOG_DEBUG(
+        UXR_DECORATE_WHITE("session streams"),
+        "client_key: 0x{:08X}, reliable depth: {}, best-effort depth: {}, max reliable depth: {}, flush timeout: {} us",
+        conversion::clientkey_to_raw(representation.client_key()),
+        session_stream_config.reliable_depth,
+        session_stream_config.best_effort_depth,
+        session_stream_config.max_reliable_depth,
+        session_stream_config.flush_timeout.count());
 }
 
 dds::xrce::ResultStatus ProxyClient::create_object(
@@ -73,11 +73,22 @@ DataReader::DataReader(
     : XRCEObject{object_id}
     , proxy_client_{proxy_client}
     , reader_{}
-{}
+    , seq_reader_{}
+    , max_samples_{0}
+    , read_samples_{0}
+    , max_seq_bytes_{0}
+{
+    /* Without notifications from the middleware the reader is polled. */
+    bool event_driven = proxy_client_->get_middleware().set_datareader_listener(
+        get_raw_id(), [this](){ reader_.notify(); seq_reader_.notify(); });
+    reader_.set_event_driven(event_driven);
+    seq_reader_.set_event_driven(event_driven);
+}
 
 DataReader::~DataReader() noexcept
 {
     reader_.stop_reading();
+    seq_reader_.stop_reading();
     proxy_client_->get_middleware().delete_datareader(get_raw_id());
 }
 
@@ -126,6 +137,7 @@ bool DataReader::matched(
 bool DataReader::read(
         const dds::xrce::READ_DATA_Payload& read_data,
         Reader<bool>::WriteFn write_fn,
+        SeqReader::WriteFn write_seq_fn,
         WriteFnArgs& write_args)
 {
     dds::xrce::DataDeliveryControl delivery_control;
@@ -140,29 +152,39 @@ bool DataReader::read(
         delivery_control.max_samples(1);
     }
 
-    /* TODO (julianbermudez): implement different data formats.
-    switch (read_data.read_specification().data_format())
-    {
-        case dds::xrce::FORMAT_DATA:
-            break;
-        case dds::xrce::FORMAT_SAMPLE:
-            break;
-        case dds::xrce::FORMAT_DATA_SEQ:
-            break;
-        case dds::xrce::FORMAT_SAMPLE_SEQ:
-            break;
-        case dds::xrce::FORMAT_PACKED_SAMPLES:
-            break;
-        default:
-            break;
-    }
-    */
-
     write_args.client = proxy_client_;
 
     using namespace std::placeholders;
-    return (reader_.stop_reading() &&
-            reader_.start_reading(delivery_control, std::bind(&DataReader::read_fn, this, _1, _2, _3), false, write_fn, write_args));
+    bool rv = reader_.stop_reading() && seq_reader_.stop_reading();
+    if (rv)
+    {
+        /* TODO (julianbermudez): implement FORMAT_SAMPLE, FORMAT_SAMPLE_SEQ and FORMAT_PACKED_SAMPLES. */
+        switch (read_data.read_specification().data_format())
+        {
+            case dds::xrce::FORMAT_DATA_SEQ:
+            {
+                /* Message header, submessage header, object request and sequence length. */
+                const size_t overhead = 20;
+                const size_t mtu = proxy_client_->session().get_mtu();
+                max_seq_bytes_ = (mtu > overhead) ? mtu - overhead : 0;
+                if ((0 != delivery_control.max_bytes_per_second()) &&
+                    (delivery_control.max_bytes_per_second() < max_seq_bytes_))
+                {
+                    max_seq_bytes_ = delivery_control.max_bytes_per_second();
+                }
+                max_samples_ = delivery_control.max_samples();
+                read_samples_ = 0;
+                rv = seq_reader_.start_reading(
+                    delivery_control, std::bind(&DataReader::read_seq_fn, this, _1, _2, _3), false, write_seq_fn, write_args);
+                break;
+            }
+            default:
+                rv = reader_.start_reading(
+                    delivery_control, std::bind(&DataReader::read_fn, this, _1, _2, _3), false, write_fn, write_args);
+                break;
+        }
+    }
+    return rv;
 }
 
 bool DataReader::read_fn(
@@ -183,5 +205,30 @@ bool DataReader::read_fn(
     return rv;
 }
 
+bool DataReader::read_seq_fn(
+        bool,
+        dds::xrce::SampleDataSeq& samples,
+        std::chrono::milliseconds timeout)
+{
+    /* Never read more samples than the delivery still allows, since they could not be returned. */
+    const size_t max_samples = (0xFFFF == max_samples_) ? SIZE_MAX : size_t(max_samples_ - read_samples_);
+    bool rv = false;
+    if ((0 < max_samples) &&
+        proxy_client_->get_middleware().read_data_seq(get_raw_id(), samples, max_samples, max_seq_bytes_, timeout))
+    {
+        for (const auto& sample : samples)
+        {
+            UXR_AGENT_LOG_MESSAGE(
+                UXR_DECORATE_YELLOW("[==>> DDS <<==]"),
+                get_raw_id(),
+                sample.serialized_data().data(),
+                sample.serialized_data().size());
+        }
+        read_samples_ = uint16_t(read_samples_ + samples.size());
+        rv = true;
+    }
+    return rv;
+}
+
 } // namespace uxr
 } // namespace eprosima
@@ -147,5 +147,20 @@ bool DataWriter::write(const std::vector<uint8_t>& data)
     return rv;
 }
 
+bool DataWriter::write(const uint8_t* data, size_t length)
+{
+    bool rv = false;
+    if (proxy_client_->get_middleware().write_raw_data(get_raw_id(), data, length))
+    {
+        UXR_AGENT_LOG_MESSAGE(
+            UXR_DECORATE_YELLOW("[** <<DDS>> **]"),
+            get_raw_id(),
+            data,
+            length);
+        rv = true;
+    }
+    return rv;
+}
+
 } // namespace uxr
 } // namespace eprosima
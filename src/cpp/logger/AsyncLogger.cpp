@@ -0,0 +1,429 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/logger/AsyncLogger.hpp>
+#include <uxr/agent/logger/Logger.hpp>
+#include <uxr/agent/config.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace eprosima {
+namespace uxr {
+
+namespace {
+
+const char ASYNC_LOG_MAGIC[8] = {'U', 'X', 'R', 'L', 'O', 'G', '1', '\n'};
+const uint8_t ASYNC_LOG_EVENT_RECORD = 0x01;
+const uint8_t ASYNC_LOG_MESSAGE_RECORD = 0x02;
+
+struct Record
+{
+    int64_t timestamp;
+    uint32_t client_key;
+    int32_t fd;
+    uint32_t length;
+    uint16_t event;
+    uint16_t payload_length;
+    uint8_t payload[ASYNC_LOG_PAYLOAD_SIZE];
+};
+
+/*
+ * Single-producer single-consumer ring: the owning thread reserves and commits records,
+ * the background thread drains them.
+ */
+class Ring
+{
+public:
+    Ring()
+        : records_(ASYNC_LOG_RING_SIZE)
+        , head_{0}
+        , tail_{0}
+        , dropped_{0}
+    {}
+
+    Record* reserve()
+    {
+        Record* record = nullptr;
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (ASYNC_LOG_RING_SIZE > tail - head_.load(std::memory_order_acquire))
+        {
+            record = &records_[tail & (ASYNC_LOG_RING_SIZE - 1)];
+        }
+        else
+        {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
+        return record;
+    }
+
+    void commit()
+    {
+        tail_.store(tail_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    template<typename F>
+    size_t drain(
+            F&& consume)
+    {
+        size_t head = head_.load(std::memory_order_relaxed);
+        size_t tail = tail_.load(std::memory_order_acquire);
+        for (size_t i = head; i != tail; ++i)
+        {
+            consume(records_[i & (ASYNC_LOG_RING_SIZE - 1)]);
+        }
+        head_.store(tail, std::memory_order_release);
+        return tail - head;
+    }
+
+    bool empty() const
+    {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+    uint64_t take_dropped()
+    {
+        return dropped_.exchange(0, std::memory_order_relaxed);
+    }
+
+private:
+    std::vector<Record> records_;
+    std::atomic<size_t> head_;
+    std::atomic<size_t> tail_;
+    std::atomic<uint64_t> dropped_;
+};
+
+class Backend
+{
+public:
+    static Backend& instance()
+    {
+        static Backend backend;
+        return backend;
+    }
+
+    ~Backend()
+    {
+        stop();
+    }
+
+    bool start(
+            const std::string& file_path)
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        bool rv = false;
+        if (!thread_.joinable())
+        {
+            rv = true;
+            written_events_ = 0;
+            if (!file_path.empty())
+            {
+                file_.open(file_path, std::ios::out | std::ios::binary | std::ios::trunc);
+                rv = file_.is_open();
+                if (rv)
+                {
+                    file_.write(ASYNC_LOG_MAGIC, sizeof(ASYNC_LOG_MAGIC));
+                }
+            }
+
+            if (rv)
+            {
+                to_file_.store(file_.is_open(), std::memory_order_relaxed);
+                running_ = true;
+                thread_ = std::thread(&Backend::run, this);
+                enabled_.store(true, std::memory_order_release);
+            }
+        }
+        return rv;
+    }
+
+    void stop()
+    {
+        std::unique_lock<std::mutex> lock(mtx_);
+        if (thread_.joinable())
+        {
+            enabled_.store(false, std::memory_order_release);
+            running_ = false;
+            cv_.notify_one();
+            std::thread thread = std::move(thread_);
+            lock.unlock();
+            thread.join();
+            lock.lock();
+            if (file_.is_open())
+            {
+                file_.close();
+            }
+        }
+    }
+
+    bool enabled() const
+    {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    uint16_t register_event(
+            const std::string& name)
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        auto it = event_ids_.find(name);
+        if (it == event_ids_.end())
+        {
+            uint16_t id = uint16_t(std::min<size_t>(events_.size(), UINT16_MAX));
+            if (UINT16_MAX > events_.size())
+            {
+                events_.push_back(name);
+            }
+            it = event_ids_.emplace(name, id).first;
+        }
+        return it->second;
+    }
+
+    void push_message(
+            uint16_t event,
+            uint32_t client_key,
+            int32_t fd,
+            const uint8_t* buf,
+            size_t len)
+    {
+        bool capture_payload = to_file_.load(std::memory_order_relaxed);
+        if (!capture_payload)
+        {
+            /* Same levels as the synchronous traces: messages at debug, their payload at trace. */
+            if (!spdlog::default_logger_raw()->should_log(spdlog::level::debug))
+            {
+                return;
+            }
+            capture_payload = spdlog::default_logger_raw()->should_log(spdlog::level::trace);
+        }
+
+        thread_local std::shared_ptr<Ring> ring;
+        if (!ring)
+        {
+            ring = std::make_shared<Ring>();
+            std::lock_guard<std::mutex> lock(mtx_);
+            rings_.push_back(ring);
+        }
+
+        if (Record* record = ring->reserve())
+        {
+            record->timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+            record->client_key = client_key;
+            record->fd = fd;
+            record->length = uint32_t(len);
+            record->event = event;
+            record->payload_length = capture_payload ? uint16_t(std::min<size_t>(len, ASYNC_LOG_PAYLOAD_SIZE)) : 0;
+            std::memcpy(record->payload, buf, record->payload_length);
+            ring->commit();
+        }
+    }
+
+private:
+    Backend()
+        : mtx_{}
+        , cv_{}
+        , thread_{}
+        , running_{false}
+        , enabled_{false}
+        , to_file_{false}
+        , rings_{}
+        , events_{}
+        , event_ids_{}
+        , written_events_{0}
+        , file_{}
+    {}
+
+    void run()
+    {
+        std::vector<std::shared_ptr<Ring>> rings;
+        std::vector<std::string> events;
+        bool running = true;
+        while (running)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mtx_);
+                running = running_;
+                /* Rings of finished threads are released once drained. */
+                rings_.erase(
+                    std::remove_if(rings_.begin(), rings_.end(), [](const std::shared_ptr<Ring>& ring)
+                    {
+                        return (1 == ring.use_count()) && ring->empty();
+                    }),
+                    rings_.end());
+                rings = rings_;
+                if (events.size() != events_.size())
+                {
+                    events = events_;
+                }
+            }
+
+            size_t drained = 0;
+            uint64_t dropped = 0;
+            for (auto& ring : rings)
+            {
+                drained += ring->drain([&](const Record& record)
+                {
+                    /* The event of a record committed after events was copied may be missing from it. */
+                    if ((events.size() <= record.event) && (UINT16_MAX != record.event))
+                    {
+                        std::lock_guard<std::mutex> lock(mtx_);
+                        events = events_;
+                    }
+                    write(record, events);
+                });
+                dropped += ring->take_dropped();
+            }
+            rings.clear();
+
+            if (0 < dropped)
+            {
+                UXR_AGENT_LOG_WARN(
+                    UXR_DECORATE_YELLOW("async log records dropped"),
+                    "records: {}",
+                    dropped);
+            }
+
+            if ((0 == drained) && running)
+            {
+                if (file_.is_open())
+                {
+                    file_.flush();
+                }
+                std::unique_lock<std::mutex> lock(mtx_);
+                cv_.wait_for(lock, std::chrono::milliseconds(1), [&](){ return !running_; });
+            }
+        }
+        if (file_.is_open())
+        {
+            file_.flush();
+        }
+    }
+
+    void write(
+            const Record& record,
+            const std::vector<std::string>& events)
+    {
+        static const std::string unknown_event = "unknown";
+        const std::string& event = (record.event < events.size()) ? events[record.event] : unknown_event;
+
+        if (file_.is_open())
+        {
+            for (; written_events_ < events.size(); ++written_events_)
+            {
+                uint16_t id = uint16_t(written_events_);
+                uint16_t name_length = uint16_t(std::min<size_t>(events[id].size(), UINT16_MAX));
+                file_.put(char(ASYNC_LOG_EVENT_RECORD));
+                file_.write(reinterpret_cast<const char*>(&id), sizeof(id));
+                file_.write(reinterpret_cast<const char*>(&name_length), sizeof(name_length));
+                file_.write(events[id].data(), name_length);
+            }
+
+            file_.put(char(ASYNC_LOG_MESSAGE_RECORD));
+            file_.write(reinterpret_cast<const char*>(&record.timestamp), sizeof(record.timestamp));
+            file_.write(reinterpret_cast<const char*>(&record.client_key), sizeof(record.client_key));
+            file_.write(reinterpret_cast<const char*>(&record.fd), sizeof(record.fd));
+            file_.write(reinterpret_cast<const char*>(&record.length), sizeof(record.length));
+            file_.write(reinterpret_cast<const char*>(&record.event), sizeof(record.event));
+            file_.write(reinterpret_cast<const char*>(&record.payload_length), sizeof(record.payload_length));
+            file_.write(reinterpret_cast<const char*>(record.payload), record.payload_length);
+        }
+        else
+        {
+            std::string text;
+            if (0 == record.payload_length)
+            {
+                text = fmt::format(
+                    UXR_STATUS_FORMAT UXR_MESSAGE_PATTERN,
+                    event, record.client_key, record.length);
+            }
+            else if (0 <= record.fd)
+            {
+                text = fmt::format(
+                    UXR_STATUS_FORMAT UXR_MESSAGE_WITH_FD_PATTERN,
+                    event, record.client_key, record.fd, record.length,
+                    spdlog::to_hex(record.payload, record.payload + record.payload_length));
+            }
+            else
+            {
+                text = fmt::format(
+                    UXR_STATUS_FORMAT UXR_MESSAGE_WITH_DATA_PATTERN,
+                    event, record.client_key, record.length,
+                    spdlog::to_hex(record.payload, record.payload + record.payload_length));
+            }
+
+            spdlog::log_clock::time_point time{std::chrono::duration_cast<spdlog::log_clock::duration>(
+                std::chrono::nanoseconds(record.timestamp))};
+            spdlog::default_logger_raw()->log(time, spdlog::source_loc{}, spdlog::level::debug, text);
+        }
+    }
+
+private:
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    std::thread thread_;
+    bool running_;
+    std::atomic<bool> enabled_;
+    std::atomic<bool> to_file_;
+    std::vector<std::shared_ptr<Ring>> rings_;
+    std::vector<std::string> events_;
+    std::unordered_map<std::string, uint16_t> event_ids_;
+    size_t written_events_;
+    std::ofstream file_;
+};
+
+} // anonymous namespace
+
+bool AsyncLogger::start(
+        const std::string& file_path)
+{
+    return Backend::instance().start(file_path);
+}
+
+void AsyncLogger::stop()
+{
+    Backend::instance().stop();
+}
+
+bool AsyncLogger::enabled()
+{
+    return Backend::instance().enabled();
+}
+
+uint16_t AsyncLogger::register_event(
+        const std::string& name)
+{
+    return Backend::instance().register_event(name);
+}
+
+void AsyncLogger::push_message(
+        uint16_t event,
+        uint32_t client_key,
+        int32_t fd,
+        const uint8_t* buf,
+        size_t len)
+{
+    Backend::instance().push_message(event, client_key, fd, buf, len);
+}
+
+} // namespace uxr
+} // namespace eprosima
@@ -23,7 +23,7 @@ void InputMessage::log_error()
     UXR_AGENT_LOG_ERROR(
         UXR_DECORATE_RED("deserialization error"),
         "buffer: {:X}",
-        UXR_AGENT_LOG_TO_HEX(buf_, buf_ + len_));
+        UXR_AGENT_LOG_TO_HEX(buffer_.data(), buffer_.data() + len_));
 }
 
 } // namespace uxr
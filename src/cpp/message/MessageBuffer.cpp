@@ -0,0 +1,122 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/message/MessageBuffer.hpp>
+#include <uxr/agent/config.hpp>
+
+namespace eprosima {
+namespace uxr {
+
+constexpr size_t OUTPUT_BUFFER_MIN_SIZE = 64;
+
+/* The pools are never destroyed: messages may still return blocks while static objects are torn down. */
+MessageBufferPool& MessageBufferPool::input_pool()
+{
+    static MessageBufferPool* pool =
+        new MessageBufferPool(INPUT_BUFFER_SIZE, INPUT_BUFFER_SIZE, INPUT_BUFFER_POOL_SIZE);
+    return *pool;
+}
+
+MessageBufferPool& MessageBufferPool::output_pool()
+{
+    static MessageBufferPool* pool =
+        new MessageBufferPool(OUTPUT_BUFFER_MIN_SIZE, SERVER_BUFFER_SIZE, OUTPUT_BUFFER_POOL_SIZE, true);
+    return *pool;
+}
+
+MessageBufferPool::MessageBufferPool(
+        size_t min_block_size,
+        size_t max_block_size,
+        size_t max_cached_blocks,
+        bool zeroed)
+    : size_classes_{}
+    , zeroed_{zeroed}
+{
+    size_t block_size = (0 < min_block_size) ? min_block_size : 1;
+    for (;;)
+    {
+        size_t class_block_size = (block_size < max_block_size) ? block_size : max_block_size;
+        size_t class_max_cached_blocks = (max_cached_blocks * min_block_size) / class_block_size;
+        size_classes_.emplace_back(new SizeClass(class_block_size, class_max_cached_blocks));
+        if (class_block_size == max_block_size)
+        {
+            break;
+        }
+        block_size *= 2;
+    }
+}
+
+MessageBufferPool::~MessageBufferPool()
+{
+    for (auto& size_class : size_classes_)
+    {
+        uint8_t* block = nullptr;
+        while (size_class->free_blocks.try_pop(block))
+        {
+            delete[] block;
+        }
+    }
+}
+
+MessageBuffer MessageBufferPool::acquire(
+        size_t size)
+{
+    uint8_t* data = nullptr;
+    size_t capacity = size;
+    SizeClass* size_class = find_size_class(size);
+    if (nullptr != size_class)
+    {
+        capacity = size_class->block_size;
+        if (!size_class->free_blocks.try_pop(data))
+        {
+            data = allocate(capacity);
+        }
+    }
+    else
+    {
+        data = allocate(size);
+    }
+    return MessageBuffer(this, data, capacity);
+}
+
+MessageBufferPool::SizeClass* MessageBufferPool::find_size_class(
+        size_t size) const
+{
+    SizeClass* rv = nullptr;
+    for (const auto& size_class : size_classes_)
+    {
+        if (size <= size_class->block_size)
+        {
+            rv = size_class.get();
+            break;
+        }
+    }
+    return rv;
+}
+
+void MessageBufferPool::release(
+        uint8_t* data,
+        size_t capacity)
+{
+    SizeClass* size_class = find_size_class(capacity);
+    if ((nullptr == size_class)
+            || (capacity != size_class->block_size)
+            || !size_class->free_blocks.try_push(std::move(data)))
+    {
+        delete[] data;
+    }
+}
+
+} // namespace uxr
+} // namespace eprosima
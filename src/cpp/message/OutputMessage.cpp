@@ -23,7 +23,7 @@ void OutputMessage::log_error()
     UXR_AGENT_LOG_ERROR(
         UXR_DECORATE_RED("serialization error"),
         "buffer: {:X}",
-        UXR_AGENT_LOG_TO_HEX(buf_, buf_ + len_));
+        UXR_AGENT_LOG_TO_HEX(buffer_.data(), buffer_.data() + len_));
 }
 
 } // namespace uxr
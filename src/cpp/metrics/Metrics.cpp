@@ -0,0 +1,251 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/metrics/Metrics.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace eprosima {
+namespace uxr {
+
+constexpr uint32_t Histogram::precision_bits;
+constexpr uint32_t Histogram::max_value_bits;
+constexpr size_t Histogram::bucket_count;
+
+namespace {
+
+const double QUANTILES[] = {0.5, 0.9, 0.99, 0.999};
+
+void write_family(
+        std::ostream& os,
+        const char* name,
+        const char* type,
+        const char* help)
+{
+    os << "# HELP " << name << ' ' << help << '\n';
+    os << "# TYPE " << name << ' ' << type << '\n';
+}
+
+std::string get_stream_labels(
+        const StreamMetrics& stream)
+{
+    char labels[48];
+    std::snprintf(labels, sizeof(labels), "client=\"0x%08X\",stream=\"%u\"",
+        unsigned(stream.client_key), unsigned(stream.stream_id));
+    return labels;
+}
+
+double to_seconds(
+        uint64_t nanoseconds)
+{
+    return double(nanoseconds) / 1e9;
+}
+
+} // anonymous namespace
+
+/**********************************************************************************************************************
+ * Histogram.
+ **********************************************************************************************************************/
+Histogram::Histogram()
+    : buckets_{}
+    , count_{}
+    , sum_{}
+    , max_{0}
+{}
+
+Histogram::Histogram(
+        const Histogram& other)
+    : Histogram()
+{
+    merge(other);
+}
+
+Histogram& Histogram::operator=(
+        const Histogram& other)
+{
+    if (this != &other)
+    {
+        for (size_t i = 0; i < bucket_count; ++i)
+        {
+            buckets_[i].store(other.buckets_[i].load());
+        }
+        count_.store(other.count_.load());
+        sum_.store(other.sum_.load());
+        max_.store(other.max_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    return *this;
+}
+
+void Histogram::record(
+        uint64_t value)
+{
+    buckets_[get_bucket(value)].add(1);
+    count_.add(1);
+    sum_.add(value);
+    if (value > max_.load(std::memory_order_relaxed))
+    {
+        max_.store(value, std::memory_order_relaxed);
+    }
+}
+
+void Histogram::merge(
+        const Histogram& other)
+{
+    for (size_t i = 0; i < bucket_count; ++i)
+    {
+        buckets_[i].add(other.buckets_[i].load());
+    }
+    count_.add(other.count_.load());
+    sum_.add(other.sum_.load());
+    max_.store((std::max)(max_.load(std::memory_order_relaxed), other.max_.load(std::memory_order_relaxed)),
+        std::memory_order_relaxed);
+}
+
+uint64_t Histogram::value_at_quantile(
+        double quantile) const
+{
+    /* Buckets are counted again, as count_ may not match them while recording. */
+    uint64_t total = 0;
+    for (const auto& bucket : buckets_)
+    {
+        total += bucket.load();
+    }
+
+    uint64_t rv = 0;
+    if (0 < total)
+    {
+        double rank = std::ceil((std::min)((std::max)(quantile, 0.0), 1.0) * double(total));
+        uint64_t target = (std::max)(uint64_t(rank), uint64_t(1));
+        uint64_t accumulated = 0;
+        for (size_t i = 0; i < bucket_count; ++i)
+        {
+            accumulated += buckets_[i].load();
+            if (accumulated >= target)
+            {
+                rv = (std::min)(get_bucket_max(i), max());
+                break;
+            }
+        }
+    }
+    return rv;
+}
+
+size_t Histogram::get_bucket(
+        uint64_t value)
+{
+    const uint64_t clamped = (std::min)(value, (uint64_t(1) << max_value_bits) - 1);
+    size_t rv = size_t(clamped);
+    if ((uint64_t(1) << precision_bits) <= clamped)
+    {
+#if defined(__GNUC__)
+        uint32_t msb = uint32_t(63 - __builtin_clzll(clamped));
+#else
+        uint32_t msb = precision_bits;
+        while (0 != (clamped >> (msb + 1)))
+        {
+            ++msb;
+        }
+#endif
+        /* The top precision_bits + 1 bits of the value, offset by its power of two. */
+        uint32_t shift = msb - precision_bits;
+        rv = (size_t(shift) << precision_bits) + size_t(clamped >> shift);
+    }
+    return rv;
+}
+
+uint64_t Histogram::get_bucket_max(
+        size_t bucket)
+{
+    uint64_t rv = bucket;
+    if ((size_t(1) << precision_bits) <= bucket)
+    {
+        uint32_t shift = uint32_t(bucket >> precision_bits) - 1;
+        uint64_t mantissa = bucket - (size_t(shift) << precision_bits);
+        rv = ((mantissa + 1) << shift) - 1;
+    }
+    return rv;
+}
+
+/**********************************************************************************************************************
+ * AgentMetrics.
+ **********************************************************************************************************************/
+void AgentMetrics::write_prometheus(
+        std::ostream& os) const
+{
+    const std::string transport_labels = "transport=\"" + transport.transport + "\"";
+
+    write_family(os, "uxr_agent_received_packets_total", "counter", "Packets received by the transport.");
+    os << "uxr_agent_received_packets_total{" << transport_labels << "} " << transport.packets_in << '\n';
+    write_family(os, "uxr_agent_received_bytes_total", "counter", "Bytes received by the transport.");
+    os << "uxr_agent_received_bytes_total{" << transport_labels << "} " << transport.bytes_in << '\n';
+    write_family(os, "uxr_agent_sent_packets_total", "counter", "Packets sent by the transport.");
+    os << "uxr_agent_sent_packets_total{" << transport_labels << "} " << transport.packets_out << '\n';
+    write_family(os, "uxr_agent_sent_bytes_total", "counter", "Bytes sent by the transport.");
+    os << "uxr_agent_sent_bytes_total{" << transport_labels << "} " << transport.bytes_out << '\n';
+
+    write_family(os, "uxr_agent_queue_drops_total", "counter", "Packets evicted from a full queue.");
+    os << "uxr_agent_queue_drops_total{" << transport_labels << ",queue=\"input\"} " << transport.input_drops << '\n';
+    os << "uxr_agent_queue_drops_total{" << transport_labels << ",queue=\"output\"} " << transport.output_drops << '\n';
+    write_family(os, "uxr_agent_queue_depth", "gauge", "Packets waiting in the queues.");
+    os << "uxr_agent_queue_depth{" << transport_labels << ",queue=\"input\"} " << transport.input_queue_depth << '\n';
+    os << "uxr_agent_queue_depth{" << transport_labels << ",queue=\"output\"} " << transport.output_queue_depth << '\n';
+
+    write_family(os, "uxr_agent_clients", "gauge", "Clients of the agent.");
+    os << "uxr_agent_clients " << clients << '\n';
+
+    write_family(os, "uxr_agent_stream_retransmissions_total", "counter",
+        "Messages of a reliable output stream resent on ACKNACK requests.");
+    for (const auto& stream : streams)
+    {
+        os << "uxr_agent_stream_retransmissions_total{" << get_stream_labels(stream) << "} "
+           << stream.retransmissions << '\n';
+    }
+    write_family(os, "uxr_agent_stream_window_stalls_total", "counter",
+        "Submessages of a reliable output stream which waited for the window.");
+    for (const auto& stream : streams)
+    {
+        os << "uxr_agent_stream_window_stalls_total{" << get_stream_labels(stream) << "} "
+           << stream.window_stalls << '\n';
+    }
+    write_family(os, "uxr_agent_stream_window", "gauge", "Window of a reliable output stream.");
+    for (const auto& stream : streams)
+    {
+        os << "uxr_agent_stream_window{" << get_stream_labels(stream) << "} " << stream.window << '\n';
+    }
+    write_family(os, "uxr_agent_stream_unacked_messages", "gauge",
+        "Messages of a reliable output stream not acknowledged yet.");
+    for (const auto& stream : streams)
+    {
+        os << "uxr_agent_stream_unacked_messages{" << get_stream_labels(stream) << "} " << stream.unacked << '\n';
+    }
+
+    write_family(os, "uxr_agent_processing_latency_seconds", "summary", "Time taken to process an input packet.");
+    for (const double quantile : QUANTILES)
+    {
+        os << "uxr_agent_processing_latency_seconds{" << transport_labels << ",quantile=\"" << quantile << "\"} "
+           << to_seconds(processing_latency.value_at_quantile(quantile)) << '\n';
+    }
+    os << "uxr_agent_processing_latency_seconds_sum{" << transport_labels << "} "
+       << to_seconds(processing_latency.sum()) << '\n';
+    os << "uxr_agent_processing_latency_seconds_count{" << transport_labels << "} "
+       << processing_latency.count() << '\n';
+    write_family(os, "uxr_agent_processing_latency_max_seconds", "gauge", "Longest time taken to process an input packet.");
+    os << "uxr_agent_processing_latency_max_seconds{" << transport_labels << "} "
+       << to_seconds(processing_latency.max()) << '\n';
+}
+
+} // namespace uxr
+} // namespace eprosima
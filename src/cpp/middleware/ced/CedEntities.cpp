@@ -26,6 +26,7 @@ namespace uxr {
 std::unordered_map<uint32_t, OnNewDomain> CedTopicManager::on_new_domain_map_;
 std::unordered_map<uint32_t, OnNewTopic> CedTopicManager::on_new_topic_map_;
 std::unordered_map<int16_t, std::unordered_map<std::string, std::weak_ptr<CedGlobalTopic>>> CedTopicManager::topics_;
+std::unordered_map<std::string, uint16_t> CedTopicManager::history_depths_;
 std::mutex CedTopicManager::mtx_;
 
 void CedTopicManager::register_on_new_domain_cb(
@@ -96,7 +97,9 @@ bool CedTopicManager::register_topic(
         {
             cb_topic.second(domain_id, topic_name);
         }
-        topic = std::make_shared<CedGlobalTopic>(topic_name, domain_id);
+        auto it_depth = history_depths_.find(topic_name);
+        topic = std::make_shared<CedGlobalTopic>(
+            topic_name, domain_id, (history_depths_.end() != it_depth) ? it_depth->second : CED_HISTORY_DEPTH);
         topics_[domain_id].emplace(topic_name, topic);
     }
     else
@@ -107,6 +110,14 @@ bool CedTopicManager::register_topic(
     return true;
 }
 
+void CedTopicManager::set_history_depth(
+        const std::string& topic_name,
+        uint16_t history_depth)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    history_depths_[topic_name] = history_depth;
+}
+
 bool CedTopicManager::unregister_topic(
         const std::string& topic_name,
         int16_t domain_id)
@@ -136,12 +147,31 @@ bool CedTopicManager::unregister_topic(
 /**********************************************************************************************************************
  * CedTopicCloud
  **********************************************************************************************************************/
+/*
+ * The history is indexed by the sequence number modulo its depth, so the depth shall divide the range of the
+ * sequence numbers, and it shall keep the whole history comparable.
+ */
+static size_t round_history_depth(
+        uint16_t history_depth)
+{
+    size_t depth = 1;
+    while ((depth < history_depth) && (depth < MAX_STREAM_DEPTH))
+    {
+        depth <<= 1;
+    }
+    return depth;
+}
+
 CedGlobalTopic::CedGlobalTopic(
         const std::string& topic_name,
-        int16_t domain_id)
+        int16_t domain_id,
+        uint16_t history_depth)
     : name_(topic_name)
     , domain_id_(domain_id)
+    , history_(round_history_depth(history_depth))
+    , mask_(uint16_t(history_.size() - 1))
     , last_write_(UINT16_MAX)
+    , waiters_(0)
 {
 }
 
@@ -155,8 +185,16 @@ const std::string& CedGlobalTopic::name() const
     return name_;
 }
 
+/*
+ * The sample is published into its slot before the sequence number, so readers never take write_mtx_ and
+ * writers only wait for each other. The slots go through the shared_ptr overloads of std::atomic_store and
+ * std::atomic_load, which are not lock-free: they lock a mutex picked by address from a small global pool, so
+ * a reader still contends, for a reference count update, with the writer of its slot and with any other
+ * shared_ptr hashed to the same mutex. Blocked readers are woken up only when there are any.
+ */
 bool CedGlobalTopic::write(
-        const std::vector<uint8_t>& data,
+        const uint8_t* data,
+        size_t length,
         WriteAccess write_access,
         TopicSource topic_src,
         uint8_t& errcode)
@@ -164,13 +202,29 @@ bool CedGlobalTopic::write(
     bool rv = false;
     if (check_write_access(write_access, topic_src))
     {
-        std::unique_lock<std::mutex> lock(mtx_);
-        size_t index = uint16_t(last_write_ + 1) % history_.size();
-        history_[index] = data;
-        srcs_[index] = topic_src;
-        ++last_write_;
-        lock.unlock();
-        cv_.notify_all();
+        std::shared_ptr<Sample> sample = std::make_shared<Sample>();
+        sample->src = topic_src;
+        sample->data.assign(data, data + length);
+
+        {
+            std::lock_guard<std::mutex> write_lock(write_mtx_);
+            const uint16_t seq_num = uint16_t(last_write_.load() + 1);
+            sample->seq_num = seq_num;
+            std::atomic_store(&history_[seq_num & mask_], SamplePtr(std::move(sample)));
+            last_write_.store(seq_num);
+        }
+
+        if (0 < waiters_.load())
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            cv_.notify_all();
+        }
+
+        std::lock_guard<std::mutex> listeners_lock(listeners_mtx_);
+        for (const auto& listener : listeners_)
+        {
+            listener.second();
+        }
         errcode = 0;
         rv = true;
     }
@@ -184,38 +238,65 @@ bool CedGlobalTopic::read(
         ReadAccess read_access,
         uint8_t& errcode)
 {
-    bool rv = false;
-    std::unique_lock<std::mutex> lock(mtx_);
-    if (last_read != last_write_)
+    bool rv = get_data(data, last_read, read_access);
+    if (!rv && (std::chrono::milliseconds(0) < timeout))
     {
-        /* Fix last_read. */
-        if ((last_read <= (last_write_ - int(history_.size()))) || (last_read > last_write_))
-        {
-            last_read = last_write_ - int(history_.size());
-        }
+        /* Writers check the waiters after publishing, so either they notify or the wait sees their sample. */
+        std::unique_lock<std::mutex> lock(mtx_);
+        waiters_.fetch_add(1);
+        rv = cv_.wait_for(lock, timeout, [&](){ return get_data(data, last_read, read_access); });
+        waiters_.fetch_sub(1);
+    }
 
-        /* Try to read data without timeout. */
-        do
-        {
-            rv = get_data(data, last_read, read_access);
-        } while(!rv && (last_read != last_write_));
+    if (!rv)
+    {
+        errcode = 1;
     }
+    return rv;
+}
 
-    if (!rv && (last_read == last_write_))
+bool CedGlobalTopic::read_seq(
+        dds::xrce::SampleDataSeq& samples,
+        size_t max_samples,
+        size_t max_bytes,
+        std::chrono::milliseconds timeout,
+        SeqNum& last_read,
+        ReadAccess read_access,
+        uint8_t& errcode)
+{
+    samples.resize(1);
+    bool rv = read(samples.front().serialized_data(), timeout, last_read, read_access, errcode);
+    if (rv)
     {
-        /* Try to read data with timeout in case. */
-        auto now = std::chrono::steady_clock::now();
-        if (cv_.wait_until(lock, now + std::chrono::milliseconds(timeout), [&](){
-                           return last_read != last_write_ && get_data(data, last_read, read_access); }))
-        {
-            rv = true;
-        }
-        else
+        size_t bytes = samples.front().serialized_data().size() + 8;
+        bool fits = true;
+
+        /* Take the following samples as long as they fit, the first one that does not is left unread. */
+        SeqNum next_read = last_read;
+        SamplePtr sample;
+        while (fits && (samples.size() < max_samples) && take_next(next_read, sample))
         {
-            errcode = 1;
+            if (!check_read_access(read_access, sample->src))
+            {
+                last_read = next_read;
+            }
+            else if ((bytes + sample->data.size() + 8) <= max_bytes)
+            {
+                bytes += sample->data.size() + 8;
+                samples.emplace_back();
+                samples.back().serialized_data().assign(sample->data.begin(), sample->data.end());
+                last_read = next_read;
+            }
+            else
+            {
+                fits = false;
+            }
         }
     }
-
+    else
+    {
+        samples.clear();
+    }
     return rv;
 }
 
@@ -230,11 +311,11 @@ bool CedGlobalTopic::check_write_access(
 
 bool CedGlobalTopic::check_read_access(
         ReadAccess read_access,
-        size_t index)
+        TopicSource topic_src)
 {
     return (ReadAccess::COMPLETE == read_access) ||
-           ((ReadAccess::INTERNAL == read_access) && (TopicSource::INTERNAL == srcs_[index])) ||
-           ((ReadAccess::EXTERNAL == read_access) && (TopicSource::EXTERNAL == srcs_[index]));
+           ((ReadAccess::INTERNAL == read_access) && (TopicSource::INTERNAL == topic_src)) ||
+           ((ReadAccess::EXTERNAL == read_access) && (TopicSource::EXTERNAL == topic_src));
 }
 
 bool CedGlobalTopic::get_data(
@@ -243,15 +324,72 @@ bool CedGlobalTopic::get_data(
         ReadAccess read_access)
 {
     bool rv = false;
-    size_t index = uint16_t(++last_read) % history_.size();
-    if (check_read_access(read_access, index))
+    SamplePtr sample;
+    while (!rv && take_next(last_read, sample))
     {
-        data.assign(history_[index].begin(), history_[index].end());
-        rv = true;
+        if (check_read_access(read_access, sample->src))
+        {
+            data.assign(sample->data.begin(), sample->data.end());
+            rv = true;
+        }
+    }
+    return rv;
+}
+
+/*
+ * Takes the sample following last_read and moves last_read to it. A reader overrun by the writers resumes
+ * from the oldest sample in the history.
+ */
+bool CedGlobalTopic::take_next(
+        SeqNum& last_read,
+        SamplePtr& sample)
+{
+    bool rv = false;
+    bool overrun = true;
+    while (overrun)
+    {
+        const SeqNum last_write = last_write_.load();
+        const SeqNum oldest = last_write - int(history_.size());
+        if ((last_read <= oldest) || (last_read > last_write))
+        {
+            last_read = oldest;
+        }
+
+        overrun = false;
+        if (last_read != last_write)
+        {
+            const SeqNum next_read = last_read + 1;
+            sample = std::atomic_load(&history_[uint16_t(next_read) & mask_]);
+            if (sample && (next_read == sample->seq_num))
+            {
+                last_read = next_read;
+                rv = true;
+            }
+            else
+            {
+                /* The slot was written again after loading last_write. */
+                overrun = sample && (sample->seq_num > next_read);
+            }
+        }
     }
     return rv;
 }
 
+void CedGlobalTopic::add_listener(
+        const void* reader,
+        const std::function<void ()>& on_data_available)
+{
+    std::lock_guard<std::mutex> lock(listeners_mtx_);
+    listeners_[reader] = on_data_available;
+}
+
+void CedGlobalTopic::remove_listener(
+        const void* reader)
+{
+    std::lock_guard<std::mutex> lock(listeners_mtx_);
+    listeners_.erase(reader);
+}
+
 
 /**********************************************************************************************************************
  * CedParticipant
@@ -300,12 +438,25 @@ bool CedDataWriter::write(
         const std::vector<uint8_t>& data,
         uint8_t& errcode) const
 {
-    return topic_->get_global_topic()->write(data, write_access_, topic_src_, errcode);
+    return write(data.data(), data.size(), errcode);
+}
+
+bool CedDataWriter::write(
+        const uint8_t* data,
+        size_t length,
+        uint8_t& errcode) const
+{
+    return topic_->get_global_topic()->write(data, length, write_access_, topic_src_, errcode);
 }
 
 /**********************************************************************************************************************
  * CedDataReader
  **********************************************************************************************************************/
+CedDataReader::~CedDataReader()
+{
+    topic_->get_global_topic()->remove_listener(this);
+}
+
 bool CedDataReader::read(
         std::vector<uint8_t>& data,
         std::chrono::milliseconds timeout,
@@ -314,5 +465,22 @@ bool CedDataReader::read(
     return topic_->get_global_topic()->read(data, timeout, last_read_, read_access_, errcode);
 }
 
+bool CedDataReader::read_seq(
+        dds::xrce::SampleDataSeq& samples,
+        size_t max_samples,
+        size_t max_bytes,
+        std::chrono::milliseconds timeout,
+        uint8_t& errcode)
+{
+    return topic_->get_global_topic()->read_seq(
+        samples, max_samples, max_bytes, timeout, last_read_, read_access_, errcode);
+}
+
+void CedDataReader::set_listener(
+        const std::function<void ()>& on_data_available)
+{
+    topic_->get_global_topic()->add_listener(this, on_data_available);
+}
+
 } // namespace uxr
 } // namespace eprosima
@@ -352,13 +352,21 @@ bool CedMiddleware::delete_datareader(uint16_t datareader_id)
 bool CedMiddleware::write_data(
         uint16_t datawriter_id,
         const std::vector<uint8_t>& data)
+{
+    return write_raw_data(datawriter_id, data.data(), data.size());
+}
+
+bool CedMiddleware::write_raw_data(
+        uint16_t datawriter_id,
+        const uint8_t* data,
+        size_t length)
 {
     bool rv = false;
     auto it = datawriters_.find(datawriter_id);
     if (datawriters_.end() != it)
     {
         uint8_t errcode;
-        rv = it->second->write(data, errcode);
+        rv = it->second->write(data, length, errcode);
     }
     return rv;
 }
@@ -378,6 +386,37 @@ bool CedMiddleware::read_data(
     return rv;
 }
 
+bool CedMiddleware::read_data_seq(
+        uint16_t datareader_id,
+        dds::xrce::SampleDataSeq& samples,
+        size_t max_samples,
+        size_t max_bytes,
+        std::chrono::milliseconds timeout)
+{
+    bool rv = false;
+    auto it = datareaders_.find(datareader_id);
+    if (datareaders_.end() != it)
+    {
+        uint8_t errcode;
+        rv = it->second->read_seq(samples, max_samples, max_bytes, timeout, errcode);
+    }
+    return rv;
+}
+
+bool CedMiddleware::set_datareader_listener(
+        uint16_t datareader_id,
+        const std::function<void ()>& on_data_available)
+{
+    bool rv = false;
+    auto it = datareaders_.find(datareader_id);
+    if (datareaders_.end() != it)
+    {
+        it->second->set_listener(on_data_available);
+        rv = true;
+    }
+    return rv;
+}
+
 /**********************************************************************************************************************
  * Matched functions.
  **********************************************************************************************************************/
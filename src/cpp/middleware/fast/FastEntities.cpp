@@ -239,14 +239,31 @@ bool FastDataWriter::match(
 bool FastDataWriter::write(
         const std::vector<uint8_t>& data)
 {
-    return impl_->write(&const_cast<std::vector<uint8_t>&>(data));
+    return write(data.data(), data.size());
 }
 
 bool FastDataWriter::write(
         const std::vector<uint8_t>& data,
         fastrtps::rtps::WriteParams& wparams)
 {
-    return impl_->write(&const_cast<std::vector<uint8_t>&>(data), wparams);
+    return write(data.data(), data.size(), wparams);
+}
+
+bool FastDataWriter::write(
+        const uint8_t* data,
+        size_t length)
+{
+    TopicPubSubType::Sample sample{data, length};
+    return impl_->write(&sample);
+}
+
+bool FastDataWriter::write(
+        const uint8_t* data,
+        size_t length,
+        fastrtps::rtps::WriteParams& wparams)
+{
+    TopicPubSubType::Sample sample{data, length};
+    return impl_->write(&sample, wparams);
 }
 
 const fastrtps::rtps::GUID_t& FastDataWriter::get_guid() const
@@ -297,7 +314,12 @@ bool FastDataReader::read(
     if (impl_->wait_for_unread_samples(tm))
     {
         fastrtps::SampleInfo_t info;
-        rv = impl_->takeNextData(&data, &info);
+        TopicPubSubType::Sample sample;
+        rv = impl_->takeNextData(&sample, &info);
+        if (rv)
+        {
+            sample.take(data);
+        }
     }
     return rv;
 }
@@ -312,7 +334,12 @@ bool FastDataReader::read(
         {int32_t(timeout.count() / 1000), uint32_t(timeout.count() * 1000000)};
     if (impl_->wait_for_unread_samples(tm))
     {
-        rv = impl_->takeNextData(&data, &info);
+        TopicPubSubType::Sample sample;
+        rv = impl_->takeNextData(&sample, &info);
+        if (rv)
+        {
+            sample.take(data);
+        }
     }
     return rv;
 }
@@ -514,10 +541,9 @@ bool FastReplier::write(
     fastrtps::rtps::WriteParams wparams;
     transport_sample_identity(sample_identity, wparams.related_sample_identity());
 
-    std::vector<uint8_t> output_data(data.size() - deserializer.getSerializedDataLength());
-    deserializer.deserializeArray(output_data.data(), output_data.size());
+    const size_t identity_size = deserializer.getSerializedDataLength();
 
-    return datawriter_->write(output_data, wparams);
+    return datawriter_->write(data.data() + identity_size, data.size() - identity_size, wparams);
 }
 
 bool FastReplier::read(
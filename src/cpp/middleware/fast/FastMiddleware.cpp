@@ -678,12 +678,20 @@ bool FastMiddleware::delete_replier(
 bool FastMiddleware::write_data(
         uint16_t datawriter_id,
         const std::vector<uint8_t>& data)
+{
+    return write_raw_data(datawriter_id, data.data(), data.size());
+}
+
+bool FastMiddleware::write_raw_data(
+        uint16_t datawriter_id,
+        const uint8_t* data,
+        size_t length)
 {
     bool rv = false;
     auto it = datawriters_.find(datawriter_id);
     if (datawriters_.end() != it)
     {
-        rv = it->second->write(data);
+        rv = it->second->write(data, length);
     }
     return rv;
 }
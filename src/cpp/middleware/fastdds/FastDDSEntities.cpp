@@ -974,7 +974,13 @@ bool FastDDSDataWriter::match_from_bin(const dds::xrce::OBJK_DataWriter_Binary&
 
 bool FastDDSDataWriter::write(const std::vector<uint8_t>& data)
 {
-    return ptr_->write(&const_cast<std::vector<uint8_t>&>(data));
+    return write(data.data(), data.size());
+}
+
+bool FastDDSDataWriter::write(const uint8_t* data, size_t length)
+{
+    TopicPubSubType::Sample sample{data, length};
+    return ptr_->write(&sample);
 }
 
 const fastdds::dds::DataWriter* FastDDSDataWriter::ptr() const
@@ -992,6 +998,7 @@ const fastdds::dds::DomainParticipant* FastDDSDataWriter::participant() const
  **********************************************************************************************************************/
 FastDDSDataReader::~FastDDSDataReader()
 {
+    set_listener(nullptr);
     if (ptr_)
     {
         subscriber_->delete_datareader(ptr_);
@@ -1010,7 +1017,8 @@ bool FastDDSDataReader::create_by_ref(const std::string& ref)
                 fastdds::dds::DataReaderQos qos;
                 set_qos_from_attributes(qos, attrs);
 
-                ptr_ = subscriber_->create_datareader(topic_->get_ptr(), qos);
+                ptr_ = subscriber_->create_datareader(
+                    topic_->get_ptr(), qos, this, fastdds::dds::StatusMask::data_available());
                 rv = (nullptr != ptr_);
             }
         }
@@ -1030,7 +1038,8 @@ bool FastDDSDataReader::create_by_xml(const std::string& xml)
                 fastdds::dds::DataReaderQos qos;
                 set_qos_from_attributes(qos, attrs);
 
-                ptr_ = subscriber_->create_datareader(topic_->get_ptr(), qos);
+                ptr_ = subscriber_->create_datareader(
+                    topic_->get_ptr(), qos, this, fastdds::dds::StatusMask::data_available());
                 rv = (nullptr != ptr_);
             }
         }
@@ -1048,7 +1057,8 @@ bool FastDDSDataReader::create_by_bin(
         if(topic_){
             fastdds::dds::DataReaderQos qos = fastdds::dds::DATAREADER_QOS_DEFAULT;
             set_qos_from_xrce_object(qos, datareader_xrce);
-            ptr_ = subscriber_->create_datareader(topic_->get_ptr(), qos);
+            ptr_ = subscriber_->create_datareader(
+                topic_->get_ptr(), qos, this, fastdds::dds::StatusMask::data_available());
             rv = (nullptr != ptr_) && bool(topic_);
         }
     }
@@ -1110,15 +1120,55 @@ bool FastDDSDataReader::read(
 
     bool rv = false;
 
-    fastrtps::Duration_t d((long double) timeout.count()/1000.0);
+    if (held_)
+    {
+        /* Already filtered by the middleware, so it carries no writer. */
+        data = std::move(held_data_);
+        sample_info = fastdds::dds::SampleInfo();
+        held_ = false;
+        rv = true;
+    }
+    else
+    {
+        fastrtps::Duration_t d((long double) timeout.count()/1000.0);
 
-    if(ptr_->wait_for_unread_message(d)){
-        rv = ReturnCode_t::RETCODE_OK == ptr_->take_next_sample(&data, &sample_info);
+        if(ptr_->wait_for_unread_message(d)){
+            TopicPubSubType::Sample sample;
+            rv = ReturnCode_t::RETCODE_OK == ptr_->take_next_sample(&sample, &sample_info);
+            if (rv)
+            {
+                sample.take(data);
+            }
+        }
     }
 
     return rv;
 }
 
+void FastDDSDataReader::hold(
+        std::vector<uint8_t>&& data)
+{
+    held_data_ = std::move(data);
+    held_ = true;
+}
+
+void FastDDSDataReader::set_listener(
+        const std::function<void ()>& on_data_available)
+{
+    std::lock_guard<std::mutex> lock(listener_mtx_);
+    on_data_available_ = on_data_available;
+}
+
+void FastDDSDataReader::on_data_available(
+        fastdds::dds::DataReader* /*reader*/)
+{
+    std::lock_guard<std::mutex> lock(listener_mtx_);
+    if (on_data_available_)
+    {
+        on_data_available_();
+    }
+}
+
 const fastdds::dds::DataReader* FastDDSDataReader::ptr() const
 {
     return ptr_;
@@ -1239,7 +1289,8 @@ bool FastDDSRequester::write(
     try
     {
         fastrtps::rtps::WriteParams wparams;
-        rv = datawriter_ptr_->write(&const_cast<std::vector<uint8_t>&>(data), wparams);
+        TopicPubSubType::Sample sample{data.data(), data.size()};
+        rv = datawriter_ptr_->write(&sample, wparams);
         if (rv)
         {
             int64_t sequence = (int64_t)wparams.sample_identity().sequence_number().high << 32;
@@ -1267,7 +1318,12 @@ bool FastDDSRequester::read(
     fastrtps::Duration_t d((long double) timeout.count()/1000.0);
 
     if(datareader_ptr_->wait_for_unread_message(d)){
-        rv = ReturnCode_t::RETCODE_OK == datareader_ptr_->take_next_sample(&data, &info);
+        TopicPubSubType::Sample sample;
+        rv = ReturnCode_t::RETCODE_OK == datareader_ptr_->take_next_sample(&sample, &info);
+        if (rv)
+        {
+            sample.take(data);
+        }
     }
 
     if (rv)
@@ -1438,10 +1494,10 @@ bool FastDDSReplier::write(
     fastrtps::rtps::WriteParams wparams;
     transport_sample_identity(sample_identity, wparams.related_sample_identity());
 
-    std::vector<uint8_t> output_data(data.size() - deserializer.getSerializedDataLength());
-    deserializer.deserializeArray(output_data.data(), output_data.size());
+    const size_t identity_size = deserializer.getSerializedDataLength();
+    TopicPubSubType::Sample sample{data.data() + identity_size, data.size() - identity_size};
 
-    return datawriter_ptr_->write(&const_cast<std::vector<uint8_t>&>(output_data), wparams);
+    return datawriter_ptr_->write(&sample, wparams);
 }
 
 void FastDDSReplier::transform_sample_identity(
@@ -1474,7 +1530,12 @@ bool FastDDSReplier::read(
     fastrtps::Duration_t d((long double) timeout.count()/1000.0);
 
     if(datareader_ptr_->wait_for_unread_message(d)){
-        rv = ReturnCode_t::RETCODE_OK == datareader_ptr_->take_next_sample(&temp_data, &info);
+        TopicPubSubType::Sample sample;
+        rv = ReturnCode_t::RETCODE_OK == datareader_ptr_->take_next_sample(&sample, &info);
+        if (rv)
+        {
+            sample.take(temp_data);
+        }
     }
 
     if (rv)
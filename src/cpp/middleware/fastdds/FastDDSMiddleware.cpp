@@ -309,6 +309,7 @@ bool FastDDSMiddleware::create_datawriter_by_ref(
             rv = emplace_res.second;
             if (rv)
             {
+                datawriter_guids_.insert(emplace_res.first->second->guid());
                 callback_factory_.execute_callbacks(Middleware::Kind::FASTDDS,
                     middleware::CallbackKind::CREATE_DATAWRITER,
                     **it_publisher->second->get_participant(),
@@ -335,6 +336,7 @@ bool FastDDSMiddleware::create_datawriter_by_xml(
             rv = emplace_res.second;
             if (rv)
             {
+                datawriter_guids_.insert(emplace_res.first->second->guid());
                 callback_factory_.execute_callbacks(Middleware::Kind::FASTDDS,
                     middleware::CallbackKind::CREATE_DATAWRITER,
                     **it_publisher->second->get_participant(),
@@ -364,6 +366,7 @@ bool FastDDSMiddleware::create_datawriter_by_bin(
                 rv = emplace_res.second;
                 if (rv)
                 {
+                    datawriter_guids_.insert(emplace_res.first->second->guid());
                     callback_factory_.execute_callbacks(Middleware::Kind::FASTDDS,
                         middleware::CallbackKind::CREATE_DATAWRITER,
                         **it_publisher->second->get_participant(),
@@ -498,6 +501,7 @@ bool FastDDSMiddleware::create_requester_by_ref(
             rv = emplace_res.second;
             if (rv)
             {
+                requester_guids_.insert(emplace_res.first->second->guid_datawriter());
                 callback_factory_.execute_callbacks(Middleware::Kind::FASTDDS,
                     middleware::CallbackKind::CREATE_REQUESTER,
                     participant->get_ptr(),
@@ -531,6 +535,7 @@ bool FastDDSMiddleware::create_requester_by_xml(
             rv = emplace_res.second;
             if (rv)
             {
+                requester_guids_.insert(emplace_res.first->second->guid_datawriter());
                 callback_factory_.execute_callbacks(Middleware::Kind::FASTDDS,
                     middleware::CallbackKind::CREATE_REQUESTER,
                     participant->get_ptr(),
@@ -579,6 +584,7 @@ bool FastDDSMiddleware::create_requester_by_bin(
         rv = emplace_res.second;
         if (rv)
         {
+            requester_guids_.insert(emplace_res.first->second->guid_datawriter());
             callback_factory_.execute_callbacks(Middleware::Kind::FASTDDS,
                 middleware::CallbackKind::CREATE_REQUESTER,
                 participant->get_ptr(),
@@ -630,6 +636,7 @@ bool FastDDSMiddleware::create_replier_by_ref(
             rv = emplace_res.second;
             if (rv)
             {
+                replier_guids_.insert(emplace_res.first->second->guid_datawriter());
                 callback_factory_.execute_callbacks(Middleware::Kind::FASTDDS,
                     middleware::CallbackKind::CREATE_REPLIER,
                     participant->get_ptr(),
@@ -663,6 +670,7 @@ bool FastDDSMiddleware::create_replier_by_xml(
             rv = emplace_res.second;
             if (rv)
             {
+                replier_guids_.insert(emplace_res.first->second->guid_datawriter());
                 callback_factory_.execute_callbacks(Middleware::Kind::FASTDDS,
                     middleware::CallbackKind::CREATE_REPLIER,
                     participant->get_ptr(),
@@ -711,6 +719,7 @@ bool FastDDSMiddleware::create_replier_by_bin(
         rv = emplace_res.second;
         if (rv)
         {
+            replier_guids_.insert(emplace_res.first->second->guid_datawriter());
             callback_factory_.execute_callbacks(Middleware::Kind::FASTDDS,
                 middleware::CallbackKind::CREATE_REPLIER,
                 participant->get_ptr(),
@@ -778,6 +787,7 @@ bool FastDDSMiddleware::delete_datawriter(
             datawriter->participant(),
             datawriter->ptr());
 
+        datawriter_guids_.erase(datawriter->guid());
         datawriters_.erase(datawriter_id);
         return true;
     }
@@ -821,6 +831,7 @@ bool FastDDSMiddleware::delete_requester(
             requester->get_request_datawriter(),
             requester->get_reply_datareader());
 
+        requester_guids_.erase(requester->guid_datawriter());
         requesters_.erase(requester_id);
         return true;
     }
@@ -843,6 +854,7 @@ bool FastDDSMiddleware::delete_replier(
             replier->get_reply_datawriter(),
             replier->get_request_datareader());
 
+        replier_guids_.erase(replier->guid_datawriter());
         repliers_.erase(replier_id);
         return true;
     }
@@ -854,12 +866,20 @@ bool FastDDSMiddleware::delete_replier(
 bool FastDDSMiddleware::write_data(
         uint16_t datawriter_id,
         const std::vector<uint8_t>& data)
+{
+   return write_raw_data(datawriter_id, data.data(), data.size());
+}
+
+bool FastDDSMiddleware::write_raw_data(
+        uint16_t datawriter_id,
+        const uint8_t* data,
+        size_t length)
 {
    bool rv = false;
    auto it = datawriters_.find(datawriter_id);
    if (datawriters_.end() != it)
    {
-       rv = it->second->write(data);
+       rv = it->second->write(data, length);
    }
    return rv;
 }
@@ -901,23 +921,69 @@ bool FastDDSMiddleware::read_data(
    if (datareaders_.end() != it)
    {
        fastdds::dds::SampleInfo sample_info;
-       rv = it->second->read(data, timeout, sample_info);
-
-       if (intraprocess_enabled_)
+       bool sample_read = it->second->read(data, timeout, sample_info);
+       while (sample_read && !rv)
        {
-            for (auto dw = datawriters_.begin(); dw != datawriters_.end(); dw++)
+            rv = !intraprocess_enabled_ || (0 == datawriter_guids_.count(sample_info.sample_identity.writer_guid()));
+
+            /* Skip the samples written by this agent, so false only means there is no data to deliver. */
+            if (!rv)
             {
-                if (dw->second->guid() == sample_info.sample_identity.writer_guid())
-                {
-                    rv = false;
-                    break;
-                }
+                sample_read = it->second->read(data, std::chrono::milliseconds(0), sample_info);
             }
        }
    }
    return rv;
 }
 
+bool FastDDSMiddleware::read_data_seq(
+        uint16_t datareader_id,
+        dds::xrce::SampleDataSeq& samples,
+        size_t max_samples,
+        size_t max_bytes,
+        std::chrono::milliseconds timeout)
+{
+    samples.clear();
+    auto it = datareaders_.find(datareader_id);
+    if (datareaders_.end() != it)
+    {
+        std::vector<uint8_t> data;
+        size_t bytes = 0;
+        bool fits = true;
+        while (fits && (samples.size() < max_samples) &&
+               read_data(datareader_id, data, samples.empty() ? timeout : std::chrono::milliseconds(0)))
+        {
+            /* A taken sample cannot be returned to the reader, so the one that does not fit waits for the next read. */
+            if (samples.empty() || ((bytes + data.size() + 8) <= max_bytes))
+            {
+                bytes += data.size() + 8;
+                samples.emplace_back();
+                samples.back().serialized_data(std::move(data));
+            }
+            else
+            {
+                it->second->hold(std::move(data));
+                fits = false;
+            }
+        }
+    }
+    return !samples.empty();
+}
+
+bool FastDDSMiddleware::set_datareader_listener(
+        uint16_t datareader_id,
+        const std::function<void ()>& on_data_available)
+{
+    bool rv = false;
+    auto it = datareaders_.find(datareader_id);
+    if (datareaders_.end() != it)
+    {
+        it->second->set_listener(on_data_available);
+        rv = true;
+    }
+    return rv;
+}
+
 bool FastDDSMiddleware::read_request(
         uint16_t replier_id,
         std::vector<uint8_t>& data,
@@ -928,20 +994,8 @@ bool FastDDSMiddleware::read_request(
    if (repliers_.end() != it)
    {
         fastdds::dds::SampleInfo sample_info;
-        rv = it->second->read(data, timeout, sample_info);
-
-        if (intraprocess_enabled_)
-        {
-            for (auto rq = requesters_.begin(); rq != requesters_.end(); rq++)
-            {
-                if (rq->second->guid_datawriter() == sample_info.sample_identity.writer_guid())
-                {
-                    rv = false;
-                    break;
-                }
-            }
-        }
-
+        rv = it->second->read(data, timeout, sample_info) &&
+             (!intraprocess_enabled_ || (0 == requester_guids_.count(sample_info.sample_identity.writer_guid())));
    }
    return rv;
 }
@@ -957,19 +1011,8 @@ bool FastDDSMiddleware::read_reply(
    if (requesters_.end() != it)
    {
        fastdds::dds::SampleInfo sample_info;
-       rv = it->second->read(sequence_number, data, timeout, sample_info);
-
-       if (intraprocess_enabled_)
-        {
-            for (auto rp = repliers_.begin(); rp != repliers_.end(); rp++)
-            {
-                if (rp->second->guid_datawriter() == sample_info.sample_identity.writer_guid())
-                {
-                    rv = false;
-                    break;
-                }
-            }
-        }
+       rv = it->second->read(sequence_number, data, timeout, sample_info) &&
+            (!intraprocess_enabled_ || (0 == replier_guids_.count(sample_info.sample_identity.writer_guid())));
    }
    return rv;
 }
@@ -20,6 +20,7 @@
 #include <uxr/agent/Root.hpp>
 #include <uxr/agent/transport/Server.hpp>
 #include <uxr/agent/utils/Time.hpp>
+#include <uxr/agent/types/DataPayloadView.hpp>
 
 #include <uxr/agent/transport/endpoint/IPv4EndPoint.hpp>
 #include <uxr/agent/transport/endpoint/IPv6EndPoint.hpp>
@@ -302,7 +303,7 @@ bool Processor<EndPoint>::process_create_client_submessage(
 
             OutputPacket<EndPoint> output_packet;
             output_packet.destination = input_packet.source;
-            output_packet.message = std::shared_ptr<OutputMessage>(new OutputMessage(status_header, message_size));
+            output_packet.message = OutputMessagePtr(new OutputMessage(status_header, message_size));
             output_packet.message->append_submessage(dds::xrce::STATUS_AGENT, status_agent);
 
             server_.push_output_packet(std::move(output_packet));
@@ -444,11 +445,17 @@ bool Processor<EndPoint>::process_write_data_submessage(
     {
         case dds::xrce::FORMAT_DATA_FLAG:
         {
-            dds::xrce::WRITE_DATA_Payload_Data data_payload;
-            data_payload.data().resize(submessage_length - data_payload.BaseObjectRequest::getCdrSerializedSize(0));
-            if (input_packet.message->get_payload(data_payload))
+            /* The sample is read in place from the message buffer, so a datawriter hands it to the middleware
+               without any intermediate copy. */
+            dds::xrce::BaseObjectRequest base_request;
+            const size_t base_size = base_request.getCdrSerializedSize(0);
+            const uint8_t* data = nullptr;
+            size_t data_length = (base_size <= submessage_length) ? (submessage_length - base_size) : 0;
+            if ((base_size <= submessage_length) &&
+                input_packet.message->get_payload(base_request) &&
+                input_packet.message->get_payload_view(data, data_length))
             {
-                const dds::xrce::ObjectId& object_id = data_payload.object_id();
+                const dds::xrce::ObjectId& object_id = base_request.object_id();
                 switch (object_id[1] & 0x0F)
                 {
                     case dds::xrce::OBJK_DATAWRITER:
@@ -457,7 +464,7 @@ bool Processor<EndPoint>::process_write_data_submessage(
                                 std::dynamic_pointer_cast<DataWriter>(client.get_object(object_id));
                         if (nullptr != data_writer)
                         {
-                            written = data_writer->write(data_payload);
+                            written = data_writer->write(data, data_length);
                         }
                         break;
                     }
@@ -467,7 +474,9 @@ bool Processor<EndPoint>::process_write_data_submessage(
                                 std::dynamic_pointer_cast<Requester>(client.get_object(object_id));
                         if (nullptr != requester)
                         {
-                            written = requester->write(data_payload, data_payload.request_id());
+                            dds::xrce::WRITE_DATA_Payload_Data data_payload;
+                            data_payload.data().serialized_data().assign(data, data + data_length);
+                            written = requester->write(data_payload, base_request.request_id());
                         }
                         break;
                     }
@@ -477,6 +486,8 @@ bool Processor<EndPoint>::process_write_data_submessage(
                                 std::dynamic_pointer_cast<Replier>(client.get_object(object_id));
                         if (nullptr != replier)
                         {
+                            dds::xrce::WRITE_DATA_Payload_Data data_payload;
+                            data_payload.data().serialized_data().assign(data, data + data_length);
                             written = replier->write(data_payload);
                         }
                         break;
@@ -547,12 +558,14 @@ bool Processor<EndPoint>::process_read_data_submessage(
 
             using namespace std::placeholders;
             Reader<bool>::WriteFn write_fn = std::bind(&Processor::read_data_callback, this, _1, _2, _3);
+            DataReader::SeqReader::WriteFn write_seq_fn = std::bind(&Processor::read_data_seq_callback, this, _1, _2, _3);
             bool reading = false;
 
             switch (object_id[1] & 0x0F)
             {
                 case dds::xrce::OBJK_DATAREADER:
-                    reading = std::dynamic_pointer_cast<DataReader>(reader_object)->read(read_payload, write_fn, write_args);
+                    reading = std::dynamic_pointer_cast<DataReader>(reader_object)->read(
+                        read_payload, write_fn, write_seq_fn, write_args);
                     break;
                 case dds::xrce::OBJK_REQUESTER:
                     reading = std::dynamic_pointer_cast<Requester>(reader_object)->read(read_payload, write_fn, write_args);
@@ -636,7 +649,8 @@ bool Processor<EndPoint>::process_acknack_submessage(
             }
         }
 
-        client.session().update_from_acknack(stream_id, first_message);
+        const bool nacked = (0 != nack_bitmap.at(0)) || (0 != nack_bitmap.at(1));
+        client.session().update_from_acknack(stream_id, first_message, nacked);
     }
     else
     {
@@ -817,17 +831,43 @@ bool Processor<EndPoint>::read_data_callback(
         const std::vector<uint8_t>& buffer,
         std::chrono::milliseconds timeout)
 {
-    bool rv = false;
+    /* The sample is serialized straight from the reader buffer into the output messages. */
+    DataPayloadView data_payload(cb_args.request_id, cb_args.object_id, buffer.data(), buffer.size());
 
-    dds::xrce::DATA_Payload_Data data_payload;
-    data_payload.request_id(cb_args.request_id);
-    data_payload.object_id(cb_args.object_id);
-    data_payload.data().serialized_data(buffer);
+    return push_data_submessage(cb_args, data_payload, dds::xrce::FORMAT_DATA, timeout);
+}
+
+template<typename EndPoint>
+bool Processor<EndPoint>::read_data_seq_callback(
+        const WriteFnArgs& cb_args,
+        const dds::xrce::SampleDataSeq& samples,
+        std::chrono::milliseconds timeout)
+{
+    DataSeqPayloadView data_payload(cb_args.request_id, cb_args.object_id, samples);
+
+    return push_data_submessage(cb_args, data_payload, dds::xrce::FORMAT_DATA_SEQ, timeout);
+}
+
+template<typename EndPoint>
+template<typename T>
+bool Processor<EndPoint>::push_data_submessage(
+        const WriteFnArgs& cb_args,
+        const T& data_payload,
+        dds::xrce::DataFormat data_format,
+        std::chrono::milliseconds timeout)
+{
+    bool rv = false;
 
     OutputPacket<EndPoint> output_packet;
     if (server_.get_endpoint(conversion::clientkey_to_raw(cb_args.client_key), output_packet.destination))
     {
-        rv = cb_args.client->session().push_output_submessage(cb_args.stream_id, dds::xrce::DATA, data_payload, timeout);
+        rv = cb_args.client->session().push_output_submessage(
+            cb_args.stream_id,
+            dds::xrce::DATA,
+            data_payload,
+            timeout,
+            uint8_t(dds::xrce::FLAG_LITTLE_ENDIANNESS | data_format));
+        schedule_flush(cb_args.client, cb_args.stream_id);
 
         while (cb_args.client->session().get_next_output_message(cb_args.stream_id, output_packet.message))
         {
@@ -841,6 +881,63 @@ bool Processor<EndPoint>::read_data_callback(
     return rv;
 }
 
+template<typename EndPoint>
+void Processor<EndPoint>::schedule_flush(
+        const std::shared_ptr<ProxyClient>& client,
+        dds::xrce::StreamId stream_id)
+{
+    FlushRequest flush_request;
+    if (client->session().take_output_flush_request(stream_id, flush_request.deadline))
+    {
+        flush_request.client = client;
+        flush_request.stream_id = stream_id;
+
+        std::lock_guard<std::mutex> lock(flush_mtx_);
+        bool earliest = flush_requests_.empty() || (flush_request.deadline < flush_requests_.top().deadline);
+        flush_requests_.push(std::move(flush_request));
+        if (earliest)
+        {
+            flush_cv_.notify_one();
+        }
+    }
+}
+
+template<typename EndPoint>
+void Processor<EndPoint>::flush_output_streams(std::chrono::milliseconds timeout)
+{
+    std::vector<FlushRequest> due_requests;
+    std::unique_lock<std::mutex> lock(flush_mtx_);
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    if (!flush_requests_.empty() && (flush_requests_.top().deadline < deadline))
+    {
+        deadline = flush_requests_.top().deadline;
+    }
+    flush_cv_.wait_until(lock, deadline);
+
+    auto now = std::chrono::steady_clock::now();
+    while (!flush_requests_.empty() && (flush_requests_.top().deadline <= now))
+    {
+        due_requests.push_back(flush_requests_.top());
+        flush_requests_.pop();
+    }
+    lock.unlock();
+
+    OutputPacket<EndPoint> output_packet;
+    for (const auto& flush_request : due_requests)
+    {
+        std::shared_ptr<ProxyClient> client = flush_request.client.lock();
+        if (client &&
+            client->session().flush_output_stream(flush_request.stream_id, now) &&
+            server_.get_endpoint(conversion::clientkey_to_raw(client->get_client_key()), output_packet.destination))
+        {
+            while (client->session().get_next_output_message(flush_request.stream_id, output_packet.message))
+            {
+                server_.push_output_packet(std::move(output_packet));
+            }
+        }
+    }
+}
+
 template<typename EndPoint>
 bool Processor<EndPoint>::process_get_info_packet(
         InputPacket<EndPoint>&& input_packet,
@@ -973,8 +1070,9 @@ void Processor<EndPoint>::check_heartbeats()
 
     OutputPacket<EndPoint> output_packet;
 
-    std::shared_ptr<ProxyClient> client;
-    while (root_.get_next_client(client))
+    std::vector<std::shared_ptr<ProxyClient>> clients;
+    root_.get_clients(clients);
+    for (const auto& client : clients)
     {
         ProxyClient::State state = client->get_state();
         uint32_t raw_key = conversion::clientkey_to_raw(client->get_client_key());
@@ -0,0 +1,211 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/reader/ReaderExecutor.hpp>
+#include <uxr/agent/config.hpp>
+
+namespace eprosima {
+namespace uxr {
+
+ReaderExecutor& ReaderExecutor::get()
+{
+    /* Intentionally leaked, see the class description. */
+    static ReaderExecutor* instance = new ReaderExecutor(READER_WORKERS);
+    return *instance;
+}
+
+ReaderExecutor::ReaderExecutor(
+        size_t workers)
+    : workers_{}
+    , timer_thread_{}
+    , running_cond_(true)
+    , ready_{}
+    , ready_mtx_{}
+    , ready_cv_{}
+    , timers_{}
+    , timer_mtx_{}
+    , timer_cv_{}
+{
+    for (size_t i = 0; i < ((0 < workers) ? workers : 1); ++i)
+    {
+        workers_.emplace_back(&ReaderExecutor::worker_loop, this);
+    }
+    timer_thread_ = std::thread(&ReaderExecutor::timer_loop, this);
+}
+
+ReaderExecutor::~ReaderExecutor()
+{
+    {
+        std::lock_guard<std::mutex> ready_lock(ready_mtx_);
+        std::lock_guard<std::mutex> timer_lock(timer_mtx_);
+        running_cond_ = false;
+    }
+    ready_cv_.notify_all();
+    timer_cv_.notify_all();
+
+    for (auto& worker : workers_)
+    {
+        worker.join();
+    }
+    timer_thread_.join();
+}
+
+void ReaderExecutor::schedule(
+        const std::shared_ptr<Task>& task)
+{
+    bool push = false;
+    {
+        std::lock_guard<std::mutex> lock(task->mtx_);
+        if (!task->cancelled_)
+        {
+            if (task->running_)
+            {
+                task->notified_ = true;
+            }
+            else if (!task->queued_)
+            {
+                task->queued_ = true;
+                push = true;
+            }
+        }
+    }
+
+    if (push)
+    {
+        push_ready(task);
+    }
+}
+
+void ReaderExecutor::schedule_at(
+        const std::shared_ptr<Task>& task,
+        std::chrono::steady_clock::time_point time)
+{
+    if (time <= std::chrono::steady_clock::now())
+    {
+        schedule(task);
+    }
+    else if (std::chrono::steady_clock::time_point::max() != time)
+    {
+        std::unique_lock<std::mutex> lock(timer_mtx_);
+        const std::chrono::steady_clock::time_point earliest = timers_.empty()
+            ? std::chrono::steady_clock::time_point::max()
+            : timers_.earliest_expiration();
+        timers_.schedule(time, std::weak_ptr<Task>(task));
+        bool wake_up = timers_.earliest_expiration() < earliest;
+        lock.unlock();
+        if (wake_up)
+        {
+            timer_cv_.notify_one();
+        }
+    }
+}
+
+void ReaderExecutor::cancel(
+        const std::shared_ptr<Task>& task)
+{
+    std::unique_lock<std::mutex> lock(task->mtx_);
+    task->cancelled_ = true;
+    task->cv_.wait(lock, [&](){ return !task->running_ || (std::this_thread::get_id() == task->runner_); });
+}
+
+void ReaderExecutor::push_ready(
+        const std::shared_ptr<Task>& task)
+{
+    std::unique_lock<std::mutex> lock(ready_mtx_);
+    ready_.push_back(task);
+    lock.unlock();
+    ready_cv_.notify_one();
+}
+
+void ReaderExecutor::execute(
+        const std::shared_ptr<Task>& task)
+{
+    std::unique_lock<std::mutex> lock(task->mtx_);
+    task->queued_ = false;
+    if (!task->cancelled_)
+    {
+        task->running_ = true;
+        task->notified_ = false;
+        task->runner_ = std::this_thread::get_id();
+        lock.unlock();
+
+        task->run();
+
+        lock.lock();
+        task->running_ = false;
+        task->runner_ = std::thread::id();
+        bool again = task->notified_ && !task->cancelled_;
+        task->queued_ = again;
+        task->cv_.notify_all();
+        lock.unlock();
+
+        if (again)
+        {
+            push_ready(task);
+        }
+    }
+}
+
+void ReaderExecutor::worker_loop()
+{
+    std::shared_ptr<Task> task;
+    while (running_cond_)
+    {
+        std::unique_lock<std::mutex> lock(ready_mtx_);
+        ready_cv_.wait(lock, [&](){ return !running_cond_ || !ready_.empty(); });
+        if (!ready_.empty())
+        {
+            task = std::move(ready_.front());
+            ready_.pop_front();
+            lock.unlock();
+
+            execute(task);
+
+            /* The last references to the task, its reader and its client may be released here. */
+            task.reset();
+        }
+    }
+}
+
+void ReaderExecutor::timer_loop()
+{
+    std::vector<std::weak_ptr<Task>> expired;
+    while (running_cond_)
+    {
+        std::unique_lock<std::mutex> lock(timer_mtx_);
+        if (timers_.empty())
+        {
+            timer_cv_.wait(lock, [&](){ return !running_cond_ || !timers_.empty(); });
+        }
+        else
+        {
+            timer_cv_.wait_until(lock, timers_.earliest_expiration());
+        }
+        timers_.advance(std::chrono::steady_clock::now(), expired);
+        lock.unlock();
+
+        for (auto& timer : expired)
+        {
+            std::shared_ptr<Task> task = timer.lock();
+            if (task)
+            {
+                schedule(task);
+            }
+        }
+        expired.clear();
+    }
+}
+
+} // namespace uxr
+} // namespace eprosima
@@ -13,10 +13,12 @@
 // limitations under the License.
 
 #include <uxr/agent/transport/Server.hpp>
+#include <uxr/agent/transport/PacketDispatch.hpp>
 #include <uxr/agent/config.hpp>
 #include <uxr/agent/processor/Processor.hpp>
 #include <uxr/agent/Root.hpp>
 #include <uxr/agent/logger/Logger.hpp>
+#include <uxr/agent/utils/Conversion.hpp>
 
 #include <uxr/agent/transport/endpoint/IPv4EndPoint.hpp>
 #include <uxr/agent/transport/endpoint/IPv6EndPoint.hpp>
@@ -25,6 +27,8 @@
 #include <uxr/agent/transport/endpoint/MultiSerialEndPoint.hpp>
 #include <uxr/agent/transport/endpoint/CustomEndPoint.hpp>
 
+#include <algorithm>
+#include <chrono>
 #include <functional>
 
 #define RECEIVE_TIMEOUT 1000   // Milliseconds
@@ -39,16 +43,77 @@ extern template class Processor<SerialEndPoint>;
 extern template class Processor<MultiSerialEndPoint>;
 extern template class Processor<CustomEndPoint>;
 
+namespace {
+
+/* Labels the metrics of each transport by its kind of endpoint. */
+template<typename EndPoint>
+inline const char* get_transport_name();
+
+template<>
+inline const char* get_transport_name<IPv4EndPoint>()
+{
+    return "ipv4";
+}
+
+template<>
+inline const char* get_transport_name<IPv6EndPoint>()
+{
+    return "ipv6";
+}
+
+template<>
+inline const char* get_transport_name<CanEndPoint>()
+{
+    return "can";
+}
+
+template<>
+inline const char* get_transport_name<SerialEndPoint>()
+{
+    return "serial";
+}
+
+template<>
+inline const char* get_transport_name<MultiSerialEndPoint>()
+{
+    return "multiserial";
+}
+
+template<>
+inline const char* get_transport_name<CustomEndPoint>()
+{
+    return "custom";
+}
+
+template<typename Packet>
+inline size_t get_bytes(const std::vector<Packet>& packets)
+{
+    size_t rv = 0;
+    for (const auto& packet : packets)
+    {
+        rv += packet.message->get_len();
+    }
+    return rv;
+}
+
+} // unnamed namespace
+
 template<typename EndPoint>
-Server<EndPoint>::Server(Middleware::Kind middleware_kind)
+Server<EndPoint>::Server(
+        Middleware::Kind middleware_kind,
+        size_t io_batch_size)
     : processor_(new Processor<EndPoint>(*this, *root_, middleware_kind))
+    , io_batch_size_{(0 < io_batch_size) ? io_batch_size : 1}
+    , shards_{}
+    , processing_workers_{0}
+    , workers_{}
+    , topology_mtx_{}
     , running_cond_(false)
-    , input_scheduler_(SERVER_QUEUE_MAX_SIZE)
-    , output_scheduler_(SERVER_QUEUE_MAX_SIZE)
-    , transport_rc_{TransportRc::ok}
     , error_mtx_{}
     , error_cv_{}
-{}
+{
+    shards_.emplace_back(new Shard());
+}
 
 template<typename EndPoint>
 Server<EndPoint>::~Server()
@@ -67,18 +132,44 @@ bool Server<EndPoint>::start()
         return false;
     }
 
+    /* Workers creation. */
+    size_t workers = (0 < processing_workers_) ? processing_workers_ : shards_.size();
+    if (workers_.size() != workers)
+    {
+        std::lock_guard<std::mutex> topology_lock(topology_mtx_);
+        workers_.clear();
+        for (size_t i = 0; i < workers; ++i)
+        {
+            workers_.emplace_back(new Worker());
+        }
+    }
+
     /* Scheduler initialization. */
-    input_scheduler_.init();
-    input_scheduler_.set_priority_size(1, 1); // Priority 1 used for heartbeats
-    output_scheduler_.init();
+    for (auto& worker : workers_)
+    {
+        worker->input_scheduler.init();
+        worker->input_scheduler.set_priority_size(1, 1); // Priority 1 used for heartbeats
+    }
+    for (auto& shard : shards_)
+    {
+        shard->output_scheduler.init();
+        shard->transport_rc = TransportRc::ok;
+    }
 
     /* Thread initialization. */
     running_cond_ = true;
     error_handler_thread_ = std::thread(&Server::error_handler_loop, this);
-    receiver_thread_ = std::thread(&Server::receiver_loop, this);
-    sender_thread_ = std::thread(&Server::sender_loop, this);
-    processing_thread_ = std::thread(&Server::processing_loop, this);
+    for (size_t i = 0; i < workers_.size(); ++i)
+    {
+        workers_[i]->processing_thread = std::thread(&Server::processing_loop, this, i);
+    }
+    for (size_t i = 0; i < shards_.size(); ++i)
+    {
+        shards_[i]->receiver_thread = std::thread(&Server::receiver_loop, this, i);
+        shards_[i]->sender_thread = std::thread(&Server::sender_loop, this, i);
+    }
     heartbeat_thread_ = std::thread(&Server::heartbeat_loop, this);
+    flush_thread_ = std::thread(&Server::flush_loop, this);
 
     return true;
 }
@@ -90,28 +181,48 @@ bool Server<EndPoint>::stop()
     running_cond_ = false;
 
     /* Stop input and output queues. */
-    input_scheduler_.deinit();
-    output_scheduler_.deinit();
+    for (auto& worker : workers_)
+    {
+        worker->input_scheduler.deinit();
+    }
+    for (auto& shard : shards_)
+    {
+        shard->output_scheduler.deinit();
+    }
 
+    {
+        /* Threads waiting for the error handler check running_cond_ under this mutex. */
+        std::lock_guard<std::mutex> error_lock(error_mtx_);
+    }
     error_cv_.notify_all();
 
     /* Join threads. */
-    if (receiver_thread_.joinable())
+    for (auto& shard : shards_)
     {
-        receiver_thread_.join();
-    }
-    if (sender_thread_.joinable())
-    {
-        sender_thread_.join();
+        if (shard->receiver_thread.joinable())
+        {
+            shard->receiver_thread.join();
+        }
+        if (shard->sender_thread.joinable())
+        {
+            shard->sender_thread.join();
+        }
     }
-    if (processing_thread_.joinable())
+    for (auto& worker : workers_)
     {
-        processing_thread_.join();
+        if (worker->processing_thread.joinable())
+        {
+            worker->processing_thread.join();
+        }
     }
     if (heartbeat_thread_.joinable())
     {
         heartbeat_thread_.join();
     }
+    if (flush_thread_.joinable())
+    {
+        flush_thread_.join();
+    }
     if (error_handler_thread_.joinable())
     {
         error_handler_thread_.join();
@@ -135,6 +246,39 @@ bool Server<EndPoint>::stop()
     return rv;
 }
 
+template<typename EndPoint>
+bool Server<EndPoint>::set_shards(size_t shards)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    bool rv = false;
+    if (!running_cond_ && (0 < shards) && ((1 == shards) || has_sharding()))
+    {
+        std::lock_guard<std::mutex> topology_lock(topology_mtx_);
+        shards_.clear();
+        for (size_t i = 0; i < shards; ++i)
+        {
+            shards_.emplace_back(new Shard());
+        }
+        rv = true;
+    }
+    return rv;
+}
+
+template<typename EndPoint>
+bool Server<EndPoint>::set_processing_workers(size_t workers)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    bool rv = false;
+    if (!running_cond_)
+    {
+        processing_workers_ = workers;
+        rv = true;
+    }
+    return rv;
+}
+
 #ifdef UAGENT_DISCOVERY_PROFILE
 template<typename EndPoint>
 bool Server<EndPoint>::enable_discovery(uint16_t discovery_port)
@@ -179,63 +323,134 @@ void Server<EndPoint>::push_output_packet(
 {
     if (output_packet.message)
     {
-        output_scheduler_.push(std::move(output_packet), 0);
+        size_t shard_id = (1 < shards_.size())
+            ? get_endpoint_hash(output_packet.destination) % shards_.size()
+            : 0;
+        shards_[shard_id]->output_scheduler.push(std::move(output_packet), 0);
     }
 }
 
 template<typename EndPoint>
-void Server<EndPoint>::receiver_loop()
+size_t Server<EndPoint>::get_worker_id(
+        const InputPacket<EndPoint>& input_packet)
 {
+    return (1 == workers_.size()) ? 0 : get_input_worker(input_packet, workers_.size());
+}
+
+template<typename EndPoint>
+void Server<EndPoint>::push_input_packet(
+        InputPacket<EndPoint>&& input_packet)
+{
+    size_t worker_id = get_worker_id(input_packet);
+    uint8_t priority = get_input_priority(input_packet);
+    workers_[worker_id]->input_scheduler.push(std::move(input_packet), priority);
+}
+
+template<typename EndPoint>
+bool Server<EndPoint>::recv_message(
+        std::vector<InputPacket<EndPoint>>& input_packets,
+        size_t /* shard_id */,
+        int timeout,
+        TransportRc& transport_rc)
+{
+    return recv_message(input_packets, timeout, transport_rc);
+}
+
+template<typename EndPoint>
+bool Server<EndPoint>::send_message(
+        std::vector<OutputPacket<EndPoint>>& output_packets,
+        size_t /* shard_id */,
+        TransportRc& transport_rc)
+{
+    auto it = output_packets.begin();
+    for (; it != output_packets.end(); ++it)
+    {
+        if (!send_message(*it, transport_rc) && (TransportRc::server_error == transport_rc))
+        {
+            break;
+        }
+    }
+    output_packets.erase(output_packets.begin(), it);
+    return output_packets.empty();
+}
+
+template<typename EndPoint>
+void Server<EndPoint>::receiver_loop(size_t shard_id)
+{
+    Shard& shard = *shards_[shard_id];
+    TrafficCounters& received = shard.received;
     InputPacket<EndPoint> input_packet{};
+    std::vector<InputPacket<EndPoint>> input_packets;
+    input_packets.reserve(io_batch_size_);
+
     while (running_cond_)
     {
         TransportRc transport_rc = TransportRc::ok;
-        if (recv_message(input_packet, RECEIVE_TIMEOUT, transport_rc))
+        bool rv = false;
         {
-            if(input_packet.message->is_valid_xrce_message() && 1U == input_packet.message->count_submessages() && dds::xrce::HEARTBEAT == input_packet.message->get_submessage_id()){
-                input_scheduler_.push(std::move(input_packet), 1);
-            }
-            else
-            {
-                input_scheduler_.push(std::move(input_packet), 0);
-            }
+            std::lock_guard<std::mutex> lock(shard.receiver_mtx);
+            rv = is_batched()
+                ? recv_message(input_packets, shard_id, RECEIVE_TIMEOUT, transport_rc)
+                : recv_message(input_packet, RECEIVE_TIMEOUT, transport_rc);
         }
-        else if(running_cond_)
+
+        if (is_batched())
         {
-            if (TransportRc::server_error == transport_rc)
+            if (rv)
             {
-                std::unique_lock<std::mutex> lock(error_mtx_);
-                transport_rc_ = transport_rc;
-                error_cv_.notify_one();
-                error_cv_.wait(lock);
+                received.packets.add(input_packets.size());
+                received.bytes.add(get_bytes(input_packets));
+                for (auto& element : input_packets)
+                {
+                    push_input_packet(std::move(element));
+                }
             }
+            input_packets.clear();
+        }
+        else if (rv)
+        {
+            received.packets.add(1);
+            received.bytes.add(input_packet.message->get_len());
+            push_input_packet(std::move(input_packet));
+        }
+
+        if ((TransportRc::server_error == transport_rc) && running_cond_)
+        {
+            wait_error_handled(shard_id, transport_rc);
         }
     }
 }
 
 template<>
-void Server<MultiSerialEndPoint>::receiver_loop()
+void Server<MultiSerialEndPoint>::receiver_loop(size_t shard_id)
 {
+    Shard& shard = *shards_[shard_id];
+    TrafficCounters& received = shard.received;
     std::vector<InputPacket<MultiSerialEndPoint>> input_packet;
 
     while (running_cond_)
     {
         TransportRc transport_rc = TransportRc::ok;
-        if (recv_message(input_packet, RECEIVE_TIMEOUT, transport_rc))
+        bool rv = false;
+        {
+            std::lock_guard<std::mutex> lock(shard.receiver_mtx);
+            rv = recv_message(input_packet, RECEIVE_TIMEOUT, transport_rc);
+        }
+
+        if (rv)
         {
+            received.packets.add(input_packet.size());
+            received.bytes.add(get_bytes(input_packet));
             for (auto & element : input_packet)
             {
-                input_scheduler_.push(std::move(element), 0);
+                workers_[get_worker_id(element)]->input_scheduler.push(std::move(element), 0);
             }
         }
         else if(running_cond_)
         {
             if (TransportRc::server_error == transport_rc)
             {
-                std::unique_lock<std::mutex> lock(error_mtx_);
-                transport_rc_ = transport_rc;
-                error_cv_.notify_one();
-                error_cv_.wait(lock);
+                wait_error_handled(shard_id, transport_rc);
             }
         }
 
@@ -244,23 +459,40 @@ void Server<MultiSerialEndPoint>::receiver_loop()
 }
 
 template<typename EndPoint>
-void Server<EndPoint>::sender_loop()
+void Server<EndPoint>::sender_loop(size_t shard_id)
 {
+    if (is_batched())
+    {
+        batch_sender_loop(shard_id);
+        return;
+    }
+
+    Shard& shard = *shards_[shard_id];
+    PacketScheduler<OutputPacket<EndPoint>>& output_scheduler = shard.output_scheduler;
+    TrafficCounters& sent = shard.sent;
     OutputPacket<EndPoint> output_packet{};
     while (running_cond_)
     {
-        if (output_scheduler_.pop(output_packet))
+        if (output_scheduler.pop(output_packet))
         {
             TransportRc transport_rc = TransportRc::ok;
-            if (!send_message(output_packet, transport_rc))
+            bool rv = false;
+            {
+                std::lock_guard<std::mutex> lock(shard.sender_mtx);
+                rv = send_message(output_packet, transport_rc);
+            }
+
+            if (rv)
+            {
+                sent.packets.add(1);
+                sent.bytes.add(output_packet.message->get_len());
+            }
+            else
             {
                 if (TransportRc::server_error == transport_rc && running_cond_)
                 {
-                    std::unique_lock<std::mutex> lock(error_mtx_);
-                    transport_rc_ = transport_rc;
-                    output_scheduler_.push_front(std::move(output_packet), 0);
-                    error_cv_.notify_one();
-                    error_cv_.wait(lock);
+                    output_scheduler.push_front(std::move(output_packet), 0);
+                    wait_error_handled(shard_id, transport_rc);
                 }
             }
         }
@@ -268,14 +500,58 @@ void Server<EndPoint>::sender_loop()
 }
 
 template<typename EndPoint>
-void Server<EndPoint>::processing_loop()
+void Server<EndPoint>::batch_sender_loop(size_t shard_id)
 {
+    Shard& shard = *shards_[shard_id];
+    PacketScheduler<OutputPacket<EndPoint>>& output_scheduler = shard.output_scheduler;
+    TrafficCounters& sent = shard.sent;
+    std::vector<OutputPacket<EndPoint>> output_packets;
+    output_packets.reserve(io_batch_size_);
+
+    while (running_cond_)
+    {
+        if (output_scheduler.pop(output_packets, io_batch_size_))
+        {
+            TransportRc transport_rc = TransportRc::ok;
+            const size_t packets = output_packets.size();
+            const size_t bytes = get_bytes(output_packets);
+            bool all_sent = false;
+            {
+                std::lock_guard<std::mutex> lock(shard.sender_mtx);
+                all_sent = send_message(output_packets, shard_id, transport_rc);
+            }
+            sent.packets.add(packets - output_packets.size());
+            sent.bytes.add(bytes - get_bytes(output_packets));
+            if (!all_sent)
+            {
+                if (TransportRc::server_error == transport_rc && running_cond_)
+                {
+                    for (auto it = output_packets.rbegin(); it != output_packets.rend(); ++it)
+                    {
+                        output_scheduler.push_front(std::move(*it), 0);
+                    }
+                    wait_error_handled(shard_id, transport_rc);
+                }
+            }
+            output_packets.clear();
+        }
+    }
+}
+
+template<typename EndPoint>
+void Server<EndPoint>::processing_loop(size_t worker_id)
+{
+    PacketScheduler<InputPacket<EndPoint>>& input_scheduler = workers_[worker_id]->input_scheduler;
+    Histogram& processing_latency = workers_[worker_id]->processing_latency;
     InputPacket<EndPoint> input_packet;
     while (running_cond_)
     {
-        if (input_scheduler_.pop(input_packet))
+        if (input_scheduler.pop(input_packet))
         {
+            auto start = std::chrono::steady_clock::now();
             processor_->process_input_packet(std::move(input_packet));
+            processing_latency.record(uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count()));
         }
     }
 }
@@ -286,28 +562,100 @@ void Server<EndPoint>::heartbeat_loop()
     while (running_cond_)
     {
         processor_->check_heartbeats();
+        dump_metrics_if_due();
         std::this_thread::sleep_for(std::chrono::milliseconds(HEARTBEAT_PERIOD));
     }
 }
 
+template<typename EndPoint>
+void Server<EndPoint>::flush_loop()
+{
+    while (running_cond_)
+    {
+        processor_->flush_output_streams(std::chrono::milliseconds(HEARTBEAT_PERIOD));
+    }
+}
+
 template<typename EndPoint>
 void Server<EndPoint>::error_handler_loop()
 {
+    auto has_error = [&]()
+    {
+        return std::any_of(shards_.begin(), shards_.end(), [](const std::unique_ptr<Shard>& shard)
+        {
+            return TransportRc::server_error == shard->transport_rc;
+        });
+    };
+
     while (running_cond_)
     {
         std::unique_lock<std::mutex> lock(error_mtx_);
-        error_cv_.wait(lock, [&](){ return !running_cond_ || (transport_rc_ == TransportRc::server_error); });
-        if (running_cond_)
+        error_cv_.wait(lock, [&](){ return !running_cond_ || has_error(); });
+        for (size_t shard_id = 0; (shard_id < shards_.size()) && running_cond_; ++shard_id)
         {
-            bool error_handled = handle_error(transport_rc_);
+            Shard& shard = *shards_[shard_id];
+            if (TransportRc::server_error != shard.transport_rc)
+            {
+                continue;
+            }
+
+            /* Waits for the other thread of the shard to leave the transport, the reporting one already did. */
+            std::unique_lock<std::mutex> receiver_lock(shard.receiver_mtx, std::defer_lock);
+            std::unique_lock<std::mutex> sender_lock(shard.sender_mtx, std::defer_lock);
+            std::lock(receiver_lock, sender_lock);
+
+            bool error_handled = handle_error(shard.transport_rc, shard_id);
             while (running_cond_ && !error_handled)
             {
-                error_handled = handle_error(transport_rc_);
                 std::this_thread::sleep_for(std::chrono::milliseconds(500));
+                error_handled = handle_error(shard.transport_rc, shard_id);
             }
-            transport_rc_ = TransportRc::ok;
-            error_cv_.notify_all();
+            shard.transport_rc = TransportRc::ok;
         }
+        error_cv_.notify_all();
+    }
+}
+
+template<typename EndPoint>
+void Server<EndPoint>::wait_error_handled(
+        size_t shard_id,
+        TransportRc transport_rc)
+{
+    Shard& shard = *shards_[shard_id];
+    std::unique_lock<std::mutex> lock(error_mtx_);
+    shard.transport_rc = transport_rc;
+    error_cv_.notify_all();
+    error_cv_.wait(lock, [&](){ return !running_cond_ || (TransportRc::server_error != shard.transport_rc); });
+}
+
+template<typename EndPoint>
+bool Server<EndPoint>::handle_error(
+        TransportRc transport_rc,
+        size_t /* shard_id */)
+{
+    return handle_error(transport_rc);
+}
+
+template<typename EndPoint>
+void Server<EndPoint>::get_transport_metrics(AgentMetrics& metrics)
+{
+    std::lock_guard<std::mutex> topology_lock(topology_mtx_);
+    TransportMetrics& transport = metrics.transport;
+    transport.transport = get_transport_name<EndPoint>();
+    for (const auto& shard : shards_)
+    {
+        transport.packets_in += shard->received.packets.load();
+        transport.bytes_in += shard->received.bytes.load();
+        transport.packets_out += shard->sent.packets.load();
+        transport.bytes_out += shard->sent.bytes.load();
+        transport.output_drops += shard->output_scheduler.get_dropped();
+        transport.output_queue_depth += shard->output_scheduler.size();
+    }
+    for (const auto& worker : workers_)
+    {
+        transport.input_drops += worker->input_scheduler.get_dropped();
+        transport.input_queue_depth += worker->input_scheduler.size();
+        metrics.processing_latency.merge(worker->processing_latency);
     }
 }
 
@@ -115,6 +115,15 @@ bool CustomAgent::init()
 
         if (user_init_res)
         {
+            // Endpoint members are known by now, so the endpoint copies made per packet can use a packed key.
+            if (!recv_endpoint_->freeze())
+            {
+                UXR_AGENT_LOG_DEBUG(
+                    UXR_DECORATE_YELLOW("Custom agent endpoint not frozen"),
+                    "{} agent endpoint: {}",
+                    name_, *recv_endpoint_);
+            }
+
             UXR_AGENT_LOG_INFO(
                 UXR_DECORATE_GREEN("Custom agent status: opened"),
                 "{} agent running",
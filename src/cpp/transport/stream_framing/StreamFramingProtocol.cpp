@@ -13,12 +13,43 @@
 // limitations under the License.
 
 #include <uxr/agent/transport/stream_framing/StreamFramingProtocol.hpp>
+
+#include <algorithm>
 #include <chrono>
+#include <cstring>
 
 namespace eprosima {
 namespace uxr {
 
 constexpr uint16_t FramingIO::crc16_table[256];
+constexpr size_t FramingIO::framing_buffer_size;
+
+namespace {
+
+/**
+ * @brief Tables for the slicing-by-8 CRC. Entry [k][i] is the CRC of octet i followed by k zero octets,
+ *        so eight octets are folded into the CRC with eight independent lookups.
+ */
+struct CrcSlicingTables
+{
+    explicit CrcSlicingTables(
+            const uint16_t* crc16_table)
+    {
+        std::copy(crc16_table, crc16_table + 256, table[0]);
+        for (size_t k = 1; k < 8; ++k)
+        {
+            for (size_t i = 0; i < 256; ++i)
+            {
+                uint16_t crc = table[k - 1][i];
+                table[k][i] = uint16_t((crc >> 8) ^ table[0][crc & 0xFF]);
+            }
+        }
+    }
+
+    uint16_t table[8][256];
+};
+
+} // unnamed namespace
 
 FramingIO::FramingIO(
         uint8_t local_addr,
@@ -64,8 +95,15 @@ size_t FramingIO::write_framed_msg(
     bool cond = true;
     while (written_len < len && cond)
     {
+        /* Runs of octets which need no escaping are copied at once. */
+        size_t octets_added = add_next_octets(buf + written_len, len - written_len);
         octet = static_cast<uint8_t>(*(buf + written_len));
-        if (add_next_octet(octet))
+        if (0 < octets_added)
+        {
+            update_crc(crc, buf + written_len, octets_added);
+            written_len += static_cast<uint16_t>(octets_added);
+        }
+        else if (add_next_octet(octet))
         {
             update_crc(crc, octet);
             ++written_len;
@@ -136,11 +174,7 @@ size_t FramingIO::read_framed_msg(
                            (read_buffer_head_ != read_buffer_tail_))
                     {
                         octet = read_buffer_[read_buffer_tail_];
-                        read_buffer_tail_ =
-                            static_cast<uint8_t>(
-                                static_cast<size_t>(
-                                    read_buffer_tail_ + 1) %
-                                    sizeof(read_buffer_));
+                        read_buffer_tail_ = (read_buffer_tail_ + 1) % sizeof(read_buffer_);
                     }
 
                     if (framing_begin_flag == octet)
@@ -257,11 +291,25 @@ size_t FramingIO::read_framed_msg(
                 }
                 case InputState::UXR_FRAMING_READING_PAYLOAD:
                 {
-                    while ((msg_pos_ < msg_len_) && get_next_octet(octet))
+                    /* Runs of octets which need no unescaping are copied at once, flags go octet by octet. */
+                    bool octet_read = true;
+                    while ((msg_pos_ < msg_len_) && octet_read)
                     {
-                        buf[static_cast<size_t>(msg_pos_)] = octet;
-                        ++msg_pos_;
-                        update_crc(cmp_crc_, octet);
+                        size_t octets_read =
+                            get_next_octets(&buf[static_cast<size_t>(msg_pos_)], size_t(msg_len_ - msg_pos_));
+                        update_crc(cmp_crc_, &buf[static_cast<size_t>(msg_pos_)], octets_read);
+                        msg_pos_ += static_cast<uint16_t>(octets_read);
+
+                        if (msg_pos_ < msg_len_)
+                        {
+                            octet_read = get_next_octet(octet);
+                            if (octet_read)
+                            {
+                                buf[static_cast<size_t>(msg_pos_)] = octet;
+                                ++msg_pos_;
+                                update_crc(cmp_crc_, octet);
+                            }
+                        }
                     }
 
                     if (msg_pos_ == msg_len_)
@@ -351,6 +399,82 @@ void FramingIO::update_crc(
     crc = (crc >> 8) ^ crc16_table[(crc ^ data) & 0xFF];
 }
 
+void FramingIO::update_crc(
+        uint16_t& crc,
+        const uint8_t* data,
+        size_t len)
+{
+    static const CrcSlicingTables tables(crc16_table);
+    const uint16_t (&t)[8][256] = tables.table;
+
+    while (8 <= len)
+    {
+        uint16_t low = uint16_t(crc ^ (uint16_t(data[0]) | (uint16_t(data[1]) << 8)));
+        crc = uint16_t(
+            t[7][low & 0xFF] ^ t[6][low >> 8] ^
+            t[5][data[2]] ^ t[4][data[3]] ^ t[3][data[4]] ^
+            t[2][data[5]] ^ t[1][data[6]] ^ t[0][data[7]]);
+        data += 8;
+        len -= 8;
+    }
+
+    while (0 < len)
+    {
+        update_crc(crc, *data);
+        ++data;
+        --len;
+    }
+}
+
+const uint8_t* FramingIO::find_flag(
+        const uint8_t* begin,
+        const uint8_t* end)
+{
+    /* memchr is vectorised by the C library, the second scan only covers what precedes the first match. */
+    const void* begin_flag = std::memchr(begin, framing_begin_flag, size_t(end - begin));
+    const uint8_t* rv = (nullptr != begin_flag) ? static_cast<const uint8_t*>(begin_flag) : end;
+    const void* esc_flag = std::memchr(begin, framing_esc_flag, size_t(rv - begin));
+    return (nullptr != esc_flag) ? static_cast<const uint8_t*>(esc_flag) : rv;
+}
+
+size_t FramingIO::get_next_octets(
+        uint8_t* buf,
+        size_t len)
+{
+    size_t rv = 0;
+
+    while ((rv < len) && (read_buffer_head_ != read_buffer_tail_))
+    {
+        /* Contiguous section of the circular buffer starting at the tail. */
+        size_t section_end = (read_buffer_head_ > read_buffer_tail_) ? read_buffer_head_ : sizeof(read_buffer_);
+        size_t section_len = (std::min)(section_end - read_buffer_tail_, len - rv);
+
+        const uint8_t* section = &read_buffer_[read_buffer_tail_];
+        size_t octets = size_t(find_flag(section, section + section_len) - section);
+        std::memcpy(buf + rv, section, octets);
+        rv += octets;
+        read_buffer_tail_ = (read_buffer_tail_ + octets) % sizeof(read_buffer_);
+
+        if (octets < section_len)
+        {
+            break;
+        }
+    }
+
+    return rv;
+}
+
+size_t FramingIO::add_next_octets(
+        const uint8_t* buf,
+        size_t len)
+{
+    size_t available = sizeof(write_buffer_) - write_buffer_pos_;
+    size_t rv = size_t(find_flag(buf, buf + (std::min)(len, available)) - buf);
+    std::memcpy(&write_buffer_[write_buffer_pos_], buf, rv);
+    write_buffer_pos_ += rv;
+    return rv;
+}
+
 bool FramingIO::get_next_octet(
         uint8_t& octet)
 {
@@ -362,21 +486,18 @@ bool FramingIO::get_next_octet(
         if (framing_esc_flag != read_buffer_[read_buffer_tail_])
         {
             octet = read_buffer_[read_buffer_tail_];
-            read_buffer_tail_ = static_cast<uint8_t>(
-                static_cast<size_t>(read_buffer_tail_ + 1) % sizeof(read_buffer_));
+            read_buffer_tail_ = (read_buffer_tail_ + 1) % sizeof(read_buffer_);
 
             rv = (framing_begin_flag != octet);
         }
         else
         {
-            uint8_t temp_tail = static_cast<uint8_t>(
-                static_cast<size_t>(read_buffer_tail_ + 1) % sizeof(read_buffer_));
+            size_t temp_tail = (read_buffer_tail_ + 1) % sizeof(read_buffer_);
 
             if (temp_tail != read_buffer_head_)
             {
                 octet = read_buffer_[temp_tail];
-                read_buffer_tail_ = static_cast<uint8_t>(
-                    static_cast<size_t>(read_buffer_tail_ + 2) % sizeof(read_buffer_));
+                read_buffer_tail_ = (read_buffer_tail_ + 2) % sizeof(read_buffer_);
 
                 if (framing_begin_flag != octet)
                 {
@@ -397,7 +518,7 @@ bool FramingIO::add_next_octet(
 
     if (framing_begin_flag == octet || framing_esc_flag == octet)
     {
-        if (static_cast<uint8_t>(write_buffer_pos_ + 1) < sizeof(write_buffer_))
+        if ((write_buffer_pos_ + 1) < sizeof(write_buffer_))
         {
             write_buffer_[write_buffer_pos_] = framing_esc_flag;
             write_buffer_[write_buffer_pos_ + 1] = octet ^ framing_xor_flag;
@@ -423,7 +544,8 @@ bool FramingIO::transport_write(
 
     do
     {
-        ssize_t write_res = write_callback_(write_buffer_, write_buffer_pos_, transport_rc);
+        ssize_t write_res =
+            write_callback_(&write_buffer_[bytes_written], write_buffer_pos_ - bytes_written, transport_rc);
         last_written = (0 < write_res) ? write_res : 0;
         bytes_written += last_written;
     } while (bytes_written < write_buffer_pos_ && 0 < last_written);
@@ -450,7 +572,7 @@ size_t FramingIO::transport_read(
      * some intermediate section of the circular buffer being written,
      * that is, head > tail.
      */
-    uint8_t available_length[2] = {0, 0};
+    size_t available_length[2] = {0, 0};
     if (read_buffer_head_ == read_buffer_tail_)
     {
         read_buffer_head_ = 0;
@@ -461,21 +583,17 @@ size_t FramingIO::transport_read(
     {
         if (0 < read_buffer_tail_)
         {
-            available_length[0] =
-                static_cast<uint8_t>(sizeof(read_buffer_) - read_buffer_head_);
-            available_length[1] =
-                static_cast<uint8_t>(read_buffer_tail_ - 1);
+            available_length[0] = sizeof(read_buffer_) - read_buffer_head_;
+            available_length[1] = read_buffer_tail_ - 1;
         }
         else
         {
-            available_length[0] =
-                static_cast<uint8_t>(sizeof(read_buffer_) - read_buffer_head_ - 1);
+            available_length[0] = sizeof(read_buffer_) - read_buffer_head_ - 1;
         }
     }
     else
     {
-        available_length[0] =
-            static_cast<uint8_t>(read_buffer_tail_ - read_buffer_head_ - 1);
+        available_length[0] = read_buffer_tail_ - read_buffer_head_ - 1;
     }
 
     /**
@@ -485,10 +603,10 @@ size_t FramingIO::transport_read(
 
     // Limit the reading size
     if (max_size < available_length[0]){
-        available_length[0] = (uint8_t)max_size;
+        available_length[0] = max_size;
         available_length[1] = 0;
     } else if(max_size < available_length[0] + available_length[1]){
-        available_length[1] = (uint8_t)(max_size - available_length[0]);
+        available_length[1] = max_size - available_length[0];
     }
 
     if (0 < available_length[0])
@@ -499,8 +617,7 @@ size_t FramingIO::transport_read(
                                        transport_rc);
         bytes_read[0] = (0 < read_res) ? read_res : 0;
 
-        read_buffer_head_ = static_cast<uint8_t>(
-            static_cast<size_t>(read_buffer_head_ + bytes_read[0]) % sizeof(read_buffer_));
+        read_buffer_head_ = (read_buffer_head_ + bytes_read[0]) % sizeof(read_buffer_);
 
         if (0 < bytes_read[0])
         {
@@ -512,8 +629,7 @@ size_t FramingIO::transport_read(
                                        transport_rc);
                 bytes_read[1] = (0 < read_res) ? read_res : 0;
 
-                read_buffer_head_ = static_cast<uint8_t>(
-                    static_cast<size_t>(read_buffer_head_ + bytes_read[1]) % sizeof(read_buffer_));
+                read_buffer_head_ = (read_buffer_head_ + bytes_read[1]) % sizeof(read_buffer_);
             }
         }
     }
@@ -22,14 +22,22 @@
 #include <arpa/inet.h>
 #include <string.h>
 #include <unistd.h>
+#include <sys/uio.h>
+#include <fcntl.h>
 #include <errno.h>
 #include <signal.h>
+#include <algorithm>
 #include <functional>
 
 namespace eprosima {
 namespace uxr {
 
 const uint8_t max_attemps = 16;
+const size_t max_iovecs = 1024;
+#ifndef __APPLE__
+const size_t max_epoll_events = 64;
+const uint64_t listener_event_id = UINT64_MAX;
+#endif
 
 #ifdef UAGENT_DISCOVERY_PROFILE
 extern template class DiscoveryServer<IPv4EndPoint>;
@@ -39,18 +47,23 @@ extern template class DiscoveryServerLinux<IPv4EndPoint>;
 TCPv4Agent::TCPv4Agent(
         uint16_t agent_port,
         Middleware::Kind middleware_kind)
-    : Server<IPv4EndPoint>{middleware_kind}
+    : Server<IPv4EndPoint>{middleware_kind, TCP_BATCH_SIZE}
     , TCPServerBase{}
     , connections_{}
     , active_connections_{}
     , free_connections_{}
-    , listener_poll_{}
+    , listener_fd_{-1}
+#ifdef __APPLE__
     , poll_fds_{}
+#else
+    , epoll_fd_{-1}
+    , epoll_events_(max_epoll_events)
+#endif
     , buffer_{0}
     , agent_port_{agent_port}
-    , listener_thread_{}
-    , running_cond_{false}
     , messages_queue_{}
+    , send_size_bufs_{}
+    , send_iovecs_{}
 #ifdef UAGENT_DISCOVERY_PROFILE
     , discovery_server_{*processor_}
 #endif
@@ -79,12 +92,12 @@ bool TCPv4Agent::init()
     signal(SIGPIPE, sigpipe_handler);
 
     /* Listener socket initialization. */
-    listener_poll_.fd = socket(PF_INET, SOCK_STREAM, 0);
+    listener_fd_ = socket(PF_INET, SOCK_STREAM, 0);
 
-    if (-1 != listener_poll_.fd)
+    if (-1 != listener_fd_)
     {
         int value = 1;
-        if (0 != setsockopt(listener_poll_.fd, SOL_SOCKET, SO_REUSEADDR, &value, sizeof(value)))
+        if (0 != setsockopt(listener_fd_, SOL_SOCKET, SO_REUSEADDR, &value, sizeof(value)))
         {
             UXR_AGENT_LOG_ERROR(
                     UXR_DECORATE_YELLOW("SO_REUSEADDR socket option failed"),
@@ -92,6 +105,9 @@ bool TCPv4Agent::init()
                     agent_port_, errno);
         }
 
+        /* Pending connections are accepted until the listener would block. */
+        fcntl(listener_fd_, F_SETFL, fcntl(listener_fd_, F_GETFL, 0) | O_NONBLOCK);
+
         struct sockaddr_in address;
 
         address.sin_family = AF_INET;
@@ -99,7 +115,7 @@ bool TCPv4Agent::init()
         address.sin_addr.s_addr = INADDR_ANY;
         memset(address.sin_zero, '\0', sizeof(address.sin_zero));
 
-        if (-1 != bind(listener_poll_.fd, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)))
+        if (-1 != bind(listener_fd_, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)))
         {
             /* Log. */
             UXR_AGENT_LOG_DEBUG(
@@ -107,26 +123,40 @@ bool TCPv4Agent::init()
                 "port: {}",
                 agent_port_);
 
-            /* Setup listener poll. */
-            listener_poll_.events = POLLIN;
+            /* Setup connections, the table keeps its slots across restarts and grows on demand. */
+            std::unique_lock<std::mutex> lock(connections_mtx_);
+            free_connections_.clear();
+            for (auto& connection : connections_)
+            {
+                free_connections_.push_back(connection->id);
+            }
+            lock.unlock();
 
-            /* Setup connections. */
-            for (size_t i = 0; i < poll_fds_.size(); ++i)
+            /* Setup event loop, it is notified of incoming connections and of readable ones. */
+            bool event_loop_ready = false;
+#ifdef __APPLE__
+            poll_fds_.resize(connections_.size() + 1);
+            for (auto& poll_fd : poll_fds_)
             {
-                poll_fds_[i].fd = -1;
-                poll_fds_[i].events = POLLIN;
-                connections_[i].poll_fd = &poll_fds_[i];
-                connections_[i].id = uint32_t(i);
-                connections_[i].active = false;
-                init_input_buffer(connections_[i].input_buffer);
-                free_connections_.push_back(connections_[i].id);
+                poll_fd.fd = -1;
+                poll_fd.events = POLLIN;
             }
+            poll_fds_[0].fd = listener_fd_;
+            event_loop_ready = true;
+#else
+            epoll_fd_ = epoll_create1(0);
+            if (-1 != epoll_fd_)
+            {
+                struct epoll_event event{};
+                event.events = EPOLLIN | EPOLLET;
+                event.data.u64 = listener_event_id;
+                event_loop_ready = (0 == epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, listener_fd_, &event));
+            }
+#endif
 
             /* Init listener. */
-            if (-1 != listen(listener_poll_.fd, TCP_MAX_BACKLOG_CONNECTIONS))
+            if (event_loop_ready && (-1 != listen(listener_fd_, TCP_MAX_BACKLOG_CONNECTIONS)))
             {
-                running_cond_ = true;
-                listener_thread_ = std::thread(&TCPv4Agent::listener_loop, this);
                 rv = true;
 
                 UXR_AGENT_LOG_INFO(
@@ -162,32 +192,38 @@ bool TCPv4Agent::init()
 
 bool TCPv4Agent::fini()
 {
-    /* Stop listener thread. */
-    running_cond_ = false;
-    if (listener_thread_.joinable())
+    /* Close event loop. */
+#ifdef __APPLE__
+    poll_fds_.clear();
+#else
+    if (-1 != epoll_fd_)
     {
-        listener_thread_.join();
+        if (0 == ::close(epoll_fd_))
+        {
+            epoll_fd_ = -1;
+        }
     }
+#endif
 
     /* Close listener. */
-    if (-1 != listener_poll_.fd)
+    if (-1 != listener_fd_)
     {
-        if (0 == ::close(listener_poll_.fd))
+        if (0 == ::close(listener_fd_))
         {
-            listener_poll_.fd = -1;
+            listener_fd_ = -1;
         }
     }
 
     /* Disconnect clients. */
     for (auto& conn : connections_)
     {
-        close_connection(conn);
+        close_connection(*conn);
     }
 
     std::lock_guard<std::mutex> lock(connections_mtx_);
 
     bool rv = false;
-    if ((-1 == listener_poll_.fd) && (active_connections_.empty()))
+    if ((-1 == listener_fd_) && (active_connections_.empty()))
     {
         rv = true;
         UXR_AGENT_LOG_INFO(
@@ -260,98 +296,104 @@ bool TCPv4Agent::recv_message(
     return rv;
 }
 
+bool TCPv4Agent::recv_message(
+        std::vector<InputPacket<IPv4EndPoint>>& input_packets,
+        int timeout,
+        TransportRc& transport_rc)
+{
+    bool rv = true;
+
+    if (messages_queue_.empty() && !read_message(timeout, transport_rc))
+    {
+        rv = false;
+    }
+    else
+    {
+        while (!messages_queue_.empty())
+        {
+            InputPacket<IPv4EndPoint>& input_packet = messages_queue_.front();
+
+            uint32_t raw_client_key = 0u;
+            Server<IPv4EndPoint>::get_client_key(input_packet.source, raw_client_key);
+            UXR_AGENT_LOG_MESSAGE(
+                UXR_DECORATE_YELLOW("[==>> TCP <<==]"),
+                raw_client_key,
+                input_packet.message->get_buf(),
+                input_packet.message->get_len());
+
+            input_packets.push_back(std::move(input_packet));
+            messages_queue_.pop();
+        }
+    }
+    return rv;
+}
+
 bool TCPv4Agent::send_message(
         OutputPacket<IPv4EndPoint> output_packet,
         TransportRc& transport_rc)
 {
     bool rv = false;
-    uint8_t msg_size_buf[2];
     transport_rc = TransportRc::connection_error;
 
     std::unique_lock<std::mutex> lock(connections_mtx_);
     auto it = endpoint_to_connection_map_.find(output_packet.destination);
     if (it != endpoint_to_connection_map_.end())
     {
-        TCPv4ConnectionLinux& connection = connections_.at(it->second);
+        TCPv4ConnectionLinux& connection = *connections_.at(it->second);
         lock.unlock();
 
-        msg_size_buf[0] = uint8_t(0x00FF & output_packet.message->get_len());
-        msg_size_buf[1] = uint8_t((0xFF00 & output_packet.message->get_len()) >> 8);
-        uint8_t n_attemps = 0;
-        uint16_t bytes_sent = 0;
+        const OutputPacket<IPv4EndPoint>* packet = &output_packet;
+        rv = write_connection(connection, &packet, 1, transport_rc);
+    }
 
-        /* Send message size. */
-        bool size_sent = false;
-        do
-        {
-            size_t send_rv = send_data(connection, msg_size_buf, 2, transport_rc);
-            if (0 < send_rv)
-            {
-                bytes_sent += uint16_t(send_rv);
-                size_sent = (bytes_sent == 2);
-            }
-            else
-            {
-                if (TransportRc::ok != transport_rc)
-                {
-                    break;
-                }
-            }
-            ++n_attemps;
-        }
-        while (!size_sent && n_attemps < max_attemps);
+    return rv;
+}
+
+bool TCPv4Agent::send_message(
+        std::vector<OutputPacket<IPv4EndPoint>>& output_packets,
+        size_t /* shard_id */,
+        TransportRc& transport_rc)
+{
+    /* Group the packets by connection, keeping the order in which they were queued for each one. */
+    std::vector<std::pair<TCPv4ConnectionLinux*, const OutputPacket<IPv4EndPoint>*>> packets;
+    packets.reserve(output_packets.size());
 
-        /* Send message payload. */
-        bool payload_sent = false;
-        if (size_sent)
+    std::unique_lock<std::mutex> lock(connections_mtx_);
+    for (const auto& output_packet : output_packets)
+    {
+        auto it = endpoint_to_connection_map_.find(output_packet.destination);
+        if (it != endpoint_to_connection_map_.end())
         {
-            n_attemps = 0;
-            bytes_sent = 0;
-            do
-            {
-                size_t send_rv =
-                    send_data(
-                        connection,
-                        output_packet.message->get_buf() + bytes_sent,
-                        output_packet.message->get_len() - bytes_sent,
-                        transport_rc);
-                if (0 < send_rv)
-                {
-                    bytes_sent += uint16_t(send_rv);
-                    payload_sent = (bytes_sent == uint16_t(output_packet.message->get_len()));
-                }
-                else
-                {
-                    if (TransportRc::ok != transport_rc)
-                    {
-                        break;
-                    }
-                }
-                ++n_attemps;
-            }
-            while (!payload_sent && n_attemps < max_attemps);
+            packets.emplace_back(connections_.at(it->second).get(), &output_packet);
         }
+    }
+    lock.unlock();
 
-        if (payload_sent)
+    std::stable_sort(packets.begin(), packets.end(),
+        [](const std::pair<TCPv4ConnectionLinux*, const OutputPacket<IPv4EndPoint>*>& a,
+           const std::pair<TCPv4ConnectionLinux*, const OutputPacket<IPv4EndPoint>*>& b)
         {
-            rv = true;
-
-            uint32_t raw_client_key = 0u;
-            Server<IPv4EndPoint>::get_client_key(output_packet.destination, raw_client_key);
-            UXR_AGENT_LOG_MESSAGE(
-                UXR_DECORATE_YELLOW("[** <<TCP>> **]"),
-                raw_client_key,
-                output_packet.message->get_buf(),
-                output_packet.message->get_len());
-        }
+            return a.first->id < b.first->id;
+        });
 
-        if (TransportRc::connection_error == transport_rc)
+    std::vector<const OutputPacket<IPv4EndPoint>*> connection_packets;
+    connection_packets.reserve(packets.size());
+    for (size_t i = 0; i < packets.size();)
+    {
+        TCPv4ConnectionLinux* connection = packets[i].first;
+        connection_packets.clear();
+        for (; (i < packets.size()) && (connection == packets[i].first); ++i)
         {
-            close_connection(connection);
+            connection_packets.push_back(packets[i].second);
         }
+
+        /* Packets to a closed connection are dropped, as in the unbatched path. */
+        write_connection(*connection, connection_packets.data(), connection_packets.size(), transport_rc);
     }
 
-    return rv;
+    transport_rc = TransportRc::ok;
+    output_packets.clear();
+    return true;
 }
 
 bool TCPv4Agent::handle_error(
@@ -366,19 +408,48 @@ bool TCPv4Agent::open_connection(
 {
     bool rv = false;
     std::lock_guard<std::mutex> lock(connections_mtx_);
+    if (free_connections_.empty() && (TCP_MAX_CONNECTIONS > connections_.size()))
+    {
+        std::unique_ptr<TCPv4ConnectionLinux> connection(new TCPv4ConnectionLinux());
+        connection->fd = -1;
+        connection->id = uint32_t(connections_.size());
+        connection->active = false;
+        free_connections_.push_back(connection->id);
+        connections_.push_back(std::move(connection));
+#ifdef __APPLE__
+        struct pollfd poll_fd{};
+        poll_fd.fd = -1;
+        poll_fd.events = POLLIN;
+        poll_fds_.push_back(poll_fd);
+#endif
+    }
+
     if (!free_connections_.empty())
     {
         uint32_t id = free_connections_.front();
-        TCPv4ConnectionLinux& connection = connections_[size_t(id)];
-        connection.poll_fd->fd = fd;
-        connection.endpoint = IPv4EndPoint(sockaddr.sin_addr.s_addr, sockaddr.sin_port);
-        connection.active = true;
-        init_input_buffer(connection.input_buffer);
-
-        endpoint_to_connection_map_[connection.endpoint] = connection.id;
-        active_connections_.insert(id);
-        free_connections_.pop_front();
-        rv = true;
+        TCPv4ConnectionLinux& connection = *connections_[size_t(id)];
+
+#ifdef __APPLE__
+        poll_fds_[size_t(id) + 1].fd = fd;
+        bool registered = true;
+#else
+        struct epoll_event event{};
+        event.events = EPOLLIN | EPOLLRDHUP | EPOLLET;
+        event.data.u64 = id;
+        bool registered = (0 == epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event));
+#endif
+        if (registered)
+        {
+            connection.fd = fd;
+            connection.endpoint = IPv4EndPoint(sockaddr.sin_addr.s_addr, sockaddr.sin_port);
+            connection.active = true;
+            init_input_buffer(connection.input_buffer);
+
+            endpoint_to_connection_map_[connection.endpoint] = connection.id;
+            active_connections_.insert(id);
+            free_connections_.pop_front();
+            rv = true;
+        }
     }
     return rv;
 }
@@ -393,13 +464,20 @@ bool TCPv4Agent::close_connection(
     {
         lock.unlock();
         std::unique_lock<std::mutex> conn_lock(connection.mtx);
-        if (0 == ::close(connection.poll_fd->fd))
+        /* Closing the socket also removes it from the epoll set. */
+        if (0 == ::close(connection.fd))
         {
-            connection.poll_fd->fd = -1;
+            connection.fd = -1;
             connection.active = false;
             conn_lock.unlock();
 
             lock.lock();
+#ifdef __APPLE__
+            if (size_t(connection.id) + 1 < poll_fds_.size())
+            {
+                poll_fds_[size_t(connection.id) + 1].fd = -1;
+            }
+#endif
             endpoint_to_connection_map_.erase(connection.endpoint);
             active_connections_.erase(it_conn);
             free_connections_.push_back(connection.id);
@@ -414,96 +492,220 @@ bool TCPv4Agent::close_connection(
 void TCPv4Agent::init_input_buffer(
         TCPInputBuffer& buffer)
 {
-    buffer.state = TCP_BUFFER_EMPTY;
-    buffer.msg_size = 0;
+    buffer.head = 0;
+    buffer.tail = 0;
+    if (TCP_RECV_BUFFER_SIZE < buffer.buffer.size())
+    {
+        /* Do not keep the room a large message needed once the connection is reused. */
+        std::vector<uint8_t>().swap(buffer.buffer);
+    }
 }
 
 bool TCPv4Agent::read_message(
         int timeout,
         TransportRc& transport_rc)
 {
-    std::unique_lock<std::mutex> lock(connections_mtx_);
-    if (active_connections_.empty())
-    {
-        lock.unlock();
-        std::this_thread::sleep_for(std::chrono::milliseconds(timeout));
-        return false;
-    }
-    lock.unlock();
-
     bool rv = false;
+#ifdef __APPLE__
     int poll_rv = poll(poll_fds_.data(), poll_fds_.size(), timeout);
     if (0 < poll_rv)
     {
-        for (auto& conn : connections_)
+        if (0 != (POLLIN & poll_fds_[0].revents))
+        {
+            accept_connections();
+        }
+        for (size_t i = 1; i < poll_fds_.size(); ++i)
         {
-            if (POLLIN == (POLLIN & conn.poll_fd->revents))
+            if (0 != poll_fds_[i].revents)
             {
-                uint16_t bytes_read = read_data(conn, transport_rc);
-                if (TransportRc::ok == transport_rc)
-                {
-                    if (0 < bytes_read)
-                    {
-                        InputPacket<IPv4EndPoint> input_packet;
-                        input_packet.message.reset(new InputMessage(conn.input_buffer.buffer.data(), bytes_read));
-                        input_packet.source = conn.endpoint;
-                        messages_queue_.push(std::move(input_packet));
-                        rv = true;
-                    }
-                }
-                else
-                {
-                    if (TransportRc::connection_error == transport_rc)
-                    {
-                        close_connection(conn);
-                    }
-                }
+                poll_fds_[i].revents = 0;
+                rv = read_connection(*connections_[i - 1], transport_rc) || rv;
+            }
+        }
+    }
+#else
+    int poll_rv = epoll_wait(epoll_fd_, epoll_events_.data(), int(epoll_events_.size()), timeout);
+    if (0 < poll_rv)
+    {
+        for (size_t i = 0; i < size_t(poll_rv); ++i)
+        {
+            if (listener_event_id == epoll_events_[i].data.u64)
+            {
+                accept_connections();
             }
             else
             {
-                transport_rc = TransportRc::connection_error;
+                rv = read_connection(*connections_[size_t(epoll_events_[i].data.u64)], transport_rc) || rv;
             }
         }
     }
+#endif
+
+    if (0 < poll_rv)
+    {
+        transport_rc = rv ? TransportRc::ok : TransportRc::timeout_error;
+    }
     else
     {
-        transport_rc = (0 == poll_rv) ? TransportRc::timeout_error : TransportRc::server_error;
+        transport_rc = ((0 == poll_rv) || (EINTR == errno)) ? TransportRc::timeout_error : TransportRc::server_error;
+    }
+    return rv;
+}
+
+bool TCPv4Agent::read_connection(
+        TCPv4ConnectionLinux& connection,
+        TransportRc& transport_rc)
+{
+    /* Readiness is edge-triggered, so the connection is drained until it would block. */
+    bool rv = false;
+    do
+    {
+        if (0 < read_data(connection, transport_rc))
+        {
+            const uint8_t* message = nullptr;
+            uint16_t message_len = 0;
+            while (next_message(connection, message, message_len))
+            {
+                InputPacket<IPv4EndPoint> input_packet;
+                input_packet.message.reset(new InputMessage(message, message_len));
+                input_packet.source = connection.endpoint;
+                messages_queue_.push(std::move(input_packet));
+                rv = true;
+            }
+        }
+    }
+    while (TransportRc::ok == transport_rc);
+
+    if (TransportRc::connection_error == transport_rc)
+    {
+        close_connection(connection);
     }
     return rv;
 }
 
-void TCPv4Agent::listener_loop()
+bool TCPv4Agent::write_connection(
+        TCPv4ConnectionLinux& connection,
+        const OutputPacket<IPv4EndPoint>* const* output_packets,
+        size_t count,
+        TransportRc& transport_rc)
 {
-    while (running_cond_)
+    bool rv = false;
+    transport_rc = TransportRc::connection_error;
+
+    /* Only the sender thread writes, so its scratch vectors are reused across calls. */
+    std::vector<uint8_t>& msg_size_bufs = send_size_bufs_;
+    std::vector<struct iovec>& iovecs = send_iovecs_;
+    msg_size_bufs.resize(2 * count);
+    iovecs.resize(2 * count);
+    size_t bytes_pending = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        size_t len = output_packets[i]->message->get_len();
+        msg_size_bufs[2 * i] = uint8_t(0x00FF & len);
+        msg_size_bufs[(2 * i) + 1] = uint8_t((0xFF00 & len) >> 8);
+        iovecs[2 * i].iov_base = &msg_size_bufs[2 * i];
+        iovecs[2 * i].iov_len = 2;
+        iovecs[(2 * i) + 1].iov_base = output_packets[i]->message->get_buf();
+        iovecs[(2 * i) + 1].iov_len = len;
+        bytes_pending += len + 2;
+    }
+
+    std::unique_lock<std::mutex> lock(connection.mtx);
+    if (connection.active)
     {
-        int poll_rv = poll(&listener_poll_, 1, 100);
-        if (0 < poll_rv)
+        struct iovec* iovec = iovecs.data();
+        size_t iovec_count = iovecs.size();
+        uint8_t n_attemps = 0;
+        do
         {
-            if (POLLIN == (POLLIN & listener_poll_.revents))
+            ssize_t bytes_sent = writev(connection.fd, iovec, int((std::min)(iovec_count, max_iovecs)));
+            if (0 < bytes_sent)
             {
-                if (connection_available())
+                transport_rc = TransportRc::ok;
+                bytes_pending -= size_t(bytes_sent);
+
+                /* Skip what was written, the last buffer may have been written partially. */
+                size_t bytes_skipped = size_t(bytes_sent);
+                while ((0 < iovec_count) && (iovec->iov_len <= bytes_skipped))
+                {
+                    bytes_skipped -= iovec->iov_len;
+                    ++iovec;
+                    --iovec_count;
+                }
+                if (0 < bytes_skipped)
                 {
-                    struct sockaddr_in client_addr{};
-                    socklen_t client_addr_len = sizeof(client_addr);
-                    int incoming_fd =
-                        accept(
-                            listener_poll_.fd,
-                            reinterpret_cast<struct sockaddr*>(&client_addr),
-                            &client_addr_len);
-                    if (-1 != incoming_fd)
-                    {
-                        open_connection(incoming_fd, client_addr);
-                    }
+                    iovec->iov_base = static_cast<uint8_t*>(iovec->iov_base) + bytes_skipped;
+                    iovec->iov_len -= bytes_skipped;
                 }
             }
+            else if ((-1 == bytes_sent) && (EINTR == errno))
+            {
+                transport_rc = TransportRc::ok;
+            }
+            else
+            {
+                transport_rc = TransportRc::connection_error;
+                break;
+            }
+            ++n_attemps;
+        }
+        while ((0 < bytes_pending) && (n_attemps < max_attemps));
+        rv = (0 == bytes_pending);
+    }
+    lock.unlock();
+
+    if (rv)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            uint32_t raw_client_key = 0u;
+            Server<IPv4EndPoint>::get_client_key(output_packets[i]->destination, raw_client_key);
+            UXR_AGENT_LOG_MESSAGE(
+                UXR_DECORATE_YELLOW("[** <<TCP>> **]"),
+                raw_client_key,
+                output_packets[i]->message->get_buf(),
+                output_packets[i]->message->get_len());
         }
     }
+
+    if (TransportRc::connection_error == transport_rc)
+    {
+        close_connection(connection);
+    }
+    return rv;
 }
 
-bool TCPv4Agent::connection_available()
+void TCPv4Agent::accept_connections()
 {
-    std::lock_guard<std::mutex> lock(connections_mtx_);
-    return !free_connections_.empty();
+    for (;;)
+    {
+        struct sockaddr_in client_addr{};
+        socklen_t client_addr_len = sizeof(client_addr);
+        int incoming_fd =
+            accept(
+                listener_fd_,
+                reinterpret_cast<struct sockaddr*>(&client_addr),
+                &client_addr_len);
+        if (-1 == incoming_fd)
+        {
+            break;
+        }
+
+        /*
+         * Connections are written blocking. On BSD-derived systems the accepted socket inherits
+         * O_NONBLOCK from the listener, and writes would fail with EAGAIN whenever the send buffer fills.
+         */
+        fcntl(incoming_fd, F_SETFL, fcntl(incoming_fd, F_GETFL, 0) & ~O_NONBLOCK);
+
+        if (!open_connection(incoming_fd, client_addr))
+        {
+            UXR_AGENT_LOG_WARN(
+                UXR_DECORATE_YELLOW("connection rejected"),
+                "port: {}, max connections: {}",
+                agent_port_, TCP_MAX_CONNECTIONS);
+            ::close(incoming_fd);
+        }
+    }
 }
 
 size_t TCPv4Agent::recv_data(
@@ -516,23 +718,15 @@ size_t TCPv4Agent::recv_data(
     std::lock_guard<std::mutex> lock(connection.mtx);
     if (connection.active)
     {
-        int poll_rv = poll(connection.poll_fd, 1, 0);
-        if (0 < poll_rv)
+        ssize_t bytes_received = recv(connection.fd, buffer, len, MSG_DONTWAIT);
+        if (0 < bytes_received)
         {
-            ssize_t bytes_received = recv(connection.poll_fd->fd, buffer, len, 0);
-            if (0 < bytes_received)
-            {
-                rv = size_t(bytes_received);
-                transport_rc = TransportRc::ok;
-            }
-            else
-            {
-                transport_rc = TransportRc::connection_error;
-            }
+            rv = size_t(bytes_received);
+            transport_rc = TransportRc::ok;
         }
         else
         {
-            transport_rc = (0 == poll_rv)
+            transport_rc = ((-1 == bytes_received) && ((EAGAIN == errno) || (EWOULDBLOCK == errno)))
                 ? TransportRc::timeout_error
                 : TransportRc::connection_error;
         }
@@ -554,7 +748,7 @@ size_t TCPv4Agent::send_data(
     std::lock_guard<std::mutex> lock(connection.mtx);
     if (connection.active)
     {
-        ssize_t bytes_sent = send(connection.poll_fd->fd, buffer, len, 0);
+        ssize_t bytes_sent = send(connection.fd, buffer, len, 0);
         if (-1 != bytes_sent)
         {
             rv = size_t(bytes_sent);
@@ -380,8 +380,12 @@ bool TCPv4Agent::close_connection(
 
 void TCPv4Agent::init_input_buffer(TCPInputBuffer& buffer)
 {
-    buffer.state = TCP_BUFFER_EMPTY;
-    buffer.msg_size = 0;
+    buffer.head = 0;
+    buffer.tail = 0;
+    if (TCP_RECV_BUFFER_SIZE < buffer.buffer.size())
+    {
+        std::vector<uint8_t>().swap(buffer.buffer);
+    }
 }
 
 bool TCPv4Agent::read_message(
@@ -405,13 +409,15 @@ bool TCPv4Agent::read_message(
         {
             if (0 < (POLLIN & conn.poll_fd->revents))
             {
-                uint16_t bytes_read = read_data(conn, transport_rc);
+                read_data(conn, transport_rc);
                 if (TransportRc::ok == transport_rc)
                 {
-                    if (0 < bytes_read)
+                    const uint8_t* message = nullptr;
+                    uint16_t message_len = 0;
+                    while (next_message(conn, message, message_len))
                     {
                         InputPacket<IPv4EndPoint> input_packet;
-                        input_packet.message.reset(new InputMessage(conn.input_buffer.buffer.data(), bytes_read));
+                        input_packet.message.reset(new InputMessage(message, message_len));
                         input_packet.source = conn.endpoint;
                         messages_queue_.push(std::move(input_packet));
                         rv = true;
@@ -24,6 +24,7 @@
 #include <arpa/inet.h>
 #include <cstring>
 #include <cerrno>
+#include <algorithm>
 
 namespace eprosima {
 namespace uxr {
@@ -36,8 +37,12 @@ extern template class DiscoveryServerLinux<IPv6EndPoint>; // Explicit instantiat
 UDPv6Agent::UDPv6Agent(
         uint16_t agent_port,
         Middleware::Kind middleware_kind)
+#ifdef __APPLE__
     : Server<IPv6EndPoint>{middleware_kind}
-    , poll_fd_{-1, 0, 0}
+#else
+    : Server<IPv6EndPoint>{middleware_kind, UDP_BATCH_SIZE}
+#endif
+    , poll_fds_{}
     , buffer_{0}
     , agent_port_{agent_port}
 #ifdef UAGENT_DISCOVERY_PROFILE
@@ -62,41 +67,112 @@ UDPv6Agent::~UDPv6Agent()
 
 bool UDPv6Agent::init()
 {
-    bool rv = false;
+    bool rv = true;
 
-    poll_fd_.fd = socket(PF_INET6, SOCK_DGRAM, 0);
+    /* One socket per shard, all of them bound to the same port. */
+    poll_fds_.resize(get_shards(), pollfd{-1, 0, 0});
+#ifndef __APPLE__
+    init_batch_buffers();
+#endif
 
-    if (-1 != poll_fd_.fd)
+    for (size_t i = 0; (i < poll_fds_.size()) && rv; ++i)
     {
-        struct sockaddr_in6 address{};
-
-        memset(&address, 0, sizeof(address));
-        address.sin6_family = AF_INET6;
-        address.sin6_addr = in6addr_any;
-        address.sin6_port = htons(uint16_t(agent_port_));
+        rv = open_socket(i);
+    }
 
-        if (-1 != bind(poll_fd_.fd, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)))
+    if (rv)
+    {
+        UXR_AGENT_LOG_INFO(
+            UXR_DECORATE_GREEN("running..."),
+            "port: {}",
+            agent_port_);
+    }
+    else
+    {
+        /* Otherwise the sockets already opened would keep the port bound when starting again. */
+        for (size_t i = 0; i < poll_fds_.size(); ++i)
         {
-            poll_fd_.events = POLLIN;
-            rv = true;
+            close_socket(i);
+        }
+    }
 
-            UXR_AGENT_LOG_DEBUG(
-                UXR_DECORATE_GREEN("port opened"),
-                "port: {}",
-                agent_port_);
+    return rv;
+}
 
-            UXR_AGENT_LOG_INFO(
-                UXR_DECORATE_GREEN("running..."),
-                "port: {}",
-                agent_port_);
+bool UDPv6Agent::fini()
+{
+    bool rv = true;
+    bool closed = false;
+    for (size_t i = 0; i < poll_fds_.size(); ++i)
+    {
+        if (-1 != poll_fds_[i].fd)
+        {
+            rv = close_socket(i) && rv;
+            closed = true;
         }
-        else
+    }
+
+    if (rv && closed)
+    {
+        UXR_AGENT_LOG_INFO(
+            UXR_DECORATE_GREEN("server stopped"),
+            "port: {}",
+            agent_port_);
+    }
+    return rv;
+}
+
+bool UDPv6Agent::open_socket(size_t shard_id)
+{
+    bool rv = false;
+    struct pollfd& poll_fd = poll_fds_[shard_id];
+
+    poll_fd.fd = socket(PF_INET6, SOCK_DGRAM, 0);
+
+    if (-1 != poll_fd.fd)
+    {
+        int reuse = 1;
+        if ((1 < poll_fds_.size()) &&
+            (-1 == setsockopt(poll_fd.fd, SOL_SOCKET, SO_REUSEPORT, &reuse, sizeof(reuse))))
         {
             UXR_AGENT_LOG_ERROR(
-                UXR_DECORATE_RED("bind error"),
+                UXR_DECORATE_RED("SO_REUSEPORT socket option failed"),
                 "port: {}, errno: {}",
                 agent_port_, errno);
         }
+        else
+        {
+            struct sockaddr_in6 address{};
+
+            memset(&address, 0, sizeof(address));
+            address.sin6_family = AF_INET6;
+            address.sin6_addr = in6addr_any;
+            address.sin6_port = htons(uint16_t(agent_port_));
+
+            if (-1 != bind(poll_fd.fd, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)))
+            {
+                poll_fd.events = POLLIN;
+                rv = true;
+
+                UXR_AGENT_LOG_DEBUG(
+                    UXR_DECORATE_GREEN("port opened"),
+                    "port: {}, shard: {}",
+                    agent_port_, shard_id);
+            }
+            else
+            {
+                UXR_AGENT_LOG_ERROR(
+                    UXR_DECORATE_RED("bind error"),
+                    "port: {}, errno: {}",
+                    agent_port_, errno);
+            }
+        }
+
+        if (!rv)
+        {
+            ::close(poll_fd.fd);
+            poll_fd.fd = -1;
+        }
     }
     else
     {
@@ -109,32 +185,70 @@ bool UDPv6Agent::init()
     return rv;
 }
 
-bool UDPv6Agent::fini()
+bool UDPv6Agent::close_socket(size_t shard_id)
 {
-    if (-1 == poll_fd_.fd)
+    bool rv = true;
+    struct pollfd& poll_fd = poll_fds_[shard_id];
+    if (-1 != poll_fd.fd)
     {
-        return true;
+        if (0 == ::close(poll_fd.fd))
+        {
+            poll_fd.fd = -1;
+        }
+        else
+        {
+            rv = false;
+            UXR_AGENT_LOG_ERROR(
+                UXR_DECORATE_RED("socket error"),
+                "port: {}, errno: {}",
+                agent_port_, errno);
+        }
     }
+    return rv;
+}
 
-    bool rv = false;
-    if (0 == ::close(poll_fd_.fd))
+#ifndef __APPLE__
+void UDPv6Agent::init_batch_buffers()
+{
+    if (batch_buffers_.size() == poll_fds_.size())
     {
-        poll_fd_.fd = -1;
-        rv = true;
-        UXR_AGENT_LOG_INFO(
-            UXR_DECORATE_GREEN("server stopped"),
-            "port: {}",
-            agent_port_);
+        return;
     }
-    else
+
+    batch_buffers_.clear();
+    for (size_t shard_id = 0; shard_id < poll_fds_.size(); ++shard_id)
     {
-        UXR_AGENT_LOG_ERROR(
-            UXR_DECORATE_RED("socket error"),
-            "port: {}, errno: {}",
-            agent_port_, errno);
+        std::unique_ptr<BatchBuffers> batch_buffers(new BatchBuffers());
+        batch_buffers->recv_blocks.resize(UDP_BATCH_SIZE);
+        batch_buffers->recv_tails.resize(size_t(UDP_BATCH_SIZE) * SERVER_BUFFER_SIZE);
+        batch_buffers->recv_iovecs.resize(size_t(UDP_BATCH_SIZE) * 2);
+        batch_buffers->recv_addrs.resize(UDP_BATCH_SIZE);
+        batch_buffers->recv_msgs.resize(UDP_BATCH_SIZE);
+        batch_buffers->send_iovecs.resize(UDP_BATCH_SIZE);
+        batch_buffers->send_addrs.resize(UDP_BATCH_SIZE);
+        batch_buffers->send_msgs.resize(UDP_BATCH_SIZE);
+
+        for (size_t i = 0; i < UDP_BATCH_SIZE; ++i)
+        {
+            /* Datagrams land in a pooled block, only the bytes that do not fit spill to the tail. */
+            batch_buffers->recv_blocks[i] = MessageBufferPool::input_pool().acquire();
+            batch_buffers->recv_iovecs[2 * i].iov_base = batch_buffers->recv_blocks[i].data();
+            batch_buffers->recv_iovecs[2 * i].iov_len = batch_buffers->recv_blocks[i].capacity();
+            batch_buffers->recv_iovecs[(2 * i) + 1].iov_base = batch_buffers->recv_tails.data() + (i * SERVER_BUFFER_SIZE);
+            batch_buffers->recv_iovecs[(2 * i) + 1].iov_len = SERVER_BUFFER_SIZE;
+            batch_buffers->recv_msgs[i].msg_hdr.msg_name = &batch_buffers->recv_addrs[i];
+            batch_buffers->recv_msgs[i].msg_hdr.msg_iov = &batch_buffers->recv_iovecs[2 * i];
+            batch_buffers->recv_msgs[i].msg_hdr.msg_iovlen = 2;
+
+            batch_buffers->send_msgs[i].msg_hdr.msg_name = &batch_buffers->send_addrs[i];
+            batch_buffers->send_msgs[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_in6);
+            batch_buffers->send_msgs[i].msg_hdr.msg_iov = &batch_buffers->send_iovecs[i];
+            batch_buffers->send_msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+        batch_buffers_.push_back(std::move(batch_buffers));
     }
-    return rv;
 }
+#endif
 
 #ifdef UAGENT_DISCOVERY_PROFILE
 bool UDPv6Agent::init_discovery(
@@ -174,20 +288,26 @@ bool UDPv6Agent::recv_message(
     struct sockaddr_in6 client_addr{};
     socklen_t client_addr_len = sizeof(struct sockaddr_in6);
 
-    int poll_rv = poll(&poll_fd_, 1, timeout);
+    int poll_rv = poll(&poll_fds_[0], 1, timeout);
     if (0 < poll_rv)
     {
-        ssize_t bytes_received =
-            recvfrom(
-                poll_fd_.fd,
-                buffer_,
-                sizeof(buffer_),
-                0,
-                reinterpret_cast<sockaddr*>(&client_addr),
-                &client_addr_len);
+        MessageBuffer block = MessageBufferPool::input_pool().acquire();
+        struct iovec iovecs[2];
+        iovecs[0].iov_base = block.data();
+        iovecs[0].iov_len = block.capacity();
+        iovecs[1].iov_base = buffer_;
+        iovecs[1].iov_len = sizeof(buffer_);
+
+        struct msghdr msg{};
+        msg.msg_name = &client_addr;
+        msg.msg_namelen = client_addr_len;
+        msg.msg_iov = iovecs;
+        msg.msg_iovlen = 2;
+
+        ssize_t bytes_received = recvmsg(poll_fds_[0].fd, &msg, 0);
         if (-1 != bytes_received)
         {
-            input_packet.message.reset(new InputMessage(buffer_, size_t(bytes_received)));
+            input_packet.message.reset(new InputMessage(std::move(block), buffer_, size_t(bytes_received)));
             std::array<uint8_t, 16> addr{};
             std::copy(std::begin(client_addr.sin6_addr.s6_addr), std::end(client_addr.sin6_addr.s6_addr), addr.begin());
             input_packet.source = IPv6EndPoint(addr, client_addr.sin6_port);
@@ -229,7 +349,7 @@ bool UDPv6Agent::send_message(
 
     ssize_t bytes_sent =
         sendto(
-            poll_fd_.fd,
+            poll_fds_[0].fd,
             output_packet.message->get_buf(),
             output_packet.message->get_len(),
             0,
@@ -258,11 +378,150 @@ bool UDPv6Agent::send_message(
     return rv;
 }
 
+#ifndef __APPLE__
+bool UDPv6Agent::recv_message(
+        std::vector<InputPacket<IPv6EndPoint>>& input_packets,
+        size_t shard_id,
+        int timeout,
+        TransportRc& transport_rc)
+{
+    bool rv = false;
+    struct pollfd& poll_fd = poll_fds_[shard_id];
+    BatchBuffers& batch_buffers = *batch_buffers_[shard_id];
+
+    int poll_rv = poll(&poll_fd, 1, timeout);
+    if (0 < poll_rv)
+    {
+        for (auto& msg : batch_buffers.recv_msgs)
+        {
+            msg.msg_hdr.msg_namelen = sizeof(struct sockaddr_in6);
+        }
+
+        /* Drain up to UDP_BATCH_SIZE datagrams already queued in the socket. */
+        int messages_received =
+            recvmmsg(
+                poll_fd.fd,
+                batch_buffers.recv_msgs.data(),
+                static_cast<unsigned int>(batch_buffers.recv_msgs.size()),
+                MSG_DONTWAIT,
+                nullptr);
+        if (0 < messages_received)
+        {
+            for (size_t i = 0; i < size_t(messages_received); ++i)
+            {
+                InputPacket<IPv6EndPoint> input_packet;
+                MessageBuffer& block = batch_buffers.recv_blocks[i];
+                input_packet.message.reset(
+                    new InputMessage(
+                        std::move(block),
+                        static_cast<const uint8_t*>(batch_buffers.recv_iovecs[(2 * i) + 1].iov_base),
+                        size_t(batch_buffers.recv_msgs[i].msg_len)));
+                block = MessageBufferPool::input_pool().acquire();
+                batch_buffers.recv_iovecs[2 * i].iov_base = block.data();
+                batch_buffers.recv_iovecs[2 * i].iov_len = block.capacity();
+                std::array<uint8_t, 16> addr{};
+                std::copy(std::begin(batch_buffers.recv_addrs[i].sin6_addr.s6_addr), std::end(batch_buffers.recv_addrs[i].sin6_addr.s6_addr), addr.begin());
+                input_packet.source = IPv6EndPoint(addr, batch_buffers.recv_addrs[i].sin6_port);
+
+                uint32_t raw_client_key = 0u;
+                Server<IPv6EndPoint>::get_client_key(input_packet.source, raw_client_key);
+                UXR_AGENT_LOG_MESSAGE(
+                    UXR_DECORATE_YELLOW("[==>> UDP <<==]"),
+                    raw_client_key,
+                    input_packet.message->get_buf(),
+                    input_packet.message->get_len());
+
+                input_packets.push_back(std::move(input_packet));
+            }
+            rv = true;
+        }
+        else if ((EAGAIN == errno) || (EWOULDBLOCK == errno))
+        {
+            transport_rc = TransportRc::timeout_error;
+        }
+        else
+        {
+            transport_rc = TransportRc::server_error;
+        }
+    }
+    else
+    {
+        transport_rc = (0 == poll_rv) ? TransportRc::timeout_error : TransportRc::server_error;
+    }
+
+    return rv;
+}
+
+bool UDPv6Agent::send_message(
+        std::vector<OutputPacket<IPv6EndPoint>>& output_packets,
+        size_t shard_id,
+        TransportRc& transport_rc)
+{
+    struct pollfd& poll_fd = poll_fds_[shard_id];
+    BatchBuffers& batch_buffers = *batch_buffers_[shard_id];
+    size_t packets_sent = 0;
+    while (packets_sent < output_packets.size())
+    {
+        size_t batch_size = (std::min)(output_packets.size() - packets_sent, batch_buffers.send_msgs.size());
+        for (size_t i = 0; i < batch_size; ++i)
+        {
+            const OutputPacket<IPv6EndPoint>& output_packet = output_packets[packets_sent + i];
+            batch_buffers.send_addrs[i] = {};
+            batch_buffers.send_addrs[i].sin6_family = AF_INET6;
+            batch_buffers.send_addrs[i].sin6_port = output_packet.destination.get_port();
+            const std::array<uint8_t, 16>& destination = output_packet.destination.get_addr();
+            std::copy(destination.begin(), destination.end(), std::begin(batch_buffers.send_addrs[i].sin6_addr.s6_addr));
+            batch_buffers.send_iovecs[i].iov_base = output_packet.message->get_buf();
+            batch_buffers.send_iovecs[i].iov_len = output_packet.message->get_len();
+        }
+
+        int messages_sent =
+            sendmmsg(
+                poll_fd.fd,
+                batch_buffers.send_msgs.data(),
+                static_cast<unsigned int>(batch_size),
+                0);
+        if (0 >= messages_sent)
+        {
+            transport_rc = TransportRc::server_error;
+            break;
+        }
+
+        for (size_t i = 0; i < size_t(messages_sent); ++i)
+        {
+            const OutputPacket<IPv6EndPoint>& output_packet = output_packets[packets_sent + i];
+            if (size_t(batch_buffers.send_msgs[i].msg_len) == output_packet.message->get_len())
+            {
+                uint32_t raw_client_key = 0u;
+                Server<IPv6EndPoint>::get_client_key(output_packet.destination, raw_client_key);
+                UXR_AGENT_LOG_MESSAGE(
+                    UXR_DECORATE_YELLOW("[** <<UDP>> **]"),
+                    raw_client_key,
+                    output_packet.message->get_buf(),
+                    output_packet.message->get_len());
+            }
+        }
+        packets_sent += size_t(messages_sent);
+    }
+
+    output_packets.erase(output_packets.begin(), output_packets.begin() + std::ptrdiff_t(packets_sent));
+    return output_packets.empty();
+}
+#endif
+
 bool UDPv6Agent::handle_error(
         TransportRc /*transport_rc*/)
 {
     return fini() && init();
 }
 
+bool UDPv6Agent::handle_error(
+        TransportRc /*transport_rc*/,
+        size_t shard_id)
+{
+    /* The sockets of the other shards stay open, their threads may be using them. */
+    return close_socket(shard_id) && open_socket(shard_id);
+}
+
 } // namespace uxr
 } // namespace eprosima
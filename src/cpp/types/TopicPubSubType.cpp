@@ -27,15 +27,18 @@ TopicPubSubType::TopicPubSubType(bool with_key) {
 bool TopicPubSubType::serialize(void *data, rtps::SerializedPayload_t *payload)
 {
     bool rv = false;
-    std::vector<unsigned char>* buffer = reinterpret_cast<std::vector<unsigned char>*>(data);
+    const Sample* sample = static_cast<const Sample*>(data);
     payload->data[0] = 0;
     payload->data[1] = 1;
     payload->data[2] = 0;
     payload->data[3] = 0;
-    if (buffer->size() <= (payload->max_size - 4))
+    if (sample->size() <= (payload->max_size - 4))
     {
-        memcpy(&payload->data[4], buffer->data(), buffer->size());
-        payload->length = uint32_t(buffer->size() + 4); //Get the serialized length
+        if (0 < sample->size())
+        {
+            memcpy(&payload->data[4], sample->data(), sample->size());
+        }
+        payload->length = uint32_t(sample->size() + 4); //Get the serialized length
         rv = true;
     }
     return rv;
@@ -43,25 +46,28 @@ bool TopicPubSubType::serialize(void *data, rtps::SerializedPayload_t *payload)
 
 bool TopicPubSubType::deserialize(rtps::SerializedPayload_t* payload, void* data)
 {
-    std::vector<unsigned char>* buffer = reinterpret_cast<std::vector<unsigned char>*>(data);
-    buffer->assign(payload->data + 4, payload->data + payload->length);
-
-    return true;
+    bool rv = false;
+    if (4 <= payload->length)
+    {
+        static_cast<Sample*>(data)->assign(payload->data + 4, payload->data + payload->length);
+        rv = true;
+    }
+    return rv;
 }
 
 std::function<uint32_t()> TopicPubSubType::getSerializedSizeProvider(void* data) {
     return [data]() -> uint32_t
     {
-        return (uint32_t)reinterpret_cast<std::vector<unsigned char>*>(data)->size() + 4 /*encapsulation*/;
+        return (uint32_t)static_cast<const Sample*>(data)->size() + 4 /*encapsulation*/;
     };
 }
 
 void* TopicPubSubType::createData() {
-    return (void*)new std::vector<unsigned char>;
+    return (void*)new Sample;
 }
 
 void TopicPubSubType::deleteData(void* data) {
-    delete((std::vector<unsigned char>*)data);
+    delete static_cast<Sample*>(data);
 }
 
 bool TopicPubSubType::getKey(void *data, rtps::InstanceHandle_t* handle, bool force_md5)
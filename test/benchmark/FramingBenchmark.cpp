@@ -0,0 +1,155 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/transport/stream_framing/StreamFramingProtocol.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace eprosima {
+namespace uxr {
+namespace benchmarking {
+
+constexpr uint8_t local_addr = 0x01;
+constexpr uint8_t remote_addr = 0x02;
+
+/* Payloads without flags only pay for the CRC, while one flag in eight octets forces frequent escaping. */
+std::vector<uint8_t> make_payload(
+        size_t len,
+        bool with_flags)
+{
+    std::vector<uint8_t> payload(len);
+    for (size_t i = 0; i < len; ++i)
+    {
+        payload[i] = (with_flags && (0 == (i % 8))) ? 0x7E : uint8_t(i % 0x7D);
+    }
+    return payload;
+}
+
+/**
+ * In-memory wire: what a FramingIO writes is read back by the other one.
+ */
+class Wire
+{
+public:
+    Wire()
+        : read_pos_{0}
+        , writer_(
+            remote_addr,
+            [this](uint8_t* buf, size_t len, TransportRc& transport_rc) -> ssize_t
+            {
+                octets_.insert(octets_.end(), buf, buf + len);
+                transport_rc = TransportRc::ok;
+                return ssize_t(len);
+            },
+            [](uint8_t* /* buf */, size_t /* len */, int /* timeout */, TransportRc& transport_rc) -> ssize_t
+            {
+                transport_rc = TransportRc::timeout_error;
+                return 0;
+            })
+        , reader_(
+            local_addr,
+            [](uint8_t* /* buf */, size_t len, TransportRc& transport_rc) -> ssize_t
+            {
+                transport_rc = TransportRc::ok;
+                return ssize_t(len);
+            },
+            [this](uint8_t* buf, size_t len, int /* timeout */, TransportRc& transport_rc) -> ssize_t
+            {
+                size_t read = (std::min)(len, octets_.size() - read_pos_);
+                std::copy(octets_.begin() + std::ptrdiff_t(read_pos_),
+                    octets_.begin() + std::ptrdiff_t(read_pos_ + read), buf);
+                read_pos_ += read;
+                transport_rc = (0 < read) ? TransportRc::ok : TransportRc::timeout_error;
+                return ssize_t(read);
+            })
+    {}
+
+    void clear()
+    {
+        octets_.clear();
+        read_pos_ = 0;
+    }
+
+    void rewind()
+    {
+        read_pos_ = 0;
+    }
+
+    size_t size() const
+    {
+        return octets_.size();
+    }
+
+    FramingIO& writer() { return writer_; }
+
+    FramingIO& reader() { return reader_; }
+
+private:
+    std::vector<uint8_t> octets_;
+    size_t read_pos_;
+    FramingIO writer_;
+    FramingIO reader_;
+};
+
+/* Framing, escaping and CRC of an outgoing message. */
+void BM_WriteFramedMessage(benchmark::State& state)
+{
+    Wire wire;
+    const std::vector<uint8_t> payload = make_payload(size_t(state.range(0)), 0 != state.range(1));
+    TransportRc transport_rc;
+    for (auto _ : state)
+    {
+        wire.clear();
+        benchmark::DoNotOptimize(
+            wire.writer().write_framed_msg(payload.data(), payload.size(), local_addr, transport_rc));
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(payload.size()));
+}
+
+/* Unescaping and CRC check of an incoming message. */
+void BM_ReadFramedMessage(benchmark::State& state)
+{
+    Wire wire;
+    const std::vector<uint8_t> payload = make_payload(size_t(state.range(0)), 0 != state.range(1));
+    TransportRc transport_rc;
+    wire.writer().write_framed_msg(payload.data(), payload.size(), local_addr, transport_rc);
+
+    std::vector<uint8_t> buf(payload.size() + 1);
+    uint8_t addr = 0;
+    size_t len = 0;
+    for (auto _ : state)
+    {
+        wire.rewind();
+        int timeout = 0;
+        len = wire.reader().read_framed_msg(buf.data(), buf.size(), addr, timeout, transport_rc);
+        benchmark::DoNotOptimize(len);
+    }
+    if (len != payload.size())
+    {
+        state.SkipWithError("message not read");
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(payload.size()));
+}
+
+BENCHMARK(BM_WriteFramedMessage)->ArgsProduct({{64, 512, 4096}, {0, 1}})->ArgNames({"len", "flags"});
+BENCHMARK(BM_ReadFramedMessage)->ArgsProduct({{64, 512, 4096}, {0, 1}})->ArgNames({"len", "flags"});
+
+} // namespace benchmarking
+} // namespace uxr
+} // namespace eprosima
+
+BENCHMARK_MAIN();
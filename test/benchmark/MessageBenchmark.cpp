@@ -0,0 +1,117 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/message/InputMessage.hpp>
+#include <uxr/agent/message/OutputMessage.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+namespace eprosima {
+namespace uxr {
+namespace benchmarking {
+
+constexpr size_t message_capacity = 65535;
+
+dds::xrce::MessageHeader make_header()
+{
+    dds::xrce::MessageHeader header;
+    header.session_id(0x81);
+    header.stream_id(dds::xrce::STREAMID_BUILTIN_RELIABLE);
+    header.sequence_nr(0);
+    return header;
+}
+
+dds::xrce::WRITE_DATA_Payload_Data make_write_data(
+        size_t payload_len)
+{
+    dds::xrce::WRITE_DATA_Payload_Data write_data;
+    write_data.object_id({0x00, 0x15});
+    write_data.request_id({0x00, 0x01});
+    write_data.data().serialized_data().assign(payload_len, 0xAA);
+    return write_data;
+}
+
+/* Raw message with the given number of WRITE_DATA submessages, as received from a client. */
+std::vector<uint8_t> make_raw_message(
+        size_t submessages,
+        size_t payload_len)
+{
+    OutputMessage output(make_header(), message_capacity);
+    dds::xrce::WRITE_DATA_Payload_Data write_data = make_write_data(payload_len);
+    for (size_t i = 0; i < submessages; ++i)
+    {
+        output.append_submessage(dds::xrce::WRITE_DATA, write_data);
+    }
+    return std::vector<uint8_t>(output.get_buf(), output.get_buf() + output.get_len());
+}
+
+/* Copy of the received bytes, header deserialization and submessage indexing. */
+void BM_InputMessageConstruction(benchmark::State& state)
+{
+    const std::vector<uint8_t> raw = make_raw_message(size_t(state.range(0)), 64);
+    for (auto _ : state)
+    {
+        InputMessage input(raw.data(), raw.size());
+        benchmark::DoNotOptimize(input.count_submessages());
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(raw.size()));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/* Construction followed by the walk the Processor does: every subheader and its payload. */
+void BM_InputMessageIteration(benchmark::State& state)
+{
+    const std::vector<uint8_t> raw = make_raw_message(size_t(state.range(0)), 64);
+    dds::xrce::WRITE_DATA_Payload_Data write_data;
+    for (auto _ : state)
+    {
+        InputMessage input(raw.data(), raw.size());
+        while (input.prepare_next_submessage())
+        {
+            input.get_payload(write_data);
+            benchmark::DoNotOptimize(write_data.data().serialized_data().data());
+        }
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(raw.size()));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/* Serialization of a DATA submessage, its subheader included, into a fresh message. */
+void BM_OutputMessageAppendSubmessage(benchmark::State& state)
+{
+    const dds::xrce::MessageHeader header = make_header();
+    dds::xrce::DATA_Payload_Data data;
+    data.object_id({0x00, 0x16});
+    data.request_id({0x00, 0x01});
+    data.data().serialized_data().assign(size_t(state.range(0)), 0xAA);
+    const size_t len = header.getCdrSerializedSize() + 4 + data.getCdrSerializedSize();
+    for (auto _ : state)
+    {
+        OutputMessage output(header, len);
+        benchmark::DoNotOptimize(output.append_submessage(dds::xrce::DATA, data));
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(len));
+}
+
+BENCHMARK(BM_InputMessageConstruction)->Arg(1)->Arg(8)->Arg(64);
+BENCHMARK(BM_InputMessageIteration)->Arg(1)->Arg(8)->Arg(64);
+BENCHMARK(BM_OutputMessageAppendSubmessage)->Arg(16)->Arg(512)->Arg(8192);
+
+} // namespace benchmarking
+} // namespace uxr
+} // namespace eprosima
+
+BENCHMARK_MAIN();
@@ -0,0 +1,200 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/scheduler/PacketScheduler.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace eprosima {
+namespace uxr {
+namespace benchmarking {
+
+/**
+ * Previous mutex-based PacketScheduler, kept as the baseline.
+ */
+template<class T>
+class MutexPacketScheduler
+{
+public:
+    MutexPacketScheduler(
+            size_t max_size)
+        : max_size_{max_size}
+    {}
+
+    void set_priority_size(uint8_t priority, size_t size)
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        sizes_[priority] = size;
+    }
+
+    void init()
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        sizes_[0] = max_size_;
+        running_cond_ = true;
+    }
+
+    void deinit()
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        running_cond_ = false;
+        cond_var_.notify_one();
+    }
+
+    void push(
+            T&& element,
+            uint8_t priority)
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (sizes_[priority] <= deque_[priority].size())
+        {
+            deque_[priority].pop_front();
+        }
+        deque_[priority].push_back(std::move(element));
+        cond_var_.notify_one();
+    }
+
+    bool pop(
+            T& element)
+    {
+        bool rv = false;
+        std::unique_lock<std::mutex> lock(mtx_);
+        cond_var_.wait(lock, [this] { return !(empty() && running_cond_); });
+        if (running_cond_)
+        {
+            uint8_t available_priority = 0;
+            for (auto iter = deque_.rbegin(); iter != deque_.rend(); ++iter)
+            {
+                if (iter->second.size() > 0)
+                {
+                    available_priority = iter->first;
+                    break;
+                }
+            }
+            element = std::move(deque_[available_priority].front());
+            deque_[available_priority].pop_front();
+            rv = true;
+            cond_var_.notify_one();
+        }
+        return rv;
+    }
+
+private:
+    bool empty()
+    {
+        for (auto& deque : deque_)
+        {
+            if (!deque.second.empty())
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::map<uint8_t, std::deque<T>> deque_;
+    std::map<uint8_t, size_t> sizes_;
+    std::mutex mtx_;
+    std::condition_variable cond_var_;
+    bool running_cond_ = false;
+    const size_t max_size_;
+};
+
+/* Same layout as a Packet: owned message plus endpoint. */
+struct FakePacket
+{
+    std::unique_ptr<uint8_t> message;
+    uint64_t endpoint;
+};
+
+const size_t queue_size = 32000;
+
+template<class Scheduler>
+void BM_PushPop(benchmark::State& state)
+{
+    Scheduler scheduler(queue_size);
+    scheduler.init();
+    scheduler.set_priority_size(1, 1);
+
+    const int64_t batch = state.range(0);
+    FakePacket packet{};
+    for (auto _ : state)
+    {
+        for (int64_t i = 0; i < batch; ++i)
+        {
+            scheduler.push(FakePacket{nullptr, uint64_t(i)}, 0);
+        }
+        for (int64_t i = 0; i < batch; ++i)
+        {
+            scheduler.pop(packet);
+        }
+        benchmark::DoNotOptimize(packet.endpoint);
+    }
+    scheduler.deinit();
+    state.SetItemsProcessed(state.iterations() * batch);
+}
+
+template<class Scheduler>
+void BM_MultipleProducers(benchmark::State& state)
+{
+    const int producers = int(state.range(0));
+    const int elements_per_producer = 10000;
+
+    Scheduler scheduler(size_t(producers * elements_per_producer));
+    scheduler.init();
+
+    FakePacket packet{};
+    for (auto _ : state)
+    {
+        std::vector<std::thread> threads;
+        for (int p = 0; p < producers; ++p)
+        {
+            threads.emplace_back([&scheduler, elements_per_producer]()
+            {
+                for (int i = 0; i < elements_per_producer; ++i)
+                {
+                    scheduler.push(FakePacket{nullptr, uint64_t(i)}, 0);
+                }
+            });
+        }
+        for (int i = 0; i < producers * elements_per_producer; ++i)
+        {
+            scheduler.pop(packet);
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        benchmark::DoNotOptimize(packet.endpoint);
+    }
+    scheduler.deinit();
+    state.SetItemsProcessed(state.iterations() * producers * elements_per_producer);
+}
+
+BENCHMARK_TEMPLATE(BM_PushPop, MutexPacketScheduler<FakePacket>)->Arg(1)->Arg(64);
+BENCHMARK_TEMPLATE(BM_PushPop, PacketScheduler<FakePacket>)->Arg(1)->Arg(64);
+BENCHMARK_TEMPLATE(BM_MultipleProducers, MutexPacketScheduler<FakePacket>)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_MultipleProducers, PacketScheduler<FakePacket>)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime();
+
+} // namespace benchmarking
+} // namespace uxr
+} // namespace eprosima
+
+BENCHMARK_MAIN();
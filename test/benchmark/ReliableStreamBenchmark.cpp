@@ -0,0 +1,210 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/config.hpp>
+#include <uxr/agent/client/session/stream/SeqNumRing.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace eprosima {
+namespace uxr {
+namespace benchmarking {
+
+/* Same size as an InputMessagePtr. */
+using FakeMessagePtr = std::unique_ptr<uint8_t>;
+
+/**
+ * Previous map-based storage of the reliable streams, kept as the baseline.
+ */
+class MapWindow
+{
+public:
+    bool insert(
+            SeqNum seq_num,
+            FakeMessagePtr&& message)
+    {
+        return messages_.emplace(seq_num, std::move(message)).second;
+    }
+
+    bool contains(
+            SeqNum seq_num)
+    {
+        return messages_.end() != messages_.find(seq_num);
+    }
+
+    bool take(
+            SeqNum seq_num,
+            FakeMessagePtr& message)
+    {
+        bool rv = false;
+        auto it = messages_.find(seq_num);
+        if (it != messages_.end())
+        {
+            message = std::move(it->second);
+            messages_.erase(it);
+            rv = true;
+        }
+        return rv;
+    }
+
+private:
+    std::map<uint16_t, FakeMessagePtr> messages_;
+};
+
+class RingWindow
+{
+public:
+    RingWindow()
+        : messages_(RELIABLE_STREAM_DEPTH)
+    {}
+
+    bool insert(
+            SeqNum seq_num,
+            FakeMessagePtr&& message)
+    {
+        bool rv = false;
+        FakeMessagePtr& slot = messages_[seq_num];
+        if (!slot)
+        {
+            slot = std::move(message);
+            rv = true;
+        }
+        return rv;
+    }
+
+    bool contains(
+            SeqNum seq_num)
+    {
+        return bool(messages_[seq_num]);
+    }
+
+    bool take(
+            SeqNum seq_num,
+            FakeMessagePtr& message)
+    {
+        bool rv = false;
+        FakeMessagePtr& slot = messages_[seq_num];
+        if (slot)
+        {
+            message = std::move(slot);
+            rv = true;
+        }
+        return rv;
+    }
+
+private:
+    SeqNumRing<FakeMessagePtr> messages_;
+};
+
+/* Messages are allocated once, only the window storage is measured. */
+std::vector<FakeMessagePtr> make_messages()
+{
+    std::vector<FakeMessagePtr> messages;
+    for (uint16_t i = 0; i < RELIABLE_STREAM_DEPTH; ++i)
+    {
+        messages.emplace_back(new uint8_t(uint8_t(i)));
+    }
+    return messages;
+}
+
+/* Fills the window in order and pops it, as a lossless link does. */
+template<class Window>
+void BM_InOrder(benchmark::State& state)
+{
+    Window window;
+    std::vector<FakeMessagePtr> messages = make_messages();
+    SeqNum seq_num = 0;
+    for (auto _ : state)
+    {
+        for (uint16_t i = 0; i < RELIABLE_STREAM_DEPTH; ++i)
+        {
+            window.insert(seq_num + i, std::move(messages[i]));
+        }
+        for (uint16_t i = 0; i < RELIABLE_STREAM_DEPTH; ++i)
+        {
+            window.take(seq_num, messages[i]);
+            seq_num += 1;
+        }
+        benchmark::DoNotOptimize(messages.data());
+    }
+    state.SetItemsProcessed(state.iterations() * RELIABLE_STREAM_DEPTH);
+}
+
+/* Fills the window in reverse order, building an acknack after each message, and pops it. */
+template<class Window>
+void BM_OutOfOrder(benchmark::State& state)
+{
+    Window window;
+    std::vector<FakeMessagePtr> messages = make_messages();
+    SeqNum seq_num = 0;
+    uint16_t nack_bitmap = 0;
+    for (auto _ : state)
+    {
+        for (int i = RELIABLE_STREAM_DEPTH - 1; i >= 0; --i)
+        {
+            window.insert(seq_num + i, std::move(messages[size_t(i)]));
+            nack_bitmap = 0;
+            for (uint16_t j = 0; j < RELIABLE_STREAM_DEPTH; ++j)
+            {
+                nack_bitmap = uint16_t(nack_bitmap | (window.contains(seq_num + j) ? 0 : (1 << j)));
+            }
+        }
+        for (uint16_t i = 0; i < RELIABLE_STREAM_DEPTH; ++i)
+        {
+            window.take(seq_num, messages[i]);
+            seq_num += 1;
+        }
+        benchmark::DoNotOptimize(nack_bitmap);
+    }
+    state.SetItemsProcessed(state.iterations() * RELIABLE_STREAM_DEPTH);
+}
+
+/* Lookups of retransmissions and acknacks over a full window. */
+template<class Window>
+void BM_Lookup(benchmark::State& state)
+{
+    Window window;
+    std::vector<FakeMessagePtr> messages = make_messages();
+    for (uint16_t i = 0; i < RELIABLE_STREAM_DEPTH; ++i)
+    {
+        window.insert(i, std::move(messages[i]));
+    }
+    size_t found = 0;
+    for (auto _ : state)
+    {
+        for (uint16_t i = 0; i < RELIABLE_STREAM_DEPTH; ++i)
+        {
+            found += window.contains(i) ? 1 : 0;
+        }
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(state.iterations() * RELIABLE_STREAM_DEPTH);
+}
+
+BENCHMARK_TEMPLATE(BM_InOrder, MapWindow);
+BENCHMARK_TEMPLATE(BM_InOrder, RingWindow);
+BENCHMARK_TEMPLATE(BM_OutOfOrder, MapWindow);
+BENCHMARK_TEMPLATE(BM_OutOfOrder, RingWindow);
+BENCHMARK_TEMPLATE(BM_Lookup, MapWindow);
+BENCHMARK_TEMPLATE(BM_Lookup, RingWindow);
+
+} // namespace benchmarking
+} // namespace uxr
+} // namespace eprosima
+
+BENCHMARK_MAIN();
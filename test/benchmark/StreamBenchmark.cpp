@@ -0,0 +1,135 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/client/session/stream/InputStream.hpp>
+#include <uxr/agent/client/session/stream/OutputStream.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+namespace eprosima {
+namespace uxr {
+namespace benchmarking {
+
+constexpr dds::xrce::SessionId session_id = 0x81;
+constexpr dds::xrce::ClientKey client_key = {0xAA, 0xBB, 0xCC, 0xDD};
+constexpr size_t mtu = 512;
+
+/* Raw message with a single WRITE_DATA submessage, as received from a client. */
+std::vector<uint8_t> make_raw_message()
+{
+    dds::xrce::MessageHeader header;
+    header.session_id(session_id);
+    header.stream_id(dds::xrce::STREAMID_BUILTIN_RELIABLE);
+    dds::xrce::WRITE_DATA_Payload_Data write_data;
+    write_data.data().serialized_data().assign(64, 0xAA);
+
+    OutputMessage output(header, mtu);
+    output.append_submessage(dds::xrce::WRITE_DATA, write_data);
+    return std::vector<uint8_t>(output.get_buf(), output.get_buf() + output.get_len());
+}
+
+/* Fills the window, sends it, resends its first message and acknowledges it, as a lossy link does. */
+void BM_ReliableOutputStreamCycle(benchmark::State& state)
+{
+    ReliableOutputStream stream;
+    const SessionInfo session_info{client_key, session_id, mtu};
+    dds::xrce::DATA_Payload_Data data;
+    data.data().serialized_data().assign(size_t(state.range(0)), 0xAA);
+
+    SeqNum first_unacked = 0;
+    int64_t messages = 0;
+    for (auto _ : state)
+    {
+        const uint16_t window = stream.get_window();
+        for (uint16_t i = 0; i < window; ++i)
+        {
+            stream.push_submessage(
+                session_info, dds::xrce::STREAMID_BUILTIN_RELIABLE, dds::xrce::DATA, data, std::chrono::milliseconds(0));
+        }
+
+        OutputMessagePtr output_message;
+        uint16_t sent = 0;
+        while (stream.get_next_message(output_message))
+        {
+            ++sent;
+        }
+        stream.get_message(first_unacked, output_message);
+        benchmark::DoNotOptimize(output_message);
+
+        first_unacked += sent;
+        stream.update_from_acknack(first_unacked);
+        messages += sent;
+    }
+    state.SetItemsProcessed(messages);
+}
+
+/* Receives a window in order, popping each message once it arrives. */
+void BM_ReliableInputStreamInOrder(benchmark::State& state)
+{
+    ReliableInputStream stream;
+    const std::vector<uint8_t> raw = make_raw_message();
+    dds::xrce::ACKNACK_Payload acknack;
+    InputMessagePtr input_message;
+
+    SeqNum seq_num = 0;
+    for (auto _ : state)
+    {
+        for (uint16_t i = 0; i < RELIABLE_STREAM_DEPTH; ++i)
+        {
+            stream.emplace_message(seq_num, raw.data(), raw.size());
+            stream.pop_message(input_message);
+            seq_num += 1;
+        }
+        stream.fill_acknack(acknack);
+        benchmark::DoNotOptimize(acknack.nack_bitmap());
+    }
+    state.SetItemsProcessed(state.iterations() * RELIABLE_STREAM_DEPTH);
+}
+
+/* Receives a window in reverse order, building an acknack after each message, and pops it. */
+void BM_ReliableInputStreamOutOfOrder(benchmark::State& state)
+{
+    ReliableInputStream stream;
+    const std::vector<uint8_t> raw = make_raw_message();
+    dds::xrce::ACKNACK_Payload acknack;
+    InputMessagePtr input_message;
+
+    SeqNum seq_num = 0;
+    for (auto _ : state)
+    {
+        for (int i = RELIABLE_STREAM_DEPTH - 1; i >= 0; --i)
+        {
+            stream.emplace_message(seq_num + i, raw.data(), raw.size());
+            stream.fill_acknack(acknack);
+        }
+        while (stream.pop_message(input_message))
+        {
+            seq_num += 1;
+        }
+        benchmark::DoNotOptimize(acknack.nack_bitmap());
+    }
+    state.SetItemsProcessed(state.iterations() * RELIABLE_STREAM_DEPTH);
+}
+
+BENCHMARK(BM_ReliableOutputStreamCycle)->Arg(16)->Arg(256);
+BENCHMARK(BM_ReliableInputStreamInOrder);
+BENCHMARK(BM_ReliableInputStreamOutOfOrder);
+
+} // namespace benchmarking
+} // namespace uxr
+} // namespace eprosima
+
+BENCHMARK_MAIN();
@@ -0,0 +1,56 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/utils/TokenBucket.hpp>
+
+#include <benchmark/benchmark.h>
+
+namespace eprosima {
+namespace uxr {
+namespace benchmarking {
+
+/* The bucket never runs out of tokens, so only the bookkeeping of each call is measured. */
+constexpr size_t rate = size_t(1) << 40;
+
+void BM_ConsumeTokens(benchmark::State& state)
+{
+    utils::TokenBucket bucket(rate);
+    const size_t tokens = size_t(state.range(0));
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(bucket.consume_tokens(tokens, std::chrono::milliseconds(0)));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_TryConsumeTokens(benchmark::State& state)
+{
+    utils::TokenBucket bucket(rate);
+    const size_t tokens = size_t(state.range(0));
+    std::chrono::steady_clock::time_point retry_time;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(bucket.try_consume_tokens(tokens, retry_time));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_ConsumeTokens)->Arg(1)->Arg(512);
+BENCHMARK(BM_TryConsumeTokens)->Arg(1)->Arg(512);
+
+} // namespace benchmarking
+} // namespace uxr
+} // namespace eprosima
+
+BENCHMARK_MAIN();
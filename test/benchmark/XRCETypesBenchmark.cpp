@@ -0,0 +1,137 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/types/XRCETypes.hpp>
+#include <uxr/agent/types/MessageHeader.hpp>
+
+#include <benchmark/benchmark.h>
+#include <fastcdr/Cdr.h>
+#include <fastcdr/FastBuffer.h>
+
+#include <vector>
+
+namespace eprosima {
+namespace uxr {
+namespace benchmarking {
+
+dds::xrce::MessageHeader make_message_header()
+{
+    dds::xrce::MessageHeader header;
+    header.session_id(0x01);
+    header.stream_id(dds::xrce::STREAMID_BUILTIN_RELIABLE);
+    header.sequence_nr(0x1234);
+    header.client_key({0xAA, 0xBB, 0xCC, 0xDD});
+    return header;
+}
+
+dds::xrce::CREATE_CLIENT_Payload make_create_client()
+{
+    dds::xrce::CREATE_CLIENT_Payload create_client;
+    create_client.client_representation().xrce_cookie(dds::xrce::XRCE_COOKIE);
+    create_client.client_representation().xrce_version(dds::xrce::XRCE_VERSION);
+    create_client.client_representation().xrce_vendor_id({0x0F, 0x0F});
+    create_client.client_representation().client_key({0xAA, 0xBB, 0xCC, 0xDD});
+    create_client.client_representation().session_id(0x81);
+    create_client.client_representation().mtu(512);
+    return create_client;
+}
+
+dds::xrce::CREATE_Payload make_create_participant()
+{
+    dds::xrce::CREATE_Payload create;
+    create.request_id({0x00, 0x01});
+    create.object_id({0x00, 0x11});
+    dds::xrce::OBJK_PARTICIPANT_Representation participant;
+    participant.domain_id(0);
+    participant.representation().object_reference("default_xrce_participant");
+    create.object_representation().participant(participant);
+    return create;
+}
+
+dds::xrce::WRITE_DATA_Payload_Data make_write_data()
+{
+    dds::xrce::WRITE_DATA_Payload_Data write_data;
+    write_data.request_id({0x00, 0x02});
+    write_data.object_id({0x00, 0x15});
+    write_data.data().serialized_data().assign(256, 0xAA);
+    return write_data;
+}
+
+dds::xrce::ACKNACK_Payload make_acknack()
+{
+    dds::xrce::ACKNACK_Payload acknack;
+    acknack.first_unacked_seq_num(0x1234);
+    acknack.nack_bitmap({0x0F, 0xF0});
+    acknack.stream_id(dds::xrce::STREAMID_BUILTIN_RELIABLE);
+    return acknack;
+}
+
+dds::xrce::HEARTBEAT_Payload make_heartbeat()
+{
+    dds::xrce::HEARTBEAT_Payload heartbeat;
+    heartbeat.first_unacked_seq_nr(0x1234);
+    heartbeat.last_unacked_seq_nr(0x1243);
+    heartbeat.stream_id(dds::xrce::STREAMID_BUILTIN_RELIABLE);
+    return heartbeat;
+}
+
+template<class T>
+void BM_Serialize(benchmark::State& state, T data)
+{
+    std::vector<char> buf(data.getCdrSerializedSize());
+    fastcdr::FastBuffer fastbuffer(buf.data(), buf.size());
+    for (auto _ : state)
+    {
+        fastcdr::Cdr serializer(fastbuffer);
+        data.serialize(serializer);
+        benchmark::DoNotOptimize(serializer.getSerializedDataLength());
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(buf.size()));
+}
+
+template<class T>
+void BM_Deserialize(benchmark::State& state, T data)
+{
+    std::vector<char> buf(data.getCdrSerializedSize());
+    fastcdr::FastBuffer fastbuffer(buf.data(), buf.size());
+    fastcdr::Cdr serializer(fastbuffer);
+    data.serialize(serializer);
+    for (auto _ : state)
+    {
+        fastcdr::Cdr deserializer(fastbuffer);
+        T deserialized;
+        deserialized.deserialize(deserializer);
+        benchmark::DoNotOptimize(deserialized);
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(buf.size()));
+}
+
+BENCHMARK_CAPTURE(BM_Serialize, MessageHeader, make_message_header());
+BENCHMARK_CAPTURE(BM_Deserialize, MessageHeader, make_message_header());
+BENCHMARK_CAPTURE(BM_Serialize, CREATE_CLIENT_Payload, make_create_client());
+BENCHMARK_CAPTURE(BM_Deserialize, CREATE_CLIENT_Payload, make_create_client());
+BENCHMARK_CAPTURE(BM_Serialize, CREATE_Payload, make_create_participant());
+BENCHMARK_CAPTURE(BM_Deserialize, CREATE_Payload, make_create_participant());
+BENCHMARK_CAPTURE(BM_Serialize, WRITE_DATA_Payload_Data, make_write_data());
+BENCHMARK_CAPTURE(BM_Deserialize, WRITE_DATA_Payload_Data, make_write_data());
+BENCHMARK_CAPTURE(BM_Serialize, ACKNACK_Payload, make_acknack());
+BENCHMARK_CAPTURE(BM_Deserialize, ACKNACK_Payload, make_acknack());
+BENCHMARK_CAPTURE(BM_Serialize, HEARTBEAT_Payload, make_heartbeat());
+BENCHMARK_CAPTURE(BM_Deserialize, HEARTBEAT_Payload, make_heartbeat());
+
+} // namespace benchmarking
+} // namespace uxr
+} // namespace eprosima
+
+BENCHMARK_MAIN();
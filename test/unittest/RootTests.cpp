@@ -121,6 +121,49 @@ TEST_F(RootTests, DeleteNoExistingClient)
     ASSERT_EQ(dds::xrce::STATUS_ERR_UNKNOWN_REFERENCE, response.status());
 }
 
+TEST_F(RootTests, GetClientAfterCreateAndDelete)
+{
+    dds::xrce::AGENT_Representation agent_representation;
+    dds::xrce::ResultStatus response = root_.create_client(
+                generate_create_client_payload().client_representation(),
+                agent_representation,
+                Middleware::Kind::FAST);
+    ASSERT_EQ(dds::xrce::STATUS_OK, response.status());
+    std::shared_ptr<ProxyClient> client = root_.get_client(client_key);
+    ASSERT_TRUE(bool(client));
+
+    response = root_.delete_client(client_key);
+    ASSERT_EQ(dds::xrce::STATUS_OK, response.status());
+    ASSERT_FALSE(bool(root_.get_client(client_key)));
+}
+
+TEST_F(RootTests, GetClientsSnapshot)
+{
+    dds::xrce::CREATE_CLIENT_Payload create_data = generate_create_client_payload();
+    dds::xrce::AGENT_Representation agent_representation;
+    const uint8_t client_count = 100;
+    for (uint8_t i = 0; i < client_count; ++i)
+    {
+        create_data.client_representation().client_key({{0xAA, 0xBB, 0xCC, i}});
+        dds::xrce::ResultStatus response = root_.create_client(
+                    create_data.client_representation(),
+                    agent_representation,
+                    Middleware::Kind::FAST);
+        ASSERT_EQ(dds::xrce::STATUS_OK, response.status());
+    }
+
+    std::vector<std::shared_ptr<ProxyClient>> clients;
+    root_.get_clients(clients);
+    ASSERT_EQ(size_t(client_count), clients.size());
+
+    /* The snapshot is not affected by later deletions. */
+    ASSERT_EQ(dds::xrce::STATUS_OK, root_.delete_client({{0xAA, 0xBB, 0xCC, 0x00}}).status());
+    ASSERT_EQ(size_t(client_count), clients.size());
+
+    root_.get_clients(clients);
+    ASSERT_EQ(size_t(client_count - 1), clients.size());
+}
+
 /*
 class ProxyClientTests : public CommonData, public ::testing::Test
 {
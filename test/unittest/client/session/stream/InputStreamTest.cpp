@@ -14,6 +14,7 @@
 
 
 #include <uxr/agent/client/session/stream/InputStream.hpp>
+#include <algorithm>
 #include <map>
 #include <queue>
 #include <mutex>
@@ -340,6 +341,108 @@ TEST_F(ReliableInputStreamTest, FillAcknack)
     }
 }
 
+TEST_F(ReliableInputStreamTest, WrapAround)
+{
+    uint8_t buf[128] = {0};
+    InputMessagePtr input_message;
+
+    /* Several laps of the sequence space, pushing the window in reverse order. */
+    SeqNum seq_num = 0x0000;
+    for (int lap = 0; lap < 3 * (UINT16_MAX + 1) / RELIABLE_STREAM_DEPTH; ++lap)
+    {
+        for (int i = RELIABLE_STREAM_DEPTH - 1; i >= 0; --i)
+        {
+            buf[0] = uint8_t(seq_num + i);
+            ASSERT_TRUE(reliable_stream_.emplace_message(seq_num + i, buf, sizeof(buf)));
+        }
+        for (int i = 0; i < RELIABLE_STREAM_DEPTH; ++i)
+        {
+            ASSERT_TRUE(reliable_stream_.pop_message(input_message));
+            ASSERT_EQ(uint8_t(seq_num), input_message->get_buf()[0]);
+            seq_num += 1;
+        }
+        ASSERT_FALSE(reliable_stream_.pop_message(input_message));
+    }
+}
+
+TEST_F(ReliableInputStreamTest, UpdateFromHeartbeatDropsSkippedMessages)
+{
+    uint8_t buf[128] = {0};
+    InputMessagePtr input_message;
+
+    ASSERT_TRUE(reliable_stream_.emplace_message(0x0001, buf, sizeof(buf)));
+    ASSERT_TRUE(reliable_stream_.emplace_message(0x0003, buf, sizeof(buf)));
+    reliable_stream_.update_from_heartbeat(0x0003, 0x0003);
+    ASSERT_TRUE(reliable_stream_.pop_message(input_message));
+    ASSERT_FALSE(reliable_stream_.pop_message(input_message));
+
+    /* The slot of the skipped message is free for its sequence number in the next lap. */
+    SeqNum next_lap = SeqNum(0x0001) + SeqNum(RELIABLE_STREAM_DEPTH);
+    ASSERT_TRUE(reliable_stream_.emplace_message(next_lap, buf, sizeof(buf)));
+    ASSERT_FALSE(reliable_stream_.pop_message(input_message));
+}
+
+TEST_F(ReliableInputStreamTest, CustomDepth)
+{
+    const uint16_t depth = 100;
+    ReliableInputStream stream(depth);
+    uint8_t buf[128] = {0};
+
+    ASSERT_TRUE(stream.emplace_message(depth - 1, buf, sizeof(buf)));
+    ASSERT_FALSE(stream.emplace_message(depth, buf, sizeof(buf)));
+
+    /* The acknack only covers the first 16 messages of the window. */
+    stream.update_from_heartbeat(0x0000, depth - 1);
+    dds::xrce::ACKNACK_Payload acknack;
+    stream.fill_acknack(acknack);
+    ASSERT_EQ(acknack.nack_bitmap().at(0), 0xFF);
+    ASSERT_EQ(acknack.nack_bitmap().at(1), 0xFF);
+
+    for (uint16_t i = 0; i < depth - 1; ++i)
+    {
+        ASSERT_TRUE(stream.emplace_message(i, buf, sizeof(buf)));
+    }
+    InputMessagePtr input_message;
+    for (uint16_t i = 0; i < depth; ++i)
+    {
+        ASSERT_TRUE(stream.pop_message(input_message));
+    }
+    ASSERT_FALSE(stream.pop_message(input_message));
+}
+
+TEST_F(ReliableInputStreamTest, Fragments)
+{
+    const size_t fragment_size = 1000;
+    const size_t fragment_count = 5;
+    std::vector<uint8_t> buf(8 + 4 + fragment_size);
+    std::array<uint8_t, 8> raw_header = {0x01, 0x80, 0x00, 0x00, 0xAA, 0xBB, 0xCC, 0xDD};
+    std::copy(raw_header.begin(), raw_header.end(), buf.begin());
+    buf[8] = uint8_t(dds::xrce::FRAGMENT);
+    buf[10] = uint8_t(fragment_size & 0x00FF);
+    buf[11] = uint8_t((fragment_size & 0xFF00) >> 8);
+
+    InputMessagePtr input_message;
+    for (size_t i = 0; i < fragment_count; ++i)
+    {
+        buf[9] = uint8_t(dds::xrce::FLAG_LITTLE_ENDIANNESS | ((fragment_count - 1 == i) ? dds::xrce::FLAG_LAST_FRAGMENT : 0));
+        std::fill(buf.begin() + 12, buf.end(), uint8_t(i));
+        input_message.reset(new InputMessage(buf.data(), buf.size()));
+        ASSERT_TRUE(input_message->prepare_next_submessage());
+        ASSERT_FALSE(reliable_stream_.pop_fragment_message(input_message));
+        reliable_stream_.push_fragment(input_message);
+    }
+
+    ASSERT_TRUE(reliable_stream_.pop_fragment_message(input_message));
+    ASSERT_EQ(input_message->get_len(), raw_header.size() + (fragment_count * fragment_size));
+    ASSERT_TRUE(std::equal(raw_header.begin(), raw_header.end(), input_message->get_buf()));
+    for (size_t i = 0; i < fragment_count; ++i)
+    {
+        const uint8_t* fragment = input_message->get_buf() + raw_header.size() + (i * fragment_size);
+        ASSERT_TRUE(std::all_of(fragment, fragment + fragment_size, [&](uint8_t octet){ return i == octet; }));
+    }
+    ASSERT_FALSE(reliable_stream_.pop_fragment_message(input_message));
+}
+
 } // namespace testing
 } // namespace uxr
 } // namespace eprosima
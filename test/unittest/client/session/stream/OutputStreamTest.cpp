@@ -14,6 +14,8 @@
 
 
 #include <uxr/agent/client/session/stream/OutputStream.hpp>
+#include <algorithm>
+#include <array>
 #include <map>
 #include <queue>
 #include <mutex>
@@ -144,6 +146,76 @@ TEST_F(BestEffortOutputStreamTest, MaximumMessageSize)
     ASSERT_FALSE(best_effort_stream_.push_submessage(session_info_, stream_id_, dds::xrce::WRITE_DATA, write_data));
 }
 
+/**
+ * @brief   This test checks the flags of the submessages.
+ *          A DATA submessage shall carry the data format given in its flags.
+ */
+TEST_F(BestEffortOutputStreamTest, SubmessageFlags)
+{
+    dds::xrce::DATA_Payload_DataSeq data_seq{};
+    data_seq.data_seq().resize(3);
+    const size_t header_size = dds::xrce::MessageHeader{}.getCdrSerializedSize();
+    OutputMessagePtr output_message;
+
+    ASSERT_TRUE(best_effort_stream_.push_submessage(
+        session_info_, stream_id_, dds::xrce::DATA, data_seq,
+        uint8_t(dds::xrce::FLAG_LITTLE_ENDIANNESS | dds::xrce::FORMAT_DATA_SEQ)));
+    ASSERT_TRUE(best_effort_stream_.pop_message(output_message));
+    ASSERT_EQ(uint8_t(dds::xrce::DATA), output_message->get_buf()[header_size]);
+    ASSERT_EQ(uint8_t(dds::xrce::FLAG_LITTLE_ENDIANNESS | dds::xrce::FORMAT_DATA_SEQ),
+              output_message->get_buf()[header_size + 1]);
+}
+
+/**
+ * @brief   This test checks the aggregation of DATA submessages.
+ *          Consecutive DATA submessages shall share a message until it is full, flushed or
+ *          followed by another kind of submessage.
+ */
+TEST_F(BestEffortOutputStreamTest, Aggregation)
+{
+    BestEffortOutputStream stream(BEST_EFFORT_STREAM_DEPTH, std::chrono::microseconds(500));
+    dds::xrce::DATA_Payload_Data data{};
+    data.data().serialized_data().resize(100);
+    const size_t submessage_size = 4 + data.getCdrSerializedSize();
+    const size_t header_size = dds::xrce::MessageHeader{}.getCdrSerializedSize();
+    const size_t per_message = (mtu - header_size) / submessage_size;
+    OutputMessagePtr output_message;
+    std::chrono::steady_clock::time_point deadline;
+
+    /* Fill a message. */
+    for (size_t i = 0; i < per_message; ++i)
+    {
+        ASSERT_TRUE(stream.push_submessage(session_info_, stream_id_, dds::xrce::DATA, data));
+        ASSERT_FALSE(stream.pop_message(output_message));
+    }
+    ASSERT_TRUE(stream.take_flush_request(deadline));
+    ASSERT_FALSE(stream.take_flush_request(deadline));
+
+    /* The next DATA does not fit, so the full message is released. */
+    ASSERT_TRUE(stream.push_submessage(session_info_, stream_id_, dds::xrce::DATA, data));
+    ASSERT_TRUE(stream.pop_message(output_message));
+    ASSERT_EQ(header_size + (per_message * submessage_size), output_message->get_len());
+    ASSERT_FALSE(stream.pop_message(output_message));
+
+    /* The open message is released by the flush deadline. */
+    ASSERT_TRUE(stream.take_flush_request(deadline));
+    ASSERT_FALSE(stream.flush(deadline - std::chrono::microseconds(1)));
+    ASSERT_FALSE(stream.pop_message(output_message));
+    ASSERT_TRUE(stream.flush(deadline));
+    ASSERT_TRUE(stream.pop_message(output_message));
+    ASSERT_EQ(header_size + submessage_size, output_message->get_len());
+
+    /* Other submessages close the open message and are not aggregated. */
+    dds::xrce::WRITE_DATA_Payload_Data write_data{};
+    ASSERT_TRUE(stream.push_submessage(session_info_, stream_id_, dds::xrce::DATA, data));
+    ASSERT_TRUE(stream.push_submessage(session_info_, stream_id_, dds::xrce::WRITE_DATA, write_data));
+    ASSERT_TRUE(stream.pop_message(output_message));
+    ASSERT_EQ(dds::xrce::SequenceNr(2), output_message->get_buf()[2]);
+    ASSERT_TRUE(stream.pop_message(output_message));
+    ASSERT_EQ(dds::xrce::SequenceNr(3), output_message->get_buf()[2]);
+    ASSERT_FALSE(stream.pop_message(output_message));
+}
+
 /****************************************************************************************
  * Reliable Output Stream.
  ****************************************************************************************/
@@ -300,6 +372,300 @@ TEST_F(ReliableOutputStreamTest, Fragmentation)
     }
 }
 
+/**
+ * @brief   This test checks that a submessage with more fragments than RELIABLE_STREAM_DEPTH is kept whole,
+ *          even when its fragments wrap around the sequence number space.
+ */
+TEST_F(ReliableOutputStreamTest, FragmentationBeyondDepth)
+{
+    dds::xrce::WRITE_DATA_Payload_Data write_data{};
+    OutputMessagePtr output_message;
+
+    /* Move the stream close to the wrap-around. */
+    SeqNum first_unacked = 0x0000;
+    for (int i = 0; i < (UINT16_MAX - RELIABLE_STREAM_DEPTH); ++i)
+    {
+        ASSERT_TRUE(reliable_stream_.push_submessage(
+            session_info_,
+            stream_id_,
+            dds::xrce::WRITE_DATA,
+            write_data,
+            std::chrono::milliseconds(500)));
+        ASSERT_TRUE(reliable_stream_.get_next_message(output_message));
+        first_unacked += 1;
+        reliable_stream_.update_from_acknack(first_unacked);
+    }
+
+    const int n_fragments = 4 * RELIABLE_STREAM_DEPTH;
+    write_data.data().serialized_data().resize(size_t(n_fragments - 1) * mtu);
+    ASSERT_TRUE(reliable_stream_.push_submessage(
+        session_info_,
+        stream_id_,
+        dds::xrce::WRITE_DATA,
+        write_data,
+        std::chrono::milliseconds(500)));
+
+    dds::xrce::HEARTBEAT_Payload hearbeat;
+    ASSERT_TRUE(reliable_stream_.fill_heartbeat(hearbeat));
+    ASSERT_EQ(hearbeat.first_unacked_seq_nr(), first_unacked);
+    const SeqNum last_unacked = hearbeat.last_unacked_seq_nr();
+    ASSERT_LE(n_fragments, int(uint16_t(last_unacked - first_unacked)) + 1);
+
+    for (SeqNum seq_num = first_unacked; seq_num <= last_unacked; seq_num += 1)
+    {
+        ASSERT_TRUE(reliable_stream_.get_next_message(output_message));
+        const uint8_t* raw_header = output_message->get_buf();
+        ASSERT_EQ(uint16_t(seq_num), uint16_t(raw_header[2] | (raw_header[3] << 8)));
+
+        OutputMessagePtr resent_message;
+        ASSERT_TRUE(reliable_stream_.get_message(seq_num, resent_message));
+        ASSERT_EQ(output_message.get(), resent_message.get());
+    }
+    ASSERT_FALSE(reliable_stream_.get_next_message(output_message));
+
+    reliable_stream_.update_from_acknack(last_unacked + 1);
+    ASSERT_FALSE(reliable_stream_.fill_heartbeat(hearbeat));
+    ASSERT_FALSE(reliable_stream_.get_message(last_unacked, output_message));
+}
+
+/**
+ * @brief   This test checks that a DATA payload referring to a sample is serialized into the same messages and
+ *          fragments as the DATA payload holding a copy of it.
+ */
+TEST_F(ReliableOutputStreamTest, DataPayloadView)
+{
+    const std::array<size_t, 3> sample_sizes{{17, 3 * mtu + 17, 2 * mtu}};
+    for (size_t sample_size : sample_sizes)
+    {
+        dds::xrce::DATA_Payload_Data data_payload{};
+        data_payload.request_id({0x01, 0x02});
+        data_payload.object_id({0x03, 0x06});
+        std::vector<uint8_t>& sample = data_payload.data().serialized_data();
+        sample.resize(sample_size);
+        for (size_t i = 0; i < sample.size(); ++i)
+        {
+            sample[i] = uint8_t(i * 7);
+        }
+        DataPayloadView data_view(data_payload.request_id(), data_payload.object_id(), sample.data(), sample.size());
+        ASSERT_EQ(data_payload.getCdrSerializedSize(), data_view.getCdrSerializedSize());
+
+        ReliableOutputStream payload_stream;
+        ReliableOutputStream view_stream;
+        ASSERT_TRUE(payload_stream.push_submessage(
+            session_info_, stream_id_, dds::xrce::DATA, data_payload, std::chrono::milliseconds(0)));
+        ASSERT_TRUE(view_stream.push_submessage(
+            session_info_, stream_id_, dds::xrce::DATA, data_view, std::chrono::milliseconds(0)));
+
+        OutputMessagePtr payload_message;
+        OutputMessagePtr view_message;
+        while (payload_stream.get_next_message(payload_message))
+        {
+            ASSERT_TRUE(view_stream.get_next_message(view_message));
+            ASSERT_EQ(payload_message->get_len(), view_message->get_len());
+            ASSERT_TRUE(std::equal(
+                payload_message->get_buf(),
+                payload_message->get_buf() + payload_message->get_len(),
+                view_message->get_buf()));
+        }
+        ASSERT_FALSE(view_stream.get_next_message(view_message));
+    }
+}
+
+/**
+ * @brief   This test checks that the window of an adaptive reliable stream doubles when a whole window is
+ *          acknowledged without NACKs, halves once per loss, and stays between its depth and its maximum depth.
+ */
+TEST_F(ReliableOutputStreamTest, AdaptiveWindow)
+{
+    const uint16_t depth = 4;
+    const uint16_t max_depth = 16;
+    ReliableOutputStream stream(depth, max_depth);
+    dds::xrce::WRITE_DATA_Payload_Data write_data{};
+    OutputMessagePtr output_message;
+
+    /* Pushes and sends as many messages as the window admits. */
+    SeqNum next_seq = 0x0000;
+    auto fill_window = [&]() -> uint16_t
+    {
+        uint16_t pushed = 0;
+        while (stream.push_submessage(
+            session_info_,
+            stream_id_,
+            dds::xrce::WRITE_DATA,
+            write_data,
+            std::chrono::milliseconds(0)))
+        {
+            ++pushed;
+        }
+        while (stream.get_next_message(output_message))
+        {}
+        next_seq += pushed;
+        return pushed;
+    };
+
+    ASSERT_EQ(depth, stream.get_window());
+    ASSERT_EQ(depth, fill_window());
+
+    for (uint16_t window = depth; window < max_depth; window = uint16_t(2 * window))
+    {
+        stream.update_from_acknack(next_seq);
+        ASSERT_EQ(uint16_t(2 * window), stream.get_window());
+        ASSERT_EQ(uint16_t(2 * window), fill_window());
+    }
+
+    /* Bounded by the maximum depth. */
+    stream.update_from_acknack(next_seq);
+    ASSERT_EQ(max_depth, stream.get_window());
+    ASSERT_EQ(max_depth, fill_window());
+
+    /* Halved once for the messages in flight when the loss is reported. */
+    const SeqNum lost = next_seq - max_depth;
+    stream.update_from_acknack(lost, true);
+    ASSERT_EQ(max_depth / 2, stream.get_window());
+    stream.update_from_acknack(lost + 1, true);
+    ASSERT_EQ(max_depth / 2, stream.get_window());
+    ASSERT_EQ(0, fill_window());
+
+    /* Halved again by a loss reported once those are acknowledged, but not below the depth. */
+    stream.update_from_acknack(next_seq, true);
+    ASSERT_EQ(max_depth / 4, stream.get_window());
+    ASSERT_EQ(depth, fill_window());
+    stream.update_from_acknack(next_seq, true);
+    ASSERT_EQ(depth, stream.get_window());
+
+    stream.reset();
+    ASSERT_EQ(depth, stream.get_window());
+}
+
+/**
+ * @brief   This test checks the metrics of the stream.
+ *          Pushes into a full window count as stalls and messages got on ACKNACKs as retransmissions.
+ */
+TEST_F(ReliableOutputStreamTest, Metrics)
+{
+    const uint16_t depth = 4;
+    ReliableOutputStream stream(depth);
+    dds::xrce::WRITE_DATA_Payload_Data write_data{};
+    OutputMessagePtr output_message;
+
+    uint16_t pushed = 0;
+    while (stream.push_submessage(
+        session_info_,
+        stream_id_,
+        dds::xrce::WRITE_DATA,
+        write_data,
+        std::chrono::milliseconds(0)))
+    {
+        ++pushed;
+    }
+    while (stream.get_next_message(output_message))
+    {}
+
+    StreamMetrics metrics;
+    stream.get_metrics(metrics);
+    ASSERT_EQ(1u, metrics.window_stalls);
+    ASSERT_EQ(0u, metrics.retransmissions);
+    ASSERT_EQ(depth, metrics.window);
+    ASSERT_EQ(pushed, metrics.unacked);
+
+    ASSERT_TRUE(stream.get_message(0x0000, output_message));
+    ASSERT_TRUE(stream.get_message(0x0001, output_message));
+    ASSERT_FALSE(stream.get_message(pushed, output_message));
+    stream.update_from_acknack(pushed);
+
+    stream.get_metrics(metrics);
+    ASSERT_EQ(1u, metrics.window_stalls);
+    ASSERT_EQ(2u, metrics.retransmissions);
+    ASSERT_EQ(0u, metrics.unacked);
+}
+
+/**
+ * @brief   This test checks that a non-adaptive reliable stream keeps its depth.
+ */
+TEST_F(ReliableOutputStreamTest, FixedWindow)
+{
+    const uint16_t depth = 64;
+    ReliableOutputStream stream(depth);
+    dds::xrce::WRITE_DATA_Payload_Data write_data{};
+    OutputMessagePtr output_message;
+
+    for (int i = 0; i < depth; ++i)
+    {
+        ASSERT_TRUE(stream.push_submessage(
+            session_info_,
+            stream_id_,
+            dds::xrce::WRITE_DATA,
+            write_data,
+            std::chrono::milliseconds(0)));
+        ASSERT_TRUE(stream.get_next_message(output_message));
+    }
+    ASSERT_FALSE(stream.push_submessage(
+        session_info_,
+        stream_id_,
+        dds::xrce::WRITE_DATA,
+        write_data,
+        std::chrono::milliseconds(0)));
+
+    stream.update_from_acknack(depth);
+    ASSERT_EQ(depth, stream.get_window());
+}
+
+/**
+ * @brief   This test checks the aggregation of DATA submessages in a reliable stream.
+ *          The open message shall take its place in the window, but shall neither be sent
+ *          nor announced until it is closed.
+ */
+TEST_F(ReliableOutputStreamTest, Aggregation)
+{
+    const uint16_t depth = 4;
+    ReliableOutputStream stream(depth, depth, std::chrono::microseconds(500));
+    dds::xrce::DATA_Payload_Data data{};
+    data.data().serialized_data().resize(100);
+    const size_t submessage_size = 4 + data.getCdrSerializedSize();
+    const size_t header_size = dds::xrce::MessageHeader{}.getCdrSerializedSize();
+    const size_t per_message = (mtu - header_size) / submessage_size;
+    OutputMessagePtr output_message;
+    dds::xrce::HEARTBEAT_Payload heartbeat;
+    std::chrono::steady_clock::time_point deadline;
+
+    for (size_t i = 0; i < per_message; ++i)
+    {
+        ASSERT_TRUE(stream.push_submessage(session_info_, stream_id_, dds::xrce::DATA, data, std::chrono::milliseconds(0)));
+        ASSERT_FALSE(stream.get_next_message(output_message));
+        ASSERT_FALSE(stream.fill_heartbeat(heartbeat));
+    }
+    ASSERT_TRUE(stream.take_flush_request(deadline));
+    ASSERT_TRUE(stream.flush(deadline));
+    ASSERT_TRUE(stream.get_next_message(output_message));
+    ASSERT_EQ(header_size + (per_message * submessage_size), output_message->get_len());
+    ASSERT_TRUE(stream.fill_heartbeat(heartbeat));
+    ASSERT_EQ(0, heartbeat.last_unacked_seq_nr());
+
+    /* Messages 1 and 2 are closed, message 3 stays open and fills the window. */
+    for (size_t i = 0; i < (3 * per_message); ++i)
+    {
+        ASSERT_TRUE(stream.push_submessage(session_info_, stream_id_, dds::xrce::DATA, data, std::chrono::milliseconds(0)));
+    }
+    ASSERT_TRUE(stream.get_next_message(output_message));
+    ASSERT_TRUE(stream.get_next_message(output_message));
+    ASSERT_FALSE(stream.get_next_message(output_message));
+    ASSERT_TRUE(stream.fill_heartbeat(heartbeat));
+    ASSERT_EQ(2, heartbeat.last_unacked_seq_nr());
+    ASSERT_FALSE(stream.push_submessage(session_info_, stream_id_, dds::xrce::DATA, data, std::chrono::milliseconds(0)));
+
+    /* Acknowledging frees the window, the open message is closed as message 3. */
+    stream.update_from_acknack(1);
+    ASSERT_TRUE(stream.push_submessage(session_info_, stream_id_, dds::xrce::DATA, data, std::chrono::milliseconds(0)));
+    ASSERT_TRUE(stream.get_next_message(output_message));
+    ASSERT_EQ(dds::xrce::SequenceNr(3), output_message->get_buf()[2]);
+    ASSERT_EQ(header_size + (per_message * submessage_size), output_message->get_len());
+    ASSERT_FALSE(stream.get_next_message(output_message));
+
+    stream.reset();
+    ASSERT_FALSE(stream.flush(std::chrono::steady_clock::time_point::max()));
+    ASSERT_FALSE(stream.take_flush_request(deadline));
+}
+
 /**
  * @brief   This test checks the initial conditions of the reliable stream.
  */
@@ -0,0 +1,222 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/logger/Logger.hpp>
+#include <uxr/agent/logger/AsyncLogger.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace eprosima {
+namespace uxr {
+namespace testing {
+
+class AsyncLoggerTest : public ::testing::Test
+{
+protected:
+    struct Message
+    {
+        uint32_t client_key;
+        int32_t fd;
+        uint32_t length;
+        std::string event;
+        std::vector<uint8_t> payload;
+    };
+
+    AsyncLoggerTest()
+        : file_path_("async_logger_test.bin")
+    {}
+
+    ~AsyncLoggerTest() override
+    {
+        AsyncLogger::stop();
+        std::remove(file_path_.c_str());
+    }
+
+    template<typename T>
+    static T read(
+            const std::vector<char>& buf,
+            size_t& pos)
+    {
+        T value;
+        std::memcpy(&value, buf.data() + pos, sizeof(T));
+        pos += sizeof(T);
+        return value;
+    }
+
+    std::vector<Message> read_messages()
+    {
+        std::ifstream file(file_path_, std::ios::binary);
+        std::vector<char> buf{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+        std::vector<Message> messages;
+        std::map<uint16_t, std::string> events;
+
+        EXPECT_LE(8u, buf.size());
+        EXPECT_EQ(std::string("UXRLOG1\n"), std::string(buf.data(), 8));
+        size_t pos = 8;
+        while (pos < buf.size())
+        {
+            uint8_t type = read<uint8_t>(buf, pos);
+            if (0x01 == type)
+            {
+                uint16_t id = read<uint16_t>(buf, pos);
+                uint16_t length = read<uint16_t>(buf, pos);
+                events[id] = std::string(buf.data() + pos, length);
+                pos += length;
+            }
+            else
+            {
+                EXPECT_EQ(0x02, type);
+                Message message;
+                read<int64_t>(buf, pos);
+                message.client_key = read<uint32_t>(buf, pos);
+                message.fd = read<int32_t>(buf, pos);
+                message.length = read<uint32_t>(buf, pos);
+                uint16_t event = read<uint16_t>(buf, pos);
+                EXPECT_EQ(1u, events.count(event));
+                message.event = events[event];
+                uint16_t payload_length = read<uint16_t>(buf, pos);
+                message.payload.assign(buf.data() + pos, buf.data() + pos + payload_length);
+                pos += payload_length;
+                messages.push_back(std::move(message));
+            }
+        }
+        return messages;
+    }
+
+    const std::string file_path_;
+};
+
+TEST_F(AsyncLoggerTest, binary_file)
+{
+    ASSERT_TRUE(AsyncLogger::start(file_path_));
+    ASSERT_FALSE(AsyncLogger::start(file_path_));
+    ASSERT_TRUE(AsyncLogger::enabled());
+
+    std::vector<uint8_t> small(16, 0xAB);
+    std::vector<uint8_t> large(ASYNC_LOG_PAYLOAD_SIZE + 16, 0xCD);
+    UXR_AGENT_LOG_MESSAGE("recv", 0xAABBCCDD, small.data(), small.size());
+    UXR_MULTIAGENT_LOG_MESSAGE("send", 0x11223344, 3, large.data(), large.size());
+    AsyncLogger::stop();
+    ASSERT_FALSE(AsyncLogger::enabled());
+
+    std::vector<Message> messages = read_messages();
+    ASSERT_EQ(2u, messages.size());
+    ASSERT_EQ("recv", messages[0].event);
+    ASSERT_EQ(0xAABBCCDD, messages[0].client_key);
+    ASSERT_EQ(-1, messages[0].fd);
+    ASSERT_EQ(small.size(), messages[0].length);
+    ASSERT_EQ(small, messages[0].payload);
+
+    ASSERT_EQ("send", messages[1].event);
+    ASSERT_EQ(3, messages[1].fd);
+    ASSERT_EQ(large.size(), messages[1].length);
+    ASSERT_EQ(std::vector<uint8_t>(large.begin(), large.begin() + ASYNC_LOG_PAYLOAD_SIZE), messages[1].payload);
+}
+
+TEST_F(AsyncLoggerTest, threads)
+{
+    ASSERT_TRUE(AsyncLogger::start(file_path_));
+
+    const uint32_t messages_per_thread = 1000;
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        threads.emplace_back([i, messages_per_thread]()
+        {
+            uint8_t byte = uint8_t(i);
+            for (uint32_t j = 0; j < messages_per_thread; ++j)
+            {
+                UXR_AGENT_LOG_MESSAGE("thread", i, &byte, 1);
+                /* Leave room to the background thread, so that no record is dropped. */
+                if (0 == j % 64)
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    AsyncLogger::stop();
+
+    std::vector<uint32_t> counts(threads.size(), 0);
+    for (const auto& message : read_messages())
+    {
+        ASSERT_LT(message.client_key, counts.size());
+        ASSERT_EQ(std::vector<uint8_t>(1, uint8_t(message.client_key)), message.payload);
+        ++counts[message.client_key];
+    }
+    for (uint32_t count : counts)
+    {
+        ASSERT_EQ(messages_per_thread, count);
+    }
+}
+
+TEST_F(AsyncLoggerTest, register_while_draining)
+{
+    ASSERT_TRUE(AsyncLogger::start(file_path_));
+
+    /*
+     * Every message has an event registered right before it, while the background thread drains.
+     * Each thread pushes fewer messages than its ring holds, so that none is dropped.
+     */
+    const uint32_t messages_per_thread = ASYNC_LOG_RING_SIZE / 2;
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        threads.emplace_back([i, messages_per_thread]()
+        {
+            uint8_t byte = uint8_t(i);
+            for (uint32_t j = 0; j < messages_per_thread; ++j)
+            {
+                uint32_t client_key = (i * messages_per_thread) + j;
+                uint16_t event = AsyncLogger::register_event("event_" + std::to_string(client_key));
+                AsyncLogger::push_message(event, client_key, -1, &byte, 1);
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    AsyncLogger::stop();
+
+    std::vector<Message> messages = read_messages();
+    ASSERT_EQ(threads.size() * messages_per_thread, messages.size());
+    for (const auto& message : messages)
+    {
+        ASSERT_EQ("event_" + std::to_string(message.client_key), message.event);
+    }
+}
+
+} // namespace testing
+} // namespace uxr
+} // namespace eprosima
+
+int main(int args, char** argv)
+{
+    ::testing::InitGoogleTest(&args, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,194 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/message/MessageBuffer.hpp>
+#include <uxr/agent/message/InputMessage.hpp>
+#include <uxr/agent/message/OutputMessage.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace eprosima {
+namespace uxr {
+namespace testing {
+
+class MessageBufferTest : public ::testing::Test
+{
+protected:
+    MessageBufferTest()
+        : pool_(64, 64, 2)
+    {}
+
+    MessageBufferPool pool_;
+};
+
+TEST_F(MessageBufferTest, reuse_blocks)
+{
+    uint8_t* data = nullptr;
+    {
+        MessageBuffer buffer = pool_.acquire(16);
+        ASSERT_EQ(buffer.capacity(), pool_.max_block_size());
+        data = buffer.data();
+    }
+
+    MessageBuffer buffer = pool_.acquire();
+    ASSERT_EQ(buffer.data(), data);
+}
+
+TEST_F(MessageBufferTest, large_buffers)
+{
+    MessageBuffer buffer = pool_.acquire(pool_.max_block_size() + 1);
+    ASSERT_EQ(buffer.capacity(), pool_.max_block_size() + 1);
+    buffer.reset();
+    ASSERT_EQ(buffer.data(), nullptr);
+    ASSERT_EQ(buffer.capacity(), 0u);
+}
+
+TEST_F(MessageBufferTest, move_ownership)
+{
+    MessageBuffer buffer = pool_.acquire();
+    uint8_t* data = buffer.data();
+
+    MessageBuffer other(std::move(buffer));
+    ASSERT_EQ(buffer.data(), nullptr);
+    ASSERT_EQ(other.data(), data);
+
+    buffer = std::move(other);
+    ASSERT_EQ(other.data(), nullptr);
+    ASSERT_EQ(buffer.data(), data);
+}
+
+TEST_F(MessageBufferTest, max_cached_blocks)
+{
+    std::vector<MessageBuffer> buffers;
+    for (size_t i = 0; i < 4; ++i)
+    {
+        buffers.push_back(pool_.acquire());
+    }
+    std::vector<uint8_t*> released{buffers[0].data(), buffers[1].data()};
+    buffers.clear();
+
+    MessageBuffer first = pool_.acquire();
+    MessageBuffer second = pool_.acquire();
+    ASSERT_NE(std::find(released.begin(), released.end(), first.data()), released.end());
+    ASSERT_NE(std::find(released.begin(), released.end(), second.data()), released.end());
+}
+
+TEST_F(MessageBufferTest, size_classes)
+{
+    MessageBufferPool pool(64, 1000, 8);
+    ASSERT_EQ(pool.acquire(1).capacity(), 64u);
+    ASSERT_EQ(pool.acquire(65).capacity(), 128u);
+    ASSERT_EQ(pool.acquire(512).capacity(), 512u);
+    ASSERT_EQ(pool.acquire(513).capacity(), 1000u);
+    ASSERT_EQ(pool.acquire(1001).capacity(), 1001u);
+    ASSERT_EQ(pool.max_block_size(), 1000u);
+}
+
+TEST_F(MessageBufferTest, zeroed_blocks)
+{
+    MessageBufferPool pool(64, 256, 8, true);
+    MessageBuffer buffer = pool.acquire(100);
+    ASSERT_TRUE(std::all_of(buffer.data(), buffer.data() + buffer.capacity(), [](uint8_t octet){ return 0 == octet; }));
+
+    MessageBuffer large = pool.acquire(1024);
+    ASSERT_TRUE(std::all_of(large.data(), large.data() + large.capacity(), [](uint8_t octet){ return 0 == octet; }));
+}
+
+TEST_F(MessageBufferTest, message_ownership)
+{
+    std::array<uint8_t, 16> raw = {0x81, 0x00, 0x00, 0x00, 0x00, 0x01, 0x08, 0x00};
+    MessageBuffer buffer = MessageBufferPool::input_pool().acquire();
+    std::copy(raw.begin(), raw.end(), buffer.data());
+    uint8_t* data = buffer.data();
+
+    InputMessage message(std::move(buffer), raw.size());
+    ASSERT_EQ(message.get_buf(), data);
+    ASSERT_EQ(message.get_len(), raw.size());
+    ASSERT_TRUE(message.is_valid_xrce_message());
+}
+
+TEST_F(MessageBufferTest, payload_view)
+{
+    std::array<uint8_t, 16> raw = {0x81, 0x00, 0x00, 0x00, 0x07, 0x01, 0x08, 0x00,
+                                   0x00, 0x01, 0x01, 0x05, 0x0C, 0x0D, 0x0E, 0x0F};
+    InputMessage message(raw.data(), raw.size());
+    ASSERT_TRUE(message.prepare_next_submessage());
+
+    dds::xrce::BaseObjectRequest base_request;
+    ASSERT_TRUE(message.get_payload(base_request));
+
+    const uint8_t* data = nullptr;
+    ASSERT_FALSE(message.get_payload_view(data, 5));
+    ASSERT_TRUE(message.get_payload_view(data, 4));
+    ASSERT_EQ(data, message.get_buf() + 12);
+    ASSERT_TRUE(std::equal(raw.begin() + 12, raw.end(), data));
+    ASSERT_FALSE(message.get_payload_view(data, 1));
+}
+
+TEST_F(MessageBufferTest, message_join)
+{
+    const size_t head_size = MessageBufferPool::input_pool().max_block_size();
+    std::vector<uint8_t> raw(head_size + 32);
+    for (size_t i = 0; i < raw.size(); ++i)
+    {
+        raw[i] = uint8_t(i);
+    }
+
+    MessageBuffer head = MessageBufferPool::input_pool().acquire();
+    std::copy(raw.begin(), raw.begin() + head_size, head.data());
+
+    InputMessage message(std::move(head), raw.data() + head_size, raw.size());
+    ASSERT_EQ(message.get_len(), raw.size());
+    ASSERT_TRUE(std::equal(raw.begin(), raw.end(), message.get_buf()));
+}
+
+TEST_F(MessageBufferTest, output_message_sharing)
+{
+    dds::xrce::MessageHeader header;
+    header.session_id(0x81);
+
+    OutputMessagePtr message(new OutputMessage(header, 64));
+    OutputMessagePtr copy(message);
+    ASSERT_EQ(copy.get(), message.get());
+
+    uint8_t* data = message->get_buf();
+    ASSERT_NE(0, data[0]);
+    message.reset();
+    ASSERT_FALSE(message);
+    ASSERT_TRUE(copy);
+    ASSERT_EQ(copy->get_buf(), data);
+
+    OutputMessagePtr moved(std::move(copy));
+    ASSERT_FALSE(copy);
+    moved = nullptr;
+
+    /* The released buffer is cleared, so it is handed out zeroed again. */
+    MessageBuffer buffer = MessageBufferPool::output_pool().acquire(64);
+    ASSERT_EQ(buffer.data(), data);
+    ASSERT_TRUE(std::all_of(buffer.data(), buffer.data() + buffer.capacity(), [](uint8_t octet){ return 0 == octet; }));
+}
+
+} // namespace testing
+} // namespace uxr
+} // namespace eprosima
+
+int main(int args, char** argv)
+{
+    ::testing::InitGoogleTest(&args, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,166 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/metrics/Metrics.hpp>
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <thread>
+
+namespace eprosima {
+namespace uxr {
+namespace testing {
+
+TEST(HistogramTest, bucket_bounds)
+{
+    size_t last_bucket = 0;
+    for (uint64_t value = 0; value < 100000; ++value)
+    {
+        size_t bucket = Histogram::get_bucket(value);
+        ASSERT_GE(bucket, last_bucket);
+        ASSERT_LT(bucket, Histogram::bucket_count);
+        uint64_t bucket_max = Histogram::get_bucket_max(bucket);
+        ASSERT_GE(bucket_max, value);
+        ASSERT_LE(bucket_max - value, value >> Histogram::precision_bits);
+        if (0 < bucket)
+        {
+            ASSERT_LT(Histogram::get_bucket_max(bucket - 1), value);
+        }
+        last_bucket = bucket;
+    }
+
+    /* Values too large share the last bucket. */
+    ASSERT_EQ(Histogram::bucket_count - 1, Histogram::get_bucket(UINT64_MAX));
+    ASSERT_EQ(Histogram::bucket_count - 1, Histogram::get_bucket(uint64_t(1) << Histogram::max_value_bits));
+    ASSERT_EQ((uint64_t(1) << Histogram::max_value_bits) - 1, Histogram::get_bucket_max(Histogram::bucket_count - 1));
+}
+
+TEST(HistogramTest, quantiles)
+{
+    Histogram histogram;
+    ASSERT_EQ(0u, histogram.value_at_quantile(0.5));
+
+    for (uint64_t value = 1; value <= 1000; ++value)
+    {
+        histogram.record(value);
+    }
+    ASSERT_EQ(1000u, histogram.count());
+    ASSERT_EQ(500500u, histogram.sum());
+    ASSERT_EQ(1000u, histogram.max());
+
+    ASSERT_EQ(1u, histogram.value_at_quantile(0.0));
+    ASSERT_GE(histogram.value_at_quantile(0.5), 500u);
+    ASSERT_LE(histogram.value_at_quantile(0.5), 500u + (500u >> Histogram::precision_bits));
+    ASSERT_GE(histogram.value_at_quantile(0.99), 990u);
+    ASSERT_LE(histogram.value_at_quantile(0.99), 1000u);
+    ASSERT_EQ(1000u, histogram.value_at_quantile(1.0));
+}
+
+TEST(HistogramTest, merge)
+{
+    Histogram first;
+    Histogram second;
+    for (uint64_t value = 0; value < 100; ++value)
+    {
+        first.record(value);
+        second.record(value + 100);
+    }
+
+    Histogram merged(first);
+    merged.merge(second);
+    ASSERT_EQ(200u, merged.count());
+    ASSERT_EQ(first.sum() + second.sum(), merged.sum());
+    ASSERT_EQ(199u, merged.max());
+    ASSERT_EQ(99u, merged.value_at_quantile(0.5));
+
+    merged = first;
+    ASSERT_EQ(100u, merged.count());
+    ASSERT_EQ(99u, merged.max());
+}
+
+TEST(HistogramTest, concurrent_merge)
+{
+    Histogram histogram;
+    Histogram total;
+    std::thread recorder([&]()
+    {
+        for (uint64_t value = 0; value < 100000; ++value)
+        {
+            histogram.record(value % 1000);
+        }
+    });
+    for (int i = 0; i < 100; ++i)
+    {
+        Histogram snapshot;
+        snapshot.merge(histogram);
+        ASSERT_LE(snapshot.count(), 100000u);
+    }
+    recorder.join();
+
+    total.merge(histogram);
+    ASSERT_EQ(100000u, total.count());
+    ASSERT_EQ(999u, total.max());
+}
+
+TEST(AgentMetricsTest, prometheus)
+{
+    AgentMetrics metrics;
+    metrics.transport.transport = "ipv4";
+    metrics.transport.packets_in = 10;
+    metrics.transport.bytes_in = 1000;
+    metrics.transport.output_drops = 3;
+    metrics.transport.input_queue_depth = 7;
+    metrics.clients = 1;
+    StreamMetrics stream;
+    stream.client_key = 0xAABBCCDD;
+    stream.stream_id = 0x80;
+    stream.retransmissions = 5;
+    stream.window_stalls = 2;
+    stream.window = 16;
+    stream.unacked = 4;
+    metrics.streams.push_back(stream);
+    metrics.processing_latency.record(2000);
+
+    std::stringstream ss;
+    metrics.write_prometheus(ss);
+    const std::string text = ss.str();
+
+    ASSERT_NE(std::string::npos, text.find("# TYPE uxr_agent_received_packets_total counter\n"));
+    ASSERT_NE(std::string::npos, text.find("uxr_agent_received_packets_total{transport=\"ipv4\"} 10\n"));
+    ASSERT_NE(std::string::npos, text.find("uxr_agent_received_bytes_total{transport=\"ipv4\"} 1000\n"));
+    ASSERT_NE(std::string::npos, text.find("uxr_agent_queue_drops_total{transport=\"ipv4\",queue=\"output\"} 3\n"));
+    ASSERT_NE(std::string::npos, text.find("uxr_agent_queue_depth{transport=\"ipv4\",queue=\"input\"} 7\n"));
+    ASSERT_NE(std::string::npos, text.find("uxr_agent_clients 1\n"));
+    ASSERT_NE(std::string::npos,
+        text.find("uxr_agent_stream_retransmissions_total{client=\"0xAABBCCDD\",stream=\"128\"} 5\n"));
+    ASSERT_NE(std::string::npos,
+        text.find("uxr_agent_stream_window_stalls_total{client=\"0xAABBCCDD\",stream=\"128\"} 2\n"));
+    ASSERT_NE(std::string::npos, text.find("uxr_agent_stream_window{client=\"0xAABBCCDD\",stream=\"128\"} 16\n"));
+    ASSERT_NE(std::string::npos,
+        text.find("uxr_agent_stream_unacked_messages{client=\"0xAABBCCDD\",stream=\"128\"} 4\n"));
+    ASSERT_NE(std::string::npos, text.find("# TYPE uxr_agent_processing_latency_seconds summary\n"));
+    ASSERT_NE(std::string::npos, text.find("uxr_agent_processing_latency_seconds_count{transport=\"ipv4\"} 1\n"));
+    ASSERT_NE(std::string::npos, text.find("uxr_agent_processing_latency_seconds_sum{transport=\"ipv4\"} 2e-06\n"));
+}
+
+} // namespace testing
+} // namespace uxr
+} // namespace eprosima
+
+int main(int args, char** argv)
+{
+    ::testing::InitGoogleTest(&args, argv);
+    return RUN_ALL_TESTS();
+}
@@ -16,6 +16,8 @@
 
 #include <gtest/gtest.h>
 
+#include <thread>
+
 namespace eprosima {
 namespace uxr {
 namespace testing {
@@ -897,6 +899,172 @@ TEST_F(CedMiddlewareUnitTests, WriteReadData)
     EXPECT_FALSE(middleware_.read_data(1, input_data, std::chrono::milliseconds(100)));
 }
 
+TEST_F(CedMiddlewareUnitTests, WriteRawData)
+{
+    std::string participant_ref{"Participant"};
+    middleware_.create_participant_by_ref(0, 0, participant_ref);
+
+    std::string topic_ref{"Topic"};
+    middleware_.create_topic_by_ref(0, 0, topic_ref);
+
+    std::string subscriber_xml{"Subscriber"};
+    middleware_.create_subscriber_by_xml(0, 0, subscriber_xml);
+
+    std::string publisher_xml{"Publisher"};
+    middleware_.create_publisher_by_xml(0, 0, publisher_xml);
+
+    std::string datareader_ref{"Topic"};
+    middleware_.create_datareader_by_ref(0, 0, datareader_ref);
+
+    std::string datawriter_ref{"Topic"};
+    middleware_.create_datawriter_by_ref(0, 0, datawriter_ref);
+
+    std::vector<uint8_t> buffer{0, 1, 2, 3, 4, 5, 6, 7};
+    std::vector<uint8_t> input_data{};
+
+    /* Write a slice of the buffer and an empty sample. */
+    EXPECT_TRUE(middleware_.write_raw_data(0, buffer.data() + 2, 4));
+    EXPECT_TRUE(middleware_.write_raw_data(0, buffer.data(), 0));
+    EXPECT_FALSE(middleware_.write_raw_data(1, buffer.data(), buffer.size()));
+
+    EXPECT_TRUE(middleware_.read_data(0, input_data, std::chrono::milliseconds(0)));
+    EXPECT_EQ(input_data, std::vector<uint8_t>(buffer.begin() + 2, buffer.begin() + 6));
+    EXPECT_TRUE(middleware_.read_data(0, input_data, std::chrono::milliseconds(0)));
+    EXPECT_TRUE(input_data.empty());
+    EXPECT_FALSE(middleware_.read_data(0, input_data, std::chrono::milliseconds(0)));
+}
+
+TEST_F(CedMiddlewareUnitTests, HistoryDepth)
+{
+    const uint16_t history_depth = 100;
+    CedTopicManager::set_history_depth("DeepTopic", history_depth);
+
+    middleware_.create_participant_by_ref(0, 0, "Participant");
+    middleware_.create_topic_by_ref(0, 0, "DeepTopic");
+    middleware_.create_subscriber_by_xml(0, 0, "Subscriber");
+    middleware_.create_publisher_by_xml(0, 0, "Publisher");
+    middleware_.create_datareader_by_ref(0, 0, "DeepTopic");
+    middleware_.create_datawriter_by_ref(0, 0, "DeepTopic");
+
+    /* The depth is rounded up to 128 samples, the reader keeps up with the last 128 writes. */
+    const int written = 200;
+    for (int i = 0; i < written; ++i)
+    {
+        EXPECT_TRUE(middleware_.write_data(0, std::vector<uint8_t>{uint8_t(i)}));
+    }
+
+    std::vector<uint8_t> input_data{};
+    for (int i = written - 128; i < written; ++i)
+    {
+        ASSERT_TRUE(middleware_.read_data(0, input_data, std::chrono::milliseconds(0)));
+        ASSERT_EQ(input_data, std::vector<uint8_t>{uint8_t(i)});
+    }
+    EXPECT_FALSE(middleware_.read_data(0, input_data, std::chrono::milliseconds(0)));
+
+    /* A blocked reader is woken up by the writer. */
+    std::thread writer([&](){
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        middleware_.write_data(0, std::vector<uint8_t>{0xAA});
+    });
+    EXPECT_TRUE(middleware_.read_data(0, input_data, std::chrono::seconds(5)));
+    EXPECT_EQ(input_data, std::vector<uint8_t>{0xAA});
+    writer.join();
+}
+
+TEST_F(CedMiddlewareUnitTests, ReadDataSeq)
+{
+    std::string participant_ref{"Participant"};
+    middleware_.create_participant_by_ref(0, 0, participant_ref);
+
+    std::string topic_ref{"Topic"};
+    middleware_.create_topic_by_ref(0, 0, topic_ref);
+
+    std::string subscriber_xml{"Subscriber"};
+    middleware_.create_subscriber_by_xml(0, 0, subscriber_xml);
+
+    std::string publisher_xml{"Publisher"};
+    middleware_.create_publisher_by_xml(0, 0, publisher_xml);
+
+    std::string datareader_ref{"Topic"};
+    middleware_.create_datareader_by_ref(0, 0, datareader_ref);
+
+    std::string datawriter_ref{"Topic"};
+    middleware_.create_datawriter_by_ref(0, 0, datawriter_ref);
+
+    const std::vector<uint8_t> output_data{0, 1, 2, 3, 4, 5, 6, 7};
+    const size_t sample_size = output_data.size() + 8;
+    dds::xrce::SampleDataSeq samples;
+
+    /* Write 5 Topic. */
+    for (size_t i = 0; i < 5; ++i)
+    {
+        EXPECT_TRUE(middleware_.write_data(0, output_data));
+    }
+
+    /* Read limited by the number of samples. */
+    EXPECT_TRUE(middleware_.read_data_seq(0, samples, 2, SIZE_MAX, std::chrono::milliseconds(0)));
+    EXPECT_EQ(2u, samples.size());
+
+    /* Read limited by the size of the samples. */
+    EXPECT_TRUE(middleware_.read_data_seq(0, samples, SIZE_MAX, 2 * sample_size, std::chrono::milliseconds(0)));
+    EXPECT_EQ(2u, samples.size());
+
+    /* The first sample is read even if it is larger than the maximum size. */
+    EXPECT_TRUE(middleware_.read_data_seq(0, samples, SIZE_MAX, 0, std::chrono::milliseconds(0)));
+    ASSERT_EQ(1u, samples.size());
+    EXPECT_EQ(output_data, samples.front().serialized_data());
+
+    /* Read unsuccessfully. */
+    EXPECT_FALSE(middleware_.read_data_seq(0, samples, SIZE_MAX, SIZE_MAX, std::chrono::milliseconds(0)));
+    EXPECT_TRUE(samples.empty());
+}
+
+TEST_F(CedMiddlewareUnitTests, DataReaderListener)
+{
+    std::string participant_ref{"Participant"};
+    middleware_.create_participant_by_ref(0, 0, participant_ref);
+
+    std::string topic_ref{"Topic"};
+    middleware_.create_topic_by_ref(0, 0, topic_ref);
+
+    std::string subscriber_xml{"Subscriber"};
+    middleware_.create_subscriber_by_xml(0, 0, subscriber_xml);
+
+    std::string publisher_xml{"Publisher"};
+    middleware_.create_publisher_by_xml(0, 0, publisher_xml);
+
+    std::string datareader_ref{"Topic"};
+    middleware_.create_datareader_by_ref(0, 0, datareader_ref);
+
+    std::string datawriter_ref{"Topic"};
+    middleware_.create_datawriter_by_ref(0, 0, datawriter_ref);
+
+    size_t notifications = 0;
+    std::vector<uint8_t> output_data{0, 1, 2};
+
+    /* Set listener
+     *      DataReader: non-existent
+     *      Expected:   FALSE
+     */
+    EXPECT_FALSE(middleware_.set_datareader_listener(1, [&](){ ++notifications; }));
+
+    /* Set listener
+     *      DataReader: existent
+     *      Expected:   TRUE
+     */
+    EXPECT_TRUE(middleware_.set_datareader_listener(0, [&](){ ++notifications; }));
+
+    /* Each write notifies the DataReader. */
+    EXPECT_TRUE(middleware_.write_data(0, output_data));
+    EXPECT_TRUE(middleware_.write_data(0, output_data));
+    EXPECT_EQ(2u, notifications);
+
+    /* Once deleted, the DataReader is no longer notified. */
+    EXPECT_TRUE(middleware_.delete_datareader(0));
+    EXPECT_TRUE(middleware_.write_data(0, output_data));
+    EXPECT_EQ(2u, notifications);
+}
+
 } // namespace testing
 } // namespace uxr
 } // namespace testing
@@ -0,0 +1,186 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/reader/Reader.hpp>
+
+#include <gtest/gtest.h>
+
+#include <condition_variable>
+#include <thread>
+
+namespace eprosima {
+namespace uxr {
+namespace testing {
+
+struct FakeClient;
+
+using FakeReader = Reader<FakeClient*, const std::shared_ptr<FakeClient>&>;
+
+/**
+ * @brief Owns a reader whose write arguments hold the client, as a ProxyClient and its DataReaders do.
+ */
+struct FakeClient
+{
+    FakeClient()
+        : reader(new FakeReader())
+        , writes(0)
+        , calls_after_release(0)
+        , in_flight(false)
+        , blocked(false)
+        , release_reader(false)
+        , reader_released(false)
+    {}
+
+    std::unique_ptr<FakeReader> reader;
+    std::atomic<int> writes;
+    std::atomic<int> calls_after_release;
+    std::mutex mtx;
+    std::condition_variable cv;
+    bool in_flight;
+    bool blocked;
+    bool release_reader;
+    std::atomic<bool> reader_released;
+};
+
+template<typename Predicate>
+bool wait_for(
+        Predicate predicate)
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!predicate() && (std::chrono::steady_clock::now() < deadline))
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return predicate();
+}
+
+dds::xrce::DataDeliveryControl unlimited_delivery()
+{
+    dds::xrce::DataDeliveryControl delivery_control;
+    delivery_control.max_samples(0xFFFF);
+    delivery_control.max_elapsed_time(0);
+    delivery_control.max_bytes_per_second(0);
+    return delivery_control;
+}
+
+/*
+ * Writes may block until the test unblocks them, and may destroy the reader running them.
+ */
+bool write_sample(
+        const std::shared_ptr<FakeClient>& client,
+        const std::vector<uint8_t>& /*data*/,
+        std::chrono::milliseconds /*timeout*/)
+{
+    if (client->reader_released)
+    {
+        ++client->calls_after_release;
+    }
+    std::unique_lock<std::mutex> lock(client->mtx);
+    client->in_flight = true;
+    client->cv.notify_all();
+    client->cv.wait(lock, [&](){ return !client->blocked; });
+    client->in_flight = false;
+    ++client->writes;
+    if (client->release_reader)
+    {
+        client->release_reader = false;
+        lock.unlock();
+        client->reader.reset();
+        client->reader_released = true;
+    }
+    return true;
+}
+
+bool read_sample(
+        FakeClient* client,
+        std::vector<uint8_t>& data,
+        std::chrono::milliseconds /*timeout*/)
+{
+    if (client->reader_released)
+    {
+        ++client->calls_after_release;
+    }
+    data.assign(4, 0xAA);
+    return true;
+}
+
+std::shared_ptr<FakeClient> start_client()
+{
+    std::shared_ptr<FakeClient> client = std::make_shared<FakeClient>();
+    client->reader->start_reading(unlimited_delivery(), read_sample, client.get(), write_sample, client);
+    return client;
+}
+
+TEST(ReaderTest, delete_during_delivery)
+{
+    std::shared_ptr<FakeClient> client = start_client();
+    {
+        std::unique_lock<std::mutex> lock(client->mtx);
+        client->blocked = true;
+        ASSERT_TRUE(client->cv.wait_for(lock, std::chrono::seconds(5), [&](){ return client->in_flight; }));
+    }
+
+    /* The reader waits for the delivery in flight, whose task then releases the last reference to the client. */
+    std::weak_ptr<FakeClient> weak_client = client;
+    std::thread deleter([&]()
+    {
+        client->reader.reset();
+        client.reset();
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    {
+        std::shared_ptr<FakeClient> locked = weak_client.lock();
+        ASSERT_TRUE(locked);
+        std::lock_guard<std::mutex> lock(locked->mtx);
+        locked->blocked = false;
+        locked->cv.notify_all();
+    }
+    deleter.join();
+    ASSERT_TRUE(wait_for([&](){ return weak_client.expired(); }));
+
+    /* The executor keeps delivering. */
+    std::shared_ptr<FakeClient> other = start_client();
+    ASSERT_TRUE(wait_for([&](){ return 0 < other->writes; }));
+    other->reader.reset();
+}
+
+TEST(ReaderTest, delete_from_own_delivery)
+{
+    std::shared_ptr<FakeClient> client = start_client();
+    std::weak_ptr<FakeClient> weak_client = client;
+    {
+        std::lock_guard<std::mutex> lock(client->mtx);
+        client->release_reader = true;
+    }
+    ASSERT_TRUE(wait_for([&](){ return client->reader_released.load(); }));
+
+    /* Neither the run in progress nor any other reads or writes once the reader is gone. */
+    const int writes = client->writes;
+    std::this_thread::sleep_for(std::chrono::milliseconds(40));
+    ASSERT_EQ(0, client->calls_after_release);
+    ASSERT_EQ(writes, client->writes);
+
+    client.reset();
+    ASSERT_TRUE(wait_for([&](){ return weak_client.expired(); }));
+}
+
+} // namespace testing
+} // namespace uxr
+} // namespace eprosima
+
+int main(int args, char** argv)
+{
+    ::testing::InitGoogleTest(&args, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,193 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/scheduler/PacketScheduler.hpp>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+namespace eprosima {
+namespace uxr {
+namespace testing {
+
+class PacketSchedulerTest : public ::testing::Test
+{
+protected:
+    PacketSchedulerTest()
+        : scheduler_(8)
+    {
+        scheduler_.init();
+        scheduler_.set_priority_size(1, 1);
+    }
+
+    ~PacketSchedulerTest() override
+    {
+        scheduler_.deinit();
+    }
+
+    void push(int value, uint8_t priority)
+    {
+        scheduler_.push(std::unique_ptr<int>(new int(value)), priority);
+    }
+
+    int pop()
+    {
+        std::unique_ptr<int> element;
+        EXPECT_TRUE(scheduler_.pop(element));
+        return element ? *element : -1;
+    }
+
+    PacketScheduler<std::unique_ptr<int>> scheduler_;
+};
+
+TEST_F(PacketSchedulerTest, fifo_order)
+{
+    for (int i = 0; i < 8; ++i)
+    {
+        push(i, 0);
+    }
+    for (int i = 0; i < 8; ++i)
+    {
+        ASSERT_EQ(pop(), i);
+    }
+}
+
+TEST_F(PacketSchedulerTest, priority_order)
+{
+    push(0, 0);
+    push(1, 0);
+    push(2, 1);
+    ASSERT_EQ(pop(), 2);
+    ASSERT_EQ(pop(), 0);
+    ASSERT_EQ(pop(), 1);
+}
+
+TEST_F(PacketSchedulerTest, drop_oldest)
+{
+    for (int i = 0; i < 12; ++i)
+    {
+        push(i, 0);
+    }
+    for (int i = 4; i < 12; ++i)
+    {
+        ASSERT_EQ(pop(), i);
+    }
+
+    /* Rings hold at least two elements. */
+    push(100, 1);
+    push(101, 1);
+    push(102, 1);
+    ASSERT_EQ(pop(), 101);
+    ASSERT_EQ(pop(), 102);
+}
+
+TEST_F(PacketSchedulerTest, size_and_drops)
+{
+    ASSERT_EQ(scheduler_.size(), 0u);
+    for (int i = 0; i < 10; ++i)
+    {
+        push(i, 0);
+    }
+    push(10, 1);
+    ASSERT_EQ(scheduler_.size(), 9u);
+    ASSERT_EQ(scheduler_.get_dropped(), 2u);
+
+    ASSERT_EQ(pop(), 10);
+    ASSERT_EQ(pop(), 2);
+    ASSERT_EQ(scheduler_.size(), 7u);
+    ASSERT_EQ(scheduler_.get_dropped(), 2u);
+}
+
+TEST_F(PacketSchedulerTest, push_front)
+{
+    push(0, 0);
+    push(1, 0);
+    ASSERT_EQ(pop(), 0);
+    scheduler_.push_front(std::unique_ptr<int>(new int(0)), 0);
+    ASSERT_EQ(pop(), 0);
+    ASSERT_EQ(pop(), 1);
+}
+
+TEST_F(PacketSchedulerTest, bulk_pop)
+{
+    for (int i = 0; i < 6; ++i)
+    {
+        push(i, 0);
+    }
+    push(6, 1);
+
+    std::vector<std::unique_ptr<int>> elements;
+    ASSERT_TRUE(scheduler_.pop(elements, 4));
+    ASSERT_EQ(elements.size(), 4u);
+    ASSERT_EQ(*elements[0], 6);
+    for (int i = 1; i < 4; ++i)
+    {
+        ASSERT_EQ(*elements[size_t(i)], i - 1);
+    }
+}
+
+TEST_F(PacketSchedulerTest, deinit_wakes_consumer)
+{
+    std::thread consumer([&]()
+    {
+        std::unique_ptr<int> element;
+        ASSERT_FALSE(scheduler_.pop(element));
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    scheduler_.deinit();
+    consumer.join();
+}
+
+TEST(PacketSchedulerConcurrencyTest, multiple_producers)
+{
+    const int producers = 4;
+    const int elements_per_producer = 20000;
+
+    PacketScheduler<std::unique_ptr<int>> scheduler(size_t(producers * elements_per_producer));
+    scheduler.init();
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p)
+    {
+        threads.emplace_back([&scheduler, p, elements_per_producer]()
+        {
+            for (int i = 0; i < elements_per_producer; ++i)
+            {
+                scheduler.push(std::unique_ptr<int>(new int((p * elements_per_producer) + i)), 0);
+            }
+        });
+    }
+
+    /* Elements from the same producer shall keep their order. */
+    std::vector<int> last(producers, -1);
+    std::unique_ptr<int> element;
+    for (int i = 0; i < producers * elements_per_producer; ++i)
+    {
+        ASSERT_TRUE(scheduler.pop(element));
+        int producer = *element / elements_per_producer;
+        ASSERT_LT(last[size_t(producer)], *element);
+        last[size_t(producer)] = *element;
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    scheduler.deinit();
+}
+
+} // namespace testing
+} // namespace uxr
+} // namespace eprosima
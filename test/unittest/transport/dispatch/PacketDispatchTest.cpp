@@ -0,0 +1,238 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/transport/PacketDispatch.hpp>
+#include <uxr/agent/scheduler/PacketScheduler.hpp>
+
+#include <gtest/gtest.h>
+
+#include <initializer_list>
+#include <memory>
+#include <set>
+#include <vector>
+
+namespace eprosima {
+namespace uxr {
+namespace testing {
+
+class PacketDispatchTest : public ::testing::Test
+{
+protected:
+    static constexpr size_t workers = 4;
+
+    struct Received
+    {
+        IPv4EndPoint source;
+        uint16_t sequence_nr;
+        uint8_t submessage_id;
+    };
+
+    PacketDispatchTest()
+        : schedulers_()
+    {
+        for (size_t i = 0; i < workers; ++i)
+        {
+            schedulers_.emplace_back(new PacketScheduler<InputPacket<IPv4EndPoint>>(256));
+            schedulers_.back()->init();
+            schedulers_.back()->set_priority_size(1, 1);
+        }
+    }
+
+    ~PacketDispatchTest() override
+    {
+        for (auto& scheduler : schedulers_)
+        {
+            scheduler->deinit();
+        }
+    }
+
+    static InputPacket<IPv4EndPoint> make_packet(
+            const IPv4EndPoint& source,
+            uint8_t session_id,
+            uint32_t client_key,
+            uint16_t sequence_nr,
+            std::initializer_list<uint8_t> submessages)
+    {
+        std::vector<uint8_t> buf{session_id, 0x01, uint8_t(sequence_nr), uint8_t(sequence_nr >> 8)};
+        if (has_session_client_key(session_id))
+        {
+            dds::xrce::ClientKey raw_client_key = conversion::raw_to_clientkey(client_key);
+            buf.insert(buf.end(), raw_client_key.begin(), raw_client_key.end());
+        }
+        for (uint8_t submessage_id : submessages)
+        {
+            buf.resize((buf.size() + 3) & ~size_t(3), 0);
+            buf.insert(buf.end(), {submessage_id, 0x01, 0x00, 0x00});
+        }
+
+        InputPacket<IPv4EndPoint> input_packet;
+        input_packet.source = source;
+        input_packet.message.reset(new InputMessage(buf.data(), buf.size()));
+        return input_packet;
+    }
+
+    /* Same dispatch as Server::push_input_packet. */
+    size_t push(
+            InputPacket<IPv4EndPoint>&& input_packet)
+    {
+        size_t worker_id = get_input_worker(input_packet, workers);
+        uint8_t priority = get_input_priority(input_packet);
+        schedulers_[worker_id]->push(std::move(input_packet), priority);
+        return worker_id;
+    }
+
+    std::vector<Received> pop_all(
+            size_t worker_id)
+    {
+        std::vector<Received> received;
+        InputPacket<IPv4EndPoint> input_packet;
+        while ((0 < schedulers_[worker_id]->size()) && schedulers_[worker_id]->pop(input_packet))
+        {
+            received.push_back(Received{
+                input_packet.source,
+                input_packet.message->get_header().sequence_nr(),
+                uint8_t(input_packet.message->get_submessage_id())});
+        }
+        return received;
+    }
+
+    static size_t get_client_key_worker(
+            uint32_t client_key)
+    {
+        return get_client_key_hash(client_key) % workers;
+    }
+
+    static size_t get_endpoint_worker(
+            const IPv4EndPoint& endpoint)
+    {
+        return get_endpoint_hash(endpoint) % workers;
+    }
+
+    std::vector<std::unique_ptr<PacketScheduler<InputPacket<IPv4EndPoint>>>> schedulers_;
+};
+
+constexpr size_t PacketDispatchTest::workers;
+
+TEST_F(PacketDispatchTest, client_key_sessions)
+{
+    /* The header carries the client key, so the source endpoint does not matter. */
+    const uint32_t client_key = 0xAABBCCDD;
+    for (uint16_t port = 2000; port < 2064; ++port)
+    {
+        ASSERT_EQ(get_client_key_worker(client_key),
+            push(make_packet(IPv4EndPoint(0x0100007F, port), 0x01, client_key, port, {dds::xrce::WRITE_DATA})));
+    }
+
+    std::set<size_t> used_workers;
+    for (uint32_t key = 1; key <= 64; ++key)
+    {
+        used_workers.insert(push(make_packet(IPv4EndPoint(0x0100007F, 2000), 0x01, key, 0, {dds::xrce::WRITE_DATA})));
+    }
+    ASSERT_EQ(workers, used_workers.size());
+}
+
+TEST_F(PacketDispatchTest, endpoint_fallback)
+{
+    std::set<size_t> used_workers;
+    for (uint16_t port = 2000; port < 2064; ++port)
+    {
+        IPv4EndPoint source(0x0100007F, port);
+        size_t worker_id = push(make_packet(source, 0x81, 0, 0, {dds::xrce::CREATE_CLIENT}));
+        ASSERT_EQ(get_endpoint_worker(source), worker_id);
+        used_workers.insert(worker_id);
+    }
+    ASSERT_EQ(workers, used_workers.size());
+
+    /* Invalid messages have no header to take the client key from. */
+    const uint8_t garbage[2] = {0x01, 0x01};
+    IPv4EndPoint source(0x0200007F, 2019);
+    InputPacket<IPv4EndPoint> input_packet;
+    input_packet.source = source;
+    input_packet.message.reset(new InputMessage(garbage, sizeof(garbage)));
+    ASSERT_FALSE(input_packet.message->is_valid_xrce_message());
+    ASSERT_EQ(get_endpoint_worker(source), push(std::move(input_packet)));
+}
+
+TEST_F(PacketDispatchTest, session_establishment_keeps_order)
+{
+    /* A client key whose worker differs from the one of the endpoint, as the session would otherwise move. */
+    const IPv4EndPoint source(0x0100007F, 2019);
+    const size_t worker_id = get_endpoint_worker(source);
+    uint32_t client_key = 1;
+    while (get_client_key_worker(client_key) == worker_id)
+    {
+        ++client_key;
+    }
+
+    ASSERT_EQ(worker_id, push(make_packet(source, 0x81, client_key, 0, {dds::xrce::CREATE_CLIENT})));
+    for (uint16_t sequence_nr = 1; sequence_nr < 32; ++sequence_nr)
+    {
+        ASSERT_EQ(worker_id, push(make_packet(source, 0x81, client_key, sequence_nr, {dds::xrce::WRITE_DATA})));
+
+        /* Other clients, including the same key on a session which carries it. */
+        push(make_packet(IPv4EndPoint(0x0100007F, uint16_t(3000 + sequence_nr)), 0x81, 0, 0, {dds::xrce::WRITE_DATA}));
+        push(make_packet(source, 0x01, client_key, 0, {dds::xrce::WRITE_DATA}));
+    }
+
+    for (size_t i = 0; i < workers; ++i)
+    {
+        uint16_t expected_sequence_nr = 0;
+        for (const auto& received : pop_all(i))
+        {
+            if ((received.source == source) && (0 < received.sequence_nr))
+            {
+                ASSERT_EQ(worker_id, i);
+                ASSERT_EQ(++expected_sequence_nr, received.sequence_nr);
+            }
+        }
+        if (worker_id == i)
+        {
+            ASSERT_EQ(31, expected_sequence_nr);
+        }
+    }
+}
+
+TEST_F(PacketDispatchTest, heartbeats)
+{
+    const uint32_t client_key = 0xAABBCCDD;
+    const size_t worker_id = get_client_key_worker(client_key);
+    const IPv4EndPoint source(0x0100007F, 2019);
+
+    ASSERT_EQ(worker_id, push(make_packet(source, 0x01, client_key, 1, {dds::xrce::WRITE_DATA})));
+    ASSERT_EQ(worker_id, push(make_packet(source, 0x01, client_key, 2, {dds::xrce::HEARTBEAT, dds::xrce::ACKNACK})));
+    ASSERT_EQ(worker_id, push(make_packet(source, 0x01, client_key, 3, {dds::xrce::HEARTBEAT})));
+
+    /* Only the message holding a single HEARTBEAT overtakes the others. */
+    std::vector<Received> received = pop_all(worker_id);
+    ASSERT_EQ(3u, received.size());
+    ASSERT_EQ(3, received[0].sequence_nr);
+    ASSERT_EQ(dds::xrce::HEARTBEAT, received[0].submessage_id);
+    ASSERT_EQ(1, received[1].sequence_nr);
+    ASSERT_EQ(2, received[2].sequence_nr);
+
+    /* Sessions without client key send their heartbeats to the worker of their endpoint. */
+    InputPacket<IPv4EndPoint> heartbeat = make_packet(source, 0x81, 0, 1, {dds::xrce::HEARTBEAT});
+    ASSERT_EQ(1, get_input_priority(heartbeat));
+    ASSERT_EQ(get_endpoint_worker(source), push(std::move(heartbeat)));
+}
+
+} // namespace testing
+} // namespace uxr
+} // namespace eprosima
+
+int main(int args, char** argv)
+{
+    ::testing::InitGoogleTest(&args, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,113 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/transport/endpoint/CustomEndPoint.hpp>
+
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <stdexcept>
+
+namespace eprosima {
+namespace uxr {
+namespace testing {
+
+class CustomEndPointTest : public ::testing::TestWithParam<bool>
+{
+protected:
+    CustomEndPointTest()
+    {
+        endpoint_.add_member<uint32_t>("address");
+        endpoint_.add_member<uint16_t>("port");
+        endpoint_.add_member<uint8_t>("id");
+        if (GetParam())
+        {
+            EXPECT_TRUE(endpoint_.freeze());
+        }
+    }
+
+    CustomEndPoint make(
+            uint32_t address,
+            uint16_t port,
+            uint8_t id)
+    {
+        CustomEndPoint endpoint = endpoint_;
+        endpoint.set_member_value<uint32_t>("address", address);
+        endpoint.set_member_value<uint16_t>("port", port);
+        endpoint.set_member_value<uint8_t>("id", id);
+        return endpoint;
+    }
+
+    CustomEndPoint endpoint_;
+};
+
+TEST_P(CustomEndPointTest, members)
+{
+    CustomEndPoint endpoint = make(0x0100007F, 8888, 3);
+    ASSERT_EQ(GetParam(), endpoint.is_frozen());
+    ASSERT_EQ(0x0100007Fu, endpoint.get_member<uint32_t>("address"));
+    ASSERT_EQ(8888u, endpoint.get_member<uint16_t>("port"));
+    ASSERT_EQ(3u, endpoint.get_member<uint8_t>("id"));
+    ASSERT_THROW(endpoint.get_member<uint32_t>("unknown"), std::exception);
+    ASSERT_NO_THROW(endpoint.check_non_empty_members());
+
+    endpoint.reset();
+    ASSERT_THROW(endpoint.check_non_empty_members(), std::exception);
+}
+
+TEST_P(CustomEndPointTest, comparison)
+{
+    CustomEndPoint endpoint = make(0x0100007F, 8888, 3);
+    CustomEndPoint same = make(0x0100007F, 8888, 3);
+    CustomEndPoint other = make(0x0100007F, 8889, 3);
+
+    ASSERT_TRUE(endpoint == same);
+    ASSERT_FALSE(endpoint < same || same < endpoint);
+    ASSERT_EQ(std::hash<CustomEndPoint>{}(endpoint), std::hash<CustomEndPoint>{}(same));
+
+    ASSERT_FALSE(endpoint == other);
+    ASSERT_TRUE(endpoint < other || other < endpoint);
+}
+
+#ifdef INSTANTIATE_TEST_SUITE_P
+#define GTEST_INSTANTIATE_TEST_MACRO(x, y, z) INSTANTIATE_TEST_SUITE_P(x, y, z)
+#else
+#define GTEST_INSTANTIATE_TEST_MACRO(x, y, z) INSTANTIATE_TEST_CASE_P(x, y, z)
+#endif // ifdef INSTANTIATE_TEST_SUITE_P
+
+GTEST_INSTANTIATE_TEST_MACRO(Frozen, CustomEndPointTest, ::testing::Bool());
+
+TEST(CustomEndPointFreezeTest, frozen_layout)
+{
+    CustomEndPoint endpoint;
+    endpoint.add_member<uint16_t>("port");
+    ASSERT_TRUE(endpoint.freeze());
+    ASSERT_FALSE(endpoint.add_member<uint32_t>("address"));
+    ASSERT_THROW(endpoint.set_member_value<uint32_t>("port", 1), std::exception);
+
+    CustomEndPoint with_string;
+    with_string.add_member<std::string>("path");
+    ASSERT_FALSE(with_string.freeze());
+    ASSERT_FALSE(with_string.is_frozen());
+}
+
+} // namespace testing
+} // namespace uxr
+} // namespace eprosima
+
+int main(int args, char** argv)
+{
+    ::testing::InitGoogleTest(&args, argv);
+    return RUN_ALL_TESTS();
+}
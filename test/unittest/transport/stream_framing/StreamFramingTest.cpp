@@ -0,0 +1,203 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/transport/stream_framing/StreamFramingProtocol.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace eprosima {
+namespace uxr {
+namespace testing {
+
+constexpr uint8_t local_addr = 0x01;
+constexpr uint8_t remote_addr = 0x02;
+
+/**
+ * @brief Bit by bit CRC-16 (polynomial 0x8005, reflected), independent from the tables of FramingIO.
+ */
+uint16_t reference_crc(
+        const std::vector<uint8_t>& data)
+{
+    uint16_t crc = 0;
+    for (uint8_t octet : data)
+    {
+        crc ^= octet;
+        for (int i = 0; i < 8; ++i)
+        {
+            crc = (crc & 1) ? uint16_t((crc >> 1) ^ 0xA001) : uint16_t(crc >> 1);
+        }
+    }
+    return crc;
+}
+
+/**
+ * @brief Frame built octet by octet as the protocol defines it.
+ */
+std::vector<uint8_t> reference_frame(
+        uint8_t src_addr,
+        uint8_t dst_addr,
+        const std::vector<uint8_t>& payload)
+{
+    std::vector<uint8_t> octets{src_addr, dst_addr, uint8_t(payload.size() & 0xFF), uint8_t(payload.size() >> 8)};
+    octets.insert(octets.end(), payload.begin(), payload.end());
+    uint16_t crc = reference_crc(payload);
+    octets.push_back(uint8_t(crc & 0xFF));
+    octets.push_back(uint8_t(crc >> 8));
+
+    std::vector<uint8_t> frame{0x7E};
+    for (uint8_t octet : octets)
+    {
+        if ((0x7E == octet) || (0x7D == octet))
+        {
+            frame.push_back(0x7D);
+            frame.push_back(octet ^ 0x20);
+        }
+        else
+        {
+            frame.push_back(octet);
+        }
+    }
+    return frame;
+}
+
+std::vector<uint8_t> make_payload(
+        size_t len)
+{
+    std::vector<uint8_t> payload(len);
+    for (size_t i = 0; i < len; ++i)
+    {
+        /* Plenty of flags, in runs and isolated, among regular octets. */
+        payload[i] = (0 == (i % 7)) ? 0x7E : ((0 == (i % 11)) ? 0x7D : uint8_t(i * 31));
+    }
+    return payload;
+}
+
+class StreamFramingTest : public ::testing::Test
+{
+protected:
+    StreamFramingTest()
+        : wire_{}
+        , read_pos_{0}
+        , max_write_{SIZE_MAX}
+        , max_read_{SIZE_MAX}
+        , framing_io_(
+            local_addr,
+            [this](uint8_t* buf, size_t len, TransportRc& transport_rc) -> ssize_t
+            {
+                size_t written = (std::min)(len, max_write_);
+                wire_.insert(wire_.end(), buf, buf + written);
+                transport_rc = TransportRc::ok;
+                return ssize_t(written);
+            },
+            [this](uint8_t* buf, size_t len, int /* timeout */, TransportRc& transport_rc) -> ssize_t
+            {
+                size_t read = (std::min)((std::min)(len, max_read_), wire_.size() - read_pos_);
+                std::copy(wire_.begin() + std::ptrdiff_t(read_pos_), wire_.begin() + std::ptrdiff_t(read_pos_ + read), buf);
+                read_pos_ += read;
+                transport_rc = (0 < read) ? TransportRc::ok : TransportRc::timeout_error;
+                return ssize_t(read);
+            })
+    {}
+
+    std::vector<uint8_t> read(
+            uint8_t& addr)
+    {
+        std::vector<uint8_t> buf(4096);
+        size_t len = 0;
+        for (int attempts = 0; (0 == len) && (attempts < 1000); ++attempts)
+        {
+            int timeout = 10;
+            TransportRc transport_rc;
+            len = framing_io_.read_framed_msg(buf.data(), buf.size(), addr, timeout, transport_rc);
+        }
+        buf.resize(len);
+        return buf;
+    }
+
+    std::vector<uint8_t> wire_;
+    size_t read_pos_;
+    size_t max_write_;
+    size_t max_read_;
+    FramingIO framing_io_;
+};
+
+TEST_F(StreamFramingTest, write_matches_protocol)
+{
+    for (size_t len : {size_t(0), size_t(1), size_t(8), size_t(37), size_t(300), size_t(3000)})
+    {
+        wire_.clear();
+        std::vector<uint8_t> payload = make_payload(len);
+        TransportRc transport_rc;
+        EXPECT_EQ(len, framing_io_.write_framed_msg(payload.data(), payload.size(), remote_addr, transport_rc));
+        EXPECT_EQ(reference_frame(local_addr, remote_addr, payload), wire_);
+    }
+}
+
+TEST_F(StreamFramingTest, partial_writes)
+{
+    max_write_ = 3;
+    std::vector<uint8_t> payload = make_payload(500);
+    TransportRc transport_rc;
+    EXPECT_EQ(payload.size(), framing_io_.write_framed_msg(payload.data(), payload.size(), remote_addr, transport_rc));
+    EXPECT_EQ(reference_frame(local_addr, remote_addr, payload), wire_);
+}
+
+TEST_F(StreamFramingTest, read_messages)
+{
+    std::vector<std::vector<uint8_t>> payloads{make_payload(1), make_payload(64), make_payload(2500), make_payload(9)};
+    wire_ = {0x00, 0x7D, 0x55};
+    for (const auto& payload : payloads)
+    {
+        std::vector<uint8_t> frame = reference_frame(remote_addr, local_addr, payload);
+        wire_.insert(wire_.end(), frame.begin(), frame.end());
+    }
+
+    for (size_t max_read : {size_t(1), size_t(5), size_t(SIZE_MAX)})
+    {
+        max_read_ = max_read;
+        read_pos_ = 0;
+        for (const auto& payload : payloads)
+        {
+            uint8_t addr = 0;
+            EXPECT_EQ(payload, read(addr));
+            EXPECT_EQ(remote_addr, addr);
+        }
+    }
+}
+
+TEST_F(StreamFramingTest, read_discards_corrupted_messages)
+{
+    std::vector<uint8_t> payload = make_payload(100);
+    std::vector<uint8_t> corrupted = reference_frame(remote_addr, local_addr, payload);
+    corrupted[50] ^= 0x01;
+    std::vector<uint8_t> other_addr = reference_frame(remote_addr, uint8_t(local_addr + 1), payload);
+    std::vector<uint8_t> valid = reference_frame(remote_addr, local_addr, make_payload(20));
+
+    wire_ = corrupted;
+    wire_.insert(wire_.end(), other_addr.begin(), other_addr.end());
+    wire_.insert(wire_.end(), valid.begin(), valid.end());
+
+    /* Only the valid message is returned. */
+    uint8_t addr = 0;
+    EXPECT_EQ(make_payload(20), read(addr));
+    EXPECT_TRUE(read(addr).empty());
+}
+
+} // namespace testing
+} // namespace uxr
+} // namespace eprosima
@@ -0,0 +1,225 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/transport/tcp/TCPServerBase.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <deque>
+#include <vector>
+
+namespace eprosima {
+namespace uxr {
+namespace testing {
+
+/**
+ * @brief Stream whose received bytes are scripted as a sequence of chunks, each one returned by
+ *        a different recv_data call.
+ */
+class ScriptedStream : public TCPServerBase<TCPv4Connection>
+{
+public:
+    ScriptedStream()
+        : connection_{}
+        , chunks_{}
+        , recv_calls_{0}
+    {
+        connection_.input_buffer.head = 0;
+        connection_.input_buffer.tail = 0;
+        connection_.active = true;
+    }
+
+    void push_chunk(
+            const std::vector<uint8_t>& chunk)
+    {
+        chunks_.push_back(chunk);
+    }
+
+    /* Reads once and returns every complete message carved out of the connection. */
+    std::vector<std::vector<uint8_t>> read(
+            TransportRc& transport_rc)
+    {
+        std::vector<std::vector<uint8_t>> messages;
+        read_data(connection_, transport_rc);
+        const uint8_t* message = nullptr;
+        uint16_t message_len = 0;
+        while (next_message(connection_, message, message_len))
+        {
+            messages.emplace_back(message, message + message_len);
+        }
+        return messages;
+    }
+
+    size_t recv_calls() const { return recv_calls_; }
+
+    size_t buffer_size() const { return connection_.input_buffer.buffer.size(); }
+
+private:
+    size_t recv_data(
+            TCPv4Connection& /* connection */,
+            uint8_t* buffer,
+            size_t len,
+            TransportRc& transport_rc) override
+    {
+        ++recv_calls_;
+        size_t rv = 0;
+        if (chunks_.empty())
+        {
+            transport_rc = TransportRc::timeout_error;
+        }
+        else
+        {
+            std::vector<uint8_t>& chunk = chunks_.front();
+            rv = (std::min)(len, chunk.size());
+            std::copy(chunk.begin(), chunk.begin() + std::ptrdiff_t(rv), buffer);
+            chunk.erase(chunk.begin(), chunk.begin() + std::ptrdiff_t(rv));
+            if (chunk.empty())
+            {
+                chunks_.pop_front();
+            }
+            transport_rc = TransportRc::ok;
+        }
+        return rv;
+    }
+
+    size_t send_data(
+            TCPv4Connection& /* connection */,
+            uint8_t* /* buffer */,
+            size_t /* len */,
+            TransportRc& transport_rc) override
+    {
+        transport_rc = TransportRc::connection_error;
+        return 0;
+    }
+
+    TCPv4Connection connection_;
+    std::deque<std::vector<uint8_t>> chunks_;
+    size_t recv_calls_;
+};
+
+std::vector<uint8_t> make_message(
+        uint16_t len,
+        uint8_t value)
+{
+    return std::vector<uint8_t>(len, value);
+}
+
+std::vector<uint8_t> make_frame(
+        const std::vector<uint8_t>& message)
+{
+    std::vector<uint8_t> frame;
+    frame.push_back(uint8_t(0x00FF & message.size()));
+    frame.push_back(uint8_t((0xFF00 & message.size()) >> 8));
+    frame.insert(frame.end(), message.begin(), message.end());
+    return frame;
+}
+
+TEST(TCPServerBaseTest, several_messages_per_read)
+{
+    ScriptedStream stream;
+    std::vector<uint8_t> chunk;
+    for (uint8_t i = 1; i <= 3; ++i)
+    {
+        std::vector<uint8_t> frame = make_frame(make_message(uint16_t(10 * i), i));
+        chunk.insert(chunk.end(), frame.begin(), frame.end());
+    }
+    stream.push_chunk(chunk);
+
+    TransportRc transport_rc;
+    std::vector<std::vector<uint8_t>> messages = stream.read(transport_rc);
+    EXPECT_EQ(TransportRc::ok, transport_rc);
+    EXPECT_EQ(1u, stream.recv_calls());
+    ASSERT_EQ(3u, messages.size());
+    for (uint8_t i = 1; i <= 3; ++i)
+    {
+        EXPECT_EQ(make_message(uint16_t(10 * i), i), messages[i - 1]);
+    }
+}
+
+TEST(TCPServerBaseTest, split_messages)
+{
+    ScriptedStream stream;
+    std::vector<uint8_t> message_1 = make_message(40, 0xAA);
+    std::vector<uint8_t> message_2 = make_message(3, 0xBB);
+    std::vector<uint8_t> bytes = make_frame(message_1);
+    std::vector<uint8_t> frame_2 = make_frame(message_2);
+    bytes.insert(bytes.end(), frame_2.begin(), frame_2.end());
+    for (uint8_t byte : bytes)
+    {
+        stream.push_chunk({byte});
+    }
+
+    TransportRc transport_rc;
+    std::vector<std::vector<uint8_t>> messages;
+    for (size_t i = 0; i < bytes.size(); ++i)
+    {
+        std::vector<std::vector<uint8_t>> read = stream.read(transport_rc);
+        ASSERT_EQ(TransportRc::ok, transport_rc);
+        messages.insert(messages.end(), read.begin(), read.end());
+        if ((i + 1) == message_1.size() + 2)
+        {
+            ASSERT_EQ(1u, messages.size());
+        }
+    }
+    ASSERT_EQ(2u, messages.size());
+    EXPECT_EQ(message_1, messages[0]);
+    EXPECT_EQ(message_2, messages[1]);
+
+    EXPECT_TRUE(stream.read(transport_rc).empty());
+    EXPECT_EQ(TransportRc::timeout_error, transport_rc);
+}
+
+TEST(TCPServerBaseTest, large_message)
+{
+    ScriptedStream stream;
+    std::vector<uint8_t> message = make_message(uint16_t(3 * TCP_RECV_BUFFER_SIZE), 0xCC);
+    std::vector<uint8_t> frame = make_frame(message);
+    size_t half = frame.size() / 2;
+    stream.push_chunk(std::vector<uint8_t>(frame.begin(), frame.begin() + std::ptrdiff_t(half)));
+    stream.push_chunk(std::vector<uint8_t>(frame.begin() + std::ptrdiff_t(half), frame.end()));
+
+    TransportRc transport_rc;
+    std::vector<std::vector<uint8_t>> messages;
+    while (messages.empty())
+    {
+        messages = stream.read(transport_rc);
+        ASSERT_EQ(TransportRc::ok, transport_rc);
+    }
+    ASSERT_EQ(1u, messages.size());
+    EXPECT_EQ(message, messages[0]);
+    EXPECT_LE(frame.size(), stream.buffer_size());
+}
+
+TEST(TCPServerBaseTest, empty_messages)
+{
+    ScriptedStream stream;
+    std::vector<uint8_t> message = make_message(5, 0xDD);
+    std::vector<uint8_t> chunk = make_frame({});
+    std::vector<uint8_t> frame = make_frame(message);
+    chunk.insert(chunk.end(), frame.begin(), frame.end());
+    chunk.push_back(0x00);
+    chunk.push_back(0x00);
+    stream.push_chunk(chunk);
+
+    TransportRc transport_rc;
+    std::vector<std::vector<uint8_t>> messages = stream.read(transport_rc);
+    EXPECT_EQ(TransportRc::ok, transport_rc);
+    ASSERT_EQ(1u, messages.size());
+    EXPECT_EQ(message, messages[0]);
+}
+
+} // namespace testing
+} // namespace uxr
+} // namespace eprosima
@@ -0,0 +1,76 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/types/TopicPubSubType.hpp>
+
+#include <gtest/gtest.h>
+
+namespace eprosima {
+namespace uxr {
+namespace testing {
+
+const std::vector<unsigned char> serialized_data{0x00, 0x11, 0x22, 0x33, 0x44};
+
+/*
+ * A sample pointing at caller data is serialized without being copied into the sample.
+ */
+TEST(TopicPubSubTypeTest, serialize_view)
+{
+    TopicPubSubType type{false};
+    TopicPubSubType::Sample sample{serialized_data.data(), serialized_data.size()};
+    rtps::SerializedPayload_t payload(type.m_typeSize);
+
+    ASSERT_EQ(serialized_data.size() + 4, type.getSerializedSizeProvider(&sample)());
+    ASSERT_TRUE(type.serialize(&sample, &payload));
+    ASSERT_EQ(serialized_data.size() + 4, payload.length);
+    ASSERT_TRUE(std::equal(serialized_data.begin(), serialized_data.end(), payload.data + 4));
+}
+
+/*
+ * Samples allocated by the type shall be accepted by every operation of the type, as Fast DDS may
+ * serialize them again, e.g. when they are loaned.
+ */
+TEST(TopicPubSubTypeTest, created_sample_round_trip)
+{
+    TopicPubSubType type{false};
+    TopicPubSubType::Sample sample{serialized_data.data(), serialized_data.size()};
+    rtps::SerializedPayload_t payload(type.m_typeSize);
+    ASSERT_TRUE(type.serialize(&sample, &payload));
+
+    void* created = type.createData();
+    ASSERT_EQ(4u, type.getSerializedSizeProvider(created)());
+    ASSERT_TRUE(type.deserialize(&payload, created));
+    ASSERT_EQ(serialized_data.size() + 4, type.getSerializedSizeProvider(created)());
+
+    rtps::SerializedPayload_t reserialized(type.m_typeSize);
+    ASSERT_TRUE(type.serialize(created, &reserialized));
+    ASSERT_EQ(payload.length, reserialized.length);
+    ASSERT_TRUE(std::equal(payload.data, payload.data + payload.length, reserialized.data));
+
+    std::vector<unsigned char> data;
+    static_cast<TopicPubSubType::Sample*>(created)->take(data);
+    ASSERT_EQ(serialized_data, data);
+    ASSERT_EQ(0u, static_cast<TopicPubSubType::Sample*>(created)->size());
+    type.deleteData(created);
+}
+
+} // namespace testing
+} // namespace uxr
+} // namespace eprosima
+
+int main(int args, char** argv)
+{
+    ::testing::InitGoogleTest(&args, argv);
+    return RUN_ALL_TESTS();
+}
@@ -264,6 +264,45 @@ TEST_F(SerializerDeserializerTests, DeleteSubmessage)
     ASSERT_EQ(delete_payload.request_id(), deserialized_data.request_id());
 }
 
+TEST_F(SerializerDeserializerTests, MultipleSubmessages)
+{
+    dds::xrce::MessageHeader message_header = generate_message_header();
+    dds::xrce::HEARTBEAT_Payload heartbeat_payload;
+    heartbeat_payload.first_unacked_seq_nr(1);
+    heartbeat_payload.last_unacked_seq_nr(2);
+    dds::xrce::DELETE_Payload delete_payload = generate_delete_resource_payload(object_id);
+    dds::xrce::SubmessageHeader submessage_header;
+    size_t message_size = message_header.getCdrSerializedSize() +
+                          (3 * (submessage_header.getCdrSerializedSize() + 4)) +
+                          heartbeat_payload.getCdrSerializedSize() +
+                          (2 * delete_payload.getCdrSerializedSize());
+
+    OutputMessage output(message_header, message_size);
+    output.append_submessage(dds::xrce::HEARTBEAT, heartbeat_payload);
+    output.append_submessage(dds::xrce::DELETE_ID, delete_payload);
+    output.append_submessage(dds::xrce::DELETE_ID, delete_payload, 0x03);
+
+    InputMessage input(output.get_buf(), output.get_len());
+    ASSERT_TRUE(input.is_valid_xrce_message());
+    ASSERT_EQ(3u, input.count_submessages());
+    ASSERT_EQ(dds::xrce::HEARTBEAT, input.get_submessage_id());
+
+    /* Submessages are reached through the index, even if a payload is left unread. */
+    ASSERT_TRUE(input.prepare_next_submessage());
+    ASSERT_EQ(dds::xrce::HEARTBEAT, input.get_subheader().submessage_id());
+    ASSERT_TRUE(input.prepare_next_submessage());
+    ASSERT_EQ(dds::xrce::DELETE_ID, input.get_subheader().submessage_id());
+    ASSERT_TRUE(input.prepare_next_submessage());
+    ASSERT_EQ(dds::xrce::DELETE_ID, input.get_subheader().submessage_id());
+    ASSERT_EQ(0x03, input.get_subheader().flags());
+    ASSERT_EQ(delete_payload.getCdrSerializedSize(), input.get_subheader().submessage_length());
+
+    dds::xrce::DELETE_Payload deserialized_data;
+    ASSERT_TRUE(input.get_payload(deserialized_data));
+    ASSERT_EQ(delete_payload.object_id(), deserialized_data.object_id());
+    ASSERT_FALSE(input.prepare_next_submessage());
+}
+
 } // namespace testing
 } // namespace uxr
 } // namespace eprosima
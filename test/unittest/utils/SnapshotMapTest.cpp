@@ -0,0 +1,187 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/utils/SnapshotMap.hpp>
+#include <uxr/agent/transport/endpoint/IPv4EndPoint.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace eprosima {
+namespace uxr {
+namespace testing {
+
+using eprosima::uxr::utils::SnapshotMap;
+
+TEST(SnapshotMapTest, insert_find_erase)
+{
+    SnapshotMap<uint32_t, int> map;
+    int value = 0;
+
+    ASSERT_FALSE(map.find(1, value));
+    ASSERT_TRUE(map.insert_or_assign(1, 10));
+    ASSERT_TRUE(map.find(1, value));
+    ASSERT_EQ(10, value);
+
+    ASSERT_FALSE(map.insert_or_assign(1, 11));
+    ASSERT_TRUE(map.find(1, value));
+    ASSERT_EQ(11, value);
+
+    ASSERT_TRUE(map.erase(1));
+    ASSERT_FALSE(map.erase(1));
+    ASSERT_FALSE(map.find(1, value));
+}
+
+TEST(SnapshotMapTest, update)
+{
+    SnapshotMap<uint32_t, int> map;
+    int value = 0;
+
+    ASSERT_TRUE(map.update(1, [](const int* current, int& new_value)
+    {
+        EXPECT_EQ(nullptr, current);
+        new_value = 10;
+        return true;
+    }));
+    ASSERT_TRUE(map.find(1, value));
+    ASSERT_EQ(10, value);
+
+    ASSERT_FALSE(map.update(1, [](const int* current, int& new_value)
+    {
+        EXPECT_EQ(10, *current);
+        new_value = 11;
+        return false;
+    }));
+    ASSERT_TRUE(map.find(1, value));
+    ASSERT_EQ(10, value);
+
+    ASSERT_FALSE(map.update(2, [](const int*, int&){ return false; }));
+    ASSERT_FALSE(map.find(2, value));
+
+    ASSERT_TRUE(map.erase(1, value));
+    ASSERT_EQ(10, value);
+    ASSERT_FALSE(map.erase(1, value));
+}
+
+TEST(SnapshotMapTest, lock_free)
+{
+    SnapshotMap<uint32_t, int> map;
+    ASSERT_TRUE(map.is_lock_free());
+}
+
+TEST(SnapshotMapTest, clear)
+{
+    SnapshotMap<uint32_t, int> map;
+    for (uint32_t i = 0; i < 1000; ++i)
+    {
+        ASSERT_TRUE(map.insert_or_assign(i, int(i)));
+    }
+
+    uint64_t sum = 0;
+    size_t count = 0;
+    map.for_each([&](uint32_t key, int value)
+    {
+        ASSERT_EQ(int(key), value);
+        sum += uint64_t(value);
+        ++count;
+    });
+    ASSERT_EQ(1000u, count);
+    ASSERT_EQ(999u * 1000u / 2u, sum);
+
+    std::vector<int> values;
+    map.clear(values);
+    ASSERT_EQ(1000u, values.size());
+    int value = 0;
+    for (uint32_t i = 0; i < 1000; ++i)
+    {
+        ASSERT_FALSE(map.find(i, value));
+    }
+
+    map.clear(values);
+    ASSERT_EQ(1000u, values.size());
+
+    ASSERT_TRUE(map.insert_or_assign(1, 1));
+    map.clear();
+    ASSERT_FALSE(map.find(1, value));
+}
+
+TEST(SnapshotMapTest, endpoint_keys)
+{
+    SnapshotMap<IPv4EndPoint, uint32_t> map;
+    uint32_t client_key = 0;
+
+    ASSERT_TRUE(map.insert_or_assign(IPv4EndPoint(0x0100007F, 2019), 0xAABBCCDD));
+    ASSERT_TRUE(map.find(IPv4EndPoint(0x0100007F, 2019), client_key));
+    ASSERT_EQ(0xAABBCCDD, client_key);
+    ASSERT_FALSE(map.find(IPv4EndPoint(0x0100007F, 2020), client_key));
+    ASSERT_FALSE(map.find(IPv4EndPoint(0x0200007F, 2019), client_key));
+}
+
+TEST(SnapshotMapTest, concurrent_lookups)
+{
+    SnapshotMap<uint32_t, uint32_t> map;
+    const uint32_t stable_keys = 64;
+    for (uint32_t i = 0; i < stable_keys; ++i)
+    {
+        map.insert_or_assign(i, i);
+    }
+
+    /* Lookups of untouched keys always succeed while other keys come and go. */
+    std::atomic<bool> running{true};
+    std::atomic<bool> failed{false};
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; ++i)
+    {
+        readers.emplace_back([&]()
+        {
+            uint32_t value = 0;
+            while (running)
+            {
+                for (uint32_t key = 0; key < stable_keys; ++key)
+                {
+                    if (!map.find(key, value) || key != value)
+                    {
+                        failed = true;
+                    }
+                }
+            }
+        });
+    }
+
+    for (uint32_t i = 0; i < 10000; ++i)
+    {
+        map.insert_or_assign(stable_keys + (i % 256), i);
+        map.erase(stable_keys + ((i + 128) % 256));
+    }
+    running = false;
+    for (auto& reader : readers)
+    {
+        reader.join();
+    }
+
+    ASSERT_FALSE(failed);
+}
+
+} // namespace testing
+} // namespace uxr
+} // namespace eprosima
+
+int main(int args, char** argv)
+{
+    ::testing::InitGoogleTest(&args, argv);
+    return RUN_ALL_TESTS();
+}
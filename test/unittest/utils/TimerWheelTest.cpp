@@ -0,0 +1,122 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/utils/TimerWheel.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+namespace eprosima {
+namespace uxr {
+namespace testing {
+
+using eprosima::uxr::utils::TimerWheel;
+
+class TimerWheelTest : public ::testing::Test
+{
+protected:
+    TimerWheelTest()
+        : wheel_(std::chrono::milliseconds(1), 8)
+        , origin_(wheel_.next_expiration() - std::chrono::milliseconds(1))
+    {}
+
+    ~TimerWheelTest() override = default;
+
+    std::vector<int> advance(std::chrono::microseconds elapsed)
+    {
+        std::vector<int> expired;
+        wheel_.advance(origin_ + elapsed, expired);
+        std::sort(expired.begin(), expired.end());
+        return expired;
+    }
+
+    TimerWheel<int> wheel_;
+    const std::chrono::steady_clock::time_point origin_;
+};
+
+TEST_F(TimerWheelTest, expiration)
+{
+    wheel_.schedule(origin_ + std::chrono::microseconds(2500), 2);
+    wheel_.schedule(origin_ + std::chrono::microseconds(500), 0);
+    wheel_.schedule(origin_ + std::chrono::microseconds(2100), 1);
+    ASSERT_EQ(3u, wheel_.size());
+
+    /* Timers never expire before the end of their tick. */
+    ASSERT_TRUE(advance(std::chrono::microseconds(900)).empty());
+    ASSERT_EQ(std::vector<int>({0}), advance(std::chrono::milliseconds(1)));
+    ASSERT_TRUE(advance(std::chrono::microseconds(2900)).empty());
+    ASSERT_EQ(std::vector<int>({1, 2}), advance(std::chrono::milliseconds(3)));
+    ASSERT_TRUE(wheel_.empty());
+    ASSERT_EQ(origin_ + std::chrono::milliseconds(4), wheel_.next_expiration());
+}
+
+TEST_F(TimerWheelTest, past_timer)
+{
+    ASSERT_TRUE(advance(std::chrono::milliseconds(5)).empty());
+
+    /* A timer already expired fires on the next advance. */
+    wheel_.schedule(origin_, 0);
+    ASSERT_EQ(std::vector<int>({0}), advance(std::chrono::milliseconds(6)));
+}
+
+TEST_F(TimerWheelTest, several_turns)
+{
+    /* Timers further than a turn share a slot with closer ones without expiring early. */
+    wheel_.schedule(origin_ + std::chrono::microseconds(1500), 0);
+    wheel_.schedule(origin_ + std::chrono::microseconds(9500), 1);
+    wheel_.schedule(origin_ + std::chrono::microseconds(17500), 2);
+
+    ASSERT_EQ(std::vector<int>({0}), advance(std::chrono::milliseconds(2)));
+    ASSERT_TRUE(advance(std::chrono::milliseconds(9)).empty());
+    ASSERT_EQ(std::vector<int>({1}), advance(std::chrono::milliseconds(10)));
+
+    /* A long jump visits each slot once. */
+    ASSERT_EQ(std::vector<int>({2}), advance(std::chrono::milliseconds(100)));
+    ASSERT_TRUE(wheel_.empty());
+}
+
+TEST_F(TimerWheelTest, earliest_expiration)
+{
+    ASSERT_EQ(wheel_.next_expiration(), wheel_.earliest_expiration());
+
+    /* Waiters sleep until the first occupied tick, not until the next tick. */
+    wheel_.schedule(origin_ + std::chrono::microseconds(5500), 1);
+    ASSERT_EQ(origin_ + std::chrono::milliseconds(6), wheel_.earliest_expiration());
+    wheel_.schedule(origin_ + std::chrono::microseconds(3500), 0);
+    ASSERT_EQ(origin_ + std::chrono::milliseconds(4), wheel_.earliest_expiration());
+    wheel_.schedule(origin_ + std::chrono::microseconds(20500), 2);
+    ASSERT_EQ(origin_ + std::chrono::milliseconds(4), wheel_.earliest_expiration());
+
+    ASSERT_TRUE(advance(std::chrono::milliseconds(3)).empty());
+    ASSERT_EQ(origin_ + std::chrono::milliseconds(4), wheel_.earliest_expiration());
+    ASSERT_EQ(std::vector<int>({0}), advance(std::chrono::milliseconds(4)));
+    ASSERT_EQ(origin_ + std::chrono::milliseconds(6), wheel_.earliest_expiration());
+
+    /* The only timer left is more than a turn away. */
+    ASSERT_EQ(std::vector<int>({1}), advance(std::chrono::milliseconds(6)));
+    ASSERT_EQ(origin_ + std::chrono::milliseconds(21), wheel_.earliest_expiration());
+    ASSERT_EQ(std::vector<int>({2}), advance(std::chrono::milliseconds(21)));
+    ASSERT_EQ(wheel_.next_expiration(), wheel_.earliest_expiration());
+}
+
+} // namespace testing
+} // namespace uxr
+} // namespace eprosima
+
+int main(int args, char** argv)
+{
+    ::testing::InitGoogleTest(&args, argv);
+    return RUN_ALL_TESTS();
+}
@@ -147,6 +147,29 @@ TEST_F(TokenBucketTest, rate_with_empty_bucket)
     ASSERT_EQ(requested_tokens / bunch_size, reading_counter);
 }
 
+TEST_F(TokenBucketTest, try_consume)
+{
+    const size_t rate = 1000;
+    TokenBucket bucket{rate};
+    std::chrono::steady_clock::time_point retry_time;
+
+    /* More than capacity is never available. */
+    ASSERT_FALSE(bucket.try_consume_tokens(rate + 1, retry_time));
+    ASSERT_EQ(std::chrono::steady_clock::time_point::max(), retry_time);
+
+    /* Empty bucket. */
+    ASSERT_TRUE(bucket.try_consume_tokens(rate, retry_time));
+
+    /* Half of the capacity is available after half a second. */
+    const auto start = std::chrono::steady_clock::now();
+    ASSERT_FALSE(bucket.try_consume_tokens(rate / 2, retry_time));
+    ASSERT_GE(retry_time, start + std::chrono::milliseconds(400));
+    ASSERT_LE(retry_time, std::chrono::steady_clock::now() + std::chrono::milliseconds(500));
+
+    std::this_thread::sleep_until(retry_time);
+    ASSERT_TRUE(bucket.try_consume_tokens(rate / 2, retry_time));
+}
+
 } // namespace testing
 } // namespace uxr
 } // namespace eprosima